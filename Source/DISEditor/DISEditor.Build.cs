@@ -29,7 +29,9 @@ public class DISEditor : ModuleRules
                 "CoreUObject",
                 "Engine",
                 "Slate",
-                "SlateCore"
+                "SlateCore",
+                "ContentBrowser",
+                "Landscape"
 				// ... add private dependencies that you statically link with here ...	
 			}
             );
@@ -6,6 +6,10 @@
 #include "Misc/MessageDialog.h"
 #include "AssetTypeActions_Base.h"
 #include "DISEnumerationMappingsFactory.h"
+#include "DISTerrainHeightFieldFactory.h"
+#include "DISTerrainHeightFieldBaker.h"
+#include "ContentBrowserMenuContexts.h"
+#include "Editor.h"
 
 #include "ToolMenus.h"
 #include "LevelEditor.h"
@@ -24,6 +28,9 @@ void FDISEditorModule::StartupModule()
 	IAssetTools& AssetTools = FModuleManager::LoadModuleChecked<FAssetToolsModule>("AssetTools").Get();
 	TSharedRef<IAssetTypeActions> ACT_UDISEnumerationMappingsDatabase = MakeShareable(new UDISEnumerationMappingsDatabase);
 	AssetTools.RegisterAssetTypeActions(ACT_UDISEnumerationMappingsDatabase);
+	AssetTools.RegisterAssetTypeActions(MakeShareable(new FDISTerrainHeightFieldAssetTypeActions));
+
+	UToolMenus::RegisterStartupCallback(FSimpleMulticastDelegate::FDelegate::CreateRaw(this, &FDISEditorModule::RegisterMenus));
 }
 
 void FDISEditorModule::ShutdownModule()
@@ -40,6 +47,54 @@ void FDISEditorModule::ShutdownModule()
 	FDISEditorCommands::Unregister();
 }
 
+void FDISEditorModule::RegisterMenus()
+{
+	//Owner will be used for cleanup in call to UToolMenus::UnregisterOwner
+	FToolMenuOwnerScoped OwnerScoped(this);
+
+	UToolMenu* assetContextMenu = UToolMenus::Get()->ExtendMenu("ContentBrowser.AssetContextMenu.DISTerrainHeightField");
+	FToolMenuSection& section = assetContextMenu->FindOrAddSection("GetAssetActions");
+	section.AddDynamicEntry("BakeDISTerrainHeightField", FNewToolMenuSectionDelegate::CreateLambda([](FToolMenuSection& InSection)
+	{
+		const UContentBrowserAssetContextMenuContext* context = InSection.FindContext<UContentBrowserAssetContextMenuContext>();
+		if (context == nullptr)
+		{
+			return;
+		}
+
+		TArray<TWeakObjectPtr<UDISTerrainHeightField>> heightFields;
+		for (const TWeakObjectPtr<UObject>& selectedObject : context->SelectedObjects)
+		{
+			if (UDISTerrainHeightField* heightField = Cast<UDISTerrainHeightField>(selectedObject.Get()))
+			{
+				heightFields.Add(heightField);
+			}
+		}
+
+		InSection.AddMenuEntry(
+			"BakeDISTerrainHeightField",
+			LOCTEXT("BakeTerrainHeightField", "Bake From Current Level"),
+			LOCTEXT("BakeTerrainHeightFieldTooltip", "Traces the ground collision of the current level inside each height field's bake bounds and stores it in the height field."),
+			FSlateIcon(),
+			FUIAction(FExecuteAction::CreateLambda([heightFields]()
+			{
+				UWorld* editorWorld = GEditor ? GEditor->GetEditorWorldContext().World() : nullptr;
+				if (editorWorld == nullptr)
+				{
+					return;
+				}
+
+				for (const TWeakObjectPtr<UDISTerrainHeightField>& heightField : heightFields)
+				{
+					if (heightField.IsValid() && !FDISTerrainHeightFieldBaker::Bake(*heightField.Get(), *editorWorld))
+					{
+						break;
+					}
+				}
+			})));
+	}));
+}
+
 #undef LOCTEXT_NAMESPACE
 
 IMPLEMENT_MODULE(FDISEditorModule, DISEditor)
\ No newline at end of file
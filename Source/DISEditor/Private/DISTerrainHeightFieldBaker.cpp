@@ -0,0 +1,127 @@
+// Copyright 2022 Gaming Research Integration for Learning Lab. All Rights Reserved.
+
+#include "DISTerrainHeightFieldBaker.h"
+#include "DISTerrainHeightField.h"
+#include "CollisionQueryParams.h"
+#include "Engine/World.h"
+#include "LandscapeProxy.h"
+#include "Misc/ScopedSlowTask.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogDISTerrainHeightFieldBaker, Log, All);
+
+#define LOCTEXT_NAMESPACE "FDISTerrainHeightFieldBaker"
+
+bool FDISTerrainHeightFieldBaker::Bake(UDISTerrainHeightField& HeightField, UWorld& World)
+{
+	const FBox bounds = HeightField.BakeBounds;
+	if (!bounds.IsValid || bounds.Max.X <= bounds.Min.X || bounds.Max.Y <= bounds.Min.Y || bounds.Max.Z <= bounds.Min.Z)
+	{
+		UE_LOG(LogDISTerrainHeightFieldBaker, Error, TEXT("Cannot bake %s, its bake bounds are empty."), *HeightField.GetName());
+		return false;
+	}
+
+	const float sampleSpacing = FMath::Max(HeightField.BakeSampleSpacing, 1.0f);
+	const int32 tileSamples = FMath::Max(HeightField.BakeTileSamples, 1);
+	const int32 stride = tileSamples + 1;
+	const FIntPoint numCells(FMath::Max(FMath::CeilToInt((bounds.Max.X - bounds.Min.X) / sampleSpacing), 1), FMath::Max(FMath::CeilToInt((bounds.Max.Y - bounds.Min.Y) / sampleSpacing), 1));
+	const FIntPoint numTiles(FMath::DivideAndRoundUp(numCells.X, tileSamples), FMath::DivideAndRoundUp(numCells.Y, tileSamples));
+	const ECollisionChannel traceChannel = UEngineTypes::ConvertToCollisionChannel(HeightField.BakeTraceChannel);
+	const FCollisionQueryParams queryParams(FName("DIS Terrain Height Field Bake"), false);
+
+	FScopedSlowTask slowTask(numTiles.X * numTiles.Y, FText::Format(LOCTEXT("BakingTerrainHeightField", "Baking {0}..."), FText::FromString(HeightField.GetName())));
+	slowTask.MakeDialog(true);
+
+	TArray<FDISTerrainHeightFieldTile> tiles;
+	tiles.SetNum(numTiles.X * numTiles.Y);
+	int32 numStaticSamples = 0;
+	int32 numDynamicSamples = 0;
+
+	for (int32 tileY = 0; tileY < numTiles.Y; tileY++)
+	{
+		for (int32 tileX = 0; tileX < numTiles.X; tileX++)
+		{
+			if (slowTask.ShouldCancel())
+			{
+				UE_LOG(LogDISTerrainHeightFieldBaker, Warning, TEXT("Baking %s was canceled."), *HeightField.GetName());
+				return false;
+			}
+			slowTask.EnterProgressFrame(1);
+
+			FDISTerrainHeightFieldTile& tile = tiles[tileY * numTiles.X + tileX];
+			tile.Heights.SetNumZeroed(stride * stride);
+			tile.PackedNormals.SetNumUninitialized(stride * stride);
+			tile.SampleFlags.SetNumUninitialized(stride * stride);
+
+			bool bHasStaticSample = false;
+			for (int32 sampleY = 0; sampleY < stride; sampleY++)
+			{
+				for (int32 sampleX = 0; sampleX < stride; sampleX++)
+				{
+					const int32 sampleIndex = sampleY * stride + sampleX;
+					const float x = bounds.Min.X + (tileX * tileSamples + sampleX) * sampleSpacing;
+					const float y = bounds.Min.Y + (tileY * tileSamples + sampleY) * sampleSpacing;
+
+					FHitResult hit;
+					if (World.LineTraceSingleByChannel(hit, FVector(x, y, bounds.Max.Z), FVector(x, y, bounds.Min.Z), traceChannel, queryParams))
+					{
+						tile.Heights[sampleIndex] = hit.Location.Z;
+						tile.PackedNormals[sampleIndex] = UDISTerrainHeightField::PackNormal(hit.ImpactNormal);
+
+						if (IsStaticTerrain(HeightField, hit))
+						{
+							tile.SampleFlags[sampleIndex] = 0;
+							bHasStaticSample = true;
+							numStaticSamples++;
+						}
+						else
+						{
+							tile.SampleFlags[sampleIndex] = UDISTerrainHeightField::SAMPLE_DYNAMIC;
+							numDynamicSamples++;
+						}
+					}
+					else
+					{
+						tile.PackedNormals[sampleIndex] = UDISTerrainHeightField::PackNormal(FVector::UpVector);
+						tile.SampleFlags[sampleIndex] = UDISTerrainHeightField::SAMPLE_MISSING;
+					}
+				}
+			}
+
+			//Tiles without any static terrain are always traced, so they are not stored
+			if (!bHasStaticSample)
+			{
+				tile = FDISTerrainHeightFieldTile();
+			}
+		}
+	}
+
+	HeightField.Modify();
+	HeightField.Origin = FVector2D(bounds.Min.X, bounds.Min.Y);
+	HeightField.SampleSpacing = sampleSpacing;
+	HeightField.TileSamples = tileSamples;
+	HeightField.NumTiles = numTiles;
+	HeightField.Tiles = MoveTemp(tiles);
+	HeightField.MarkPackageDirty();
+
+	UE_LOG(LogDISTerrainHeightFieldBaker, Log, TEXT("Baked %s: %d x %d tiles, %d static and %d dynamic samples."), *HeightField.GetName(), numTiles.X, numTiles.Y, numStaticSamples, numDynamicSamples);
+	return true;
+}
+
+bool FDISTerrainHeightFieldBaker::IsStaticTerrain(const UDISTerrainHeightField& HeightField, const FHitResult& Hit)
+{
+	const UPrimitiveComponent* hitComponent = Hit.GetComponent();
+	const AActor* hitActor = Hit.GetActor();
+	if (hitComponent == nullptr || hitComponent->Mobility != EComponentMobility::Static)
+	{
+		return false;
+	}
+
+	if (HeightField.DynamicGroundTag != NAME_None && (hitComponent->ComponentHasTag(HeightField.DynamicGroundTag) || (hitActor != nullptr && hitActor->ActorHasTag(HeightField.DynamicGroundTag))))
+	{
+		return false;
+	}
+
+	return !HeightField.OnlyLandscapeIsTerrain || (hitActor != nullptr && hitActor->IsA<ALandscapeProxy>());
+}
+
+#undef LOCTEXT_NAMESPACE
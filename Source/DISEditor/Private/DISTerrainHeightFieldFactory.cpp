@@ -0,0 +1,19 @@
+// Copyright 2022 Gaming Research Integration for Learning Lab. All Rights Reserved.
+
+
+#include "DISTerrainHeightFieldFactory.h"
+
+
+UDISTerrainHeightFieldFactory::UDISTerrainHeightFieldFactory()
+{
+	bCreateNew = true;
+	bEditAfterNew = true;
+	//Configure the class that this factory creates
+	SupportedClass = UDISTerrainHeightField::StaticClass();
+}
+
+UObject* UDISTerrainHeightFieldFactory::FactoryCreateNew(UClass* InClass, UObject* InParent, FName InName, EObjectFlags Flags, UObject* Context, FFeedbackContext* Warn)
+{
+	//Create the editor asset 
+	return NewObject<UDISTerrainHeightField>(InParent, InClass, InName, Flags);
+}
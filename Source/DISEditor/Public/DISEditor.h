@@ -17,4 +17,8 @@ public:
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
 
+private:
+	/** Adds the bake action to the content browser context menu of DIS Terrain Height Field assets. */
+	void RegisterMenus();
+
 };
@@ -0,0 +1,29 @@
+// Copyright 2022 Gaming Research Integration for Learning Lab. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+//Forward declarations
+class UDISTerrainHeightField;
+class UWorld;
+struct FHitResult;
+
+/**
+ * Bakes the ground collision of a level into a DIS Terrain Height Field.
+ */
+class DISEDITOR_API FDISTerrainHeightFieldBaker
+{
+public:
+	/**
+	 * Traces the ground at every sample of the given height field's bake bounds and replaces its baked data. Shows a cancelable progress dialog.
+	 * Returns whether or not the bake finished. The height field is left untouched if the bake fails or is canceled.
+	 * @param HeightField - The height field to bake, using its bake settings.
+	 * @param World - The world whose collision is baked.
+	 */
+	static bool Bake(UDISTerrainHeightField& HeightField, UWorld& World);
+
+private:
+	/** Returns whether or not the given ground hit is static terrain that can be looked up instead of traced at runtime. */
+	static bool IsStaticTerrain(const UDISTerrainHeightField& HeightField, const FHitResult& Hit);
+};
@@ -0,0 +1,33 @@
+// Copyright 2022 Gaming Research Integration for Learning Lab. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Factories/Factory.h"
+#include "AssetTypeActions_Base.h"
+#include "DISTerrainHeightField.h"
+#include "DISTerrainHeightFieldFactory.generated.h"
+
+/**
+ * Creates DIS Terrain Height Field assets. They are baked from the current level through their content browser context menu.
+ */
+UCLASS()
+class DISEDITOR_API UDISTerrainHeightFieldFactory : public UFactory
+{
+	GENERATED_BODY()
+
+public:
+	UDISTerrainHeightFieldFactory();
+
+	/* Creates the asset inside the UE4 Editor */
+	virtual UObject* FactoryCreateNew(UClass* InClass, UObject* InParent, FName InName, EObjectFlags Flags, UObject* Context, FFeedbackContext* Warn) override;
+};
+
+class FDISTerrainHeightFieldAssetTypeActions : public FAssetTypeActions_Base {
+public:
+	virtual FText GetName() const override { return FText::FromString("DIS Terrain Height Field"); }
+	virtual uint32 GetCategories() override { return EAssetTypeCategories::Misc; }
+	virtual FColor GetTypeColor() const override { return FColor(127, 191, 63); }
+	virtual FText GetAssetDescription(const FAssetData& AssetData) const override { return FText::FromString("Ground heights and normals baked from a level's collision, used to ground clamp DIS entities without tracing."); }
+	virtual UClass* GetSupportedClass() const override { return UDISTerrainHeightField::StaticClass(); }
+};
@@ -0,0 +1,305 @@
+// Copyright 2022 Gaming Research Integration for Learning Lab. All Rights Reserved.
+
+#include "DISAreaOfInterest.h"
+#include "DIS_BPFL.h"
+
+namespace
+{
+	//Byte offsets into the PDU packets, which are big endian
+	constexpr int32 EXERCISE_ID_OFFSET = 1;
+	constexpr int32 ENTITY_ID_OFFSET = 12;
+	constexpr int32 ENTITY_STATE_ENTITY_TYPE_OFFSET = 20;
+	constexpr int32 ENTITY_STATE_LOCATION_OFFSET = 48;
+	constexpr int32 ENTITY_STATE_UPDATE_LOCATION_OFFSET = 32;
+
+	uint16 ReadUInt16(const uint8* Bytes)
+	{
+		return static_cast<uint16>((Bytes[0] << 8) | Bytes[1]);
+	}
+
+	double ReadDouble(const uint8* Bytes)
+	{
+		uint64 bits = 0;
+		for (int32 byteIndex = 0; byteIndex < 8; byteIndex++)
+		{
+			bits = (bits << 8) | Bytes[byteIndex];
+		}
+
+		double value;
+		FMemory::Memcpy(&value, &bits, sizeof(value));
+		return value;
+	}
+}
+
+void FDISAreaOfInterest::SetVolumes(const TArray<FDISAreaOfInterestPolygon>& PolygonsIn, const TArray<FDISAreaOfInterestAltitudeBand>& AltitudeBandsIn, float ViewpointRadiusMetersIn)
+{
+	FWriteScopeLock lock(VolumesLock);
+
+	Polygons.Reset();
+	for (const FDISAreaOfInterestPolygon& polygon : PolygonsIn)
+	{
+		if (polygon.LatLonVertices.Num() < 3)
+		{
+			continue;
+		}
+
+		FPolygon& compiledPolygon = Polygons.AddDefaulted_GetRef();
+		compiledPolygon.Vertices = polygon.LatLonVertices;
+		compiledPolygon.Bounds = FBox2D(polygon.LatLonVertices);
+		compiledPolygon.MinAltitude = polygon.MinAltitude;
+		compiledPolygon.MaxAltitude = polygon.MaxAltitude;
+	}
+
+	AltitudeBands.Reset();
+	for (const FDISAreaOfInterestAltitudeBand& altitudeBand : AltitudeBandsIn)
+	{
+		AltitudeBands.Add(FFloatRange::Inclusive(altitudeBand.MinAltitude, altitudeBand.MaxAltitude));
+	}
+
+	ViewpointRadiusMeters = FMath::Max(ViewpointRadiusMetersIn, 0.0f);
+}
+
+void FDISAreaOfInterest::SetViewpoints(TArrayView<const FVector> ViewpointECEFLocations)
+{
+	FWriteScopeLock lock(VolumesLock);
+	Viewpoints.Reset();
+	Viewpoints.Append(ViewpointECEFLocations.GetData(), ViewpointECEFLocations.Num());
+}
+
+void FDISAreaOfInterest::SetTrackOutOfAreaEntities(bool bTrack)
+{
+	bTrackOutOfAreaEntities = bTrack;
+	if (!bTrack)
+	{
+		FScopeLock lock(&OutOfAreaEntitiesCriticalSection);
+		OutOfAreaEntities.Empty();
+	}
+}
+
+bool FDISAreaOfInterest::IsRelevant(const double ECEFLocation[3]) const
+{
+	FReadScopeLock lock(VolumesLock);
+
+	//Viewpoint spheres only need a distance check, so test them before converting to latitude, longitude, and height
+	if (ViewpointRadiusMeters > 0)
+	{
+		const double viewpointRadiusSquared = ViewpointRadiusMeters * ViewpointRadiusMeters;
+		for (const FVector& viewpoint : Viewpoints)
+		{
+			const double distanceSquared = FMath::Square(ECEFLocation[0] - viewpoint.X) + FMath::Square(ECEFLocation[1] - viewpoint.Y) + FMath::Square(ECEFLocation[2] - viewpoint.Z);
+			if (distanceSquared <= viewpointRadiusSquared)
+			{
+				return true;
+			}
+		}
+	}
+
+	//An area made only of viewpoint spheres cannot rule anything out until it knows where the viewpoints are, such as before the local players have spawned
+	if (Polygons.Num() == 0 && AltitudeBands.Num() == 0)
+	{
+		return ViewpointRadiusMeters > 0 && Viewpoints.Num() == 0;
+	}
+
+	FLatLonHeightDouble latLonHeight;
+	UDIS_BPFL::CalculateLatLonHeightFromEcefXYZ(FEarthCenteredEarthFixedDouble(ECEFLocation[0], ECEFLocation[1], ECEFLocation[2]), latLonHeight);
+
+	for (const FFloatRange& altitudeBand : AltitudeBands)
+	{
+		if (altitudeBand.Contains(static_cast<float>(latLonHeight.Height)))
+		{
+			return true;
+		}
+	}
+
+	const FVector2D latLon(latLonHeight.Latitude, latLonHeight.Longitude);
+	for (const FPolygon& polygon : Polygons)
+	{
+		if (latLonHeight.Height >= polygon.MinAltitude && latLonHeight.Height <= polygon.MaxAltitude && polygon.Bounds.IsInside(latLon) && IsInsidePolygon(polygon, latLon))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool FDISAreaOfInterest::IsInsidePolygon(const FPolygon& Polygon, const FVector2D& LatLon)
+{
+	//Count the polygon edges crossed by a ray from the point towards increasing longitude
+	bool bInside = false;
+	for (int32 vertexIndex = 0, previousIndex = Polygon.Vertices.Num() - 1; vertexIndex < Polygon.Vertices.Num(); previousIndex = vertexIndex++)
+	{
+		const FVector2D& vertex = Polygon.Vertices[vertexIndex];
+		const FVector2D& previousVertex = Polygon.Vertices[previousIndex];
+
+		if ((vertex.X > LatLon.X) != (previousVertex.X > LatLon.X)
+			&& LatLon.Y < (previousVertex.Y - vertex.Y) * (LatLon.X - vertex.X) / (previousVertex.X - vertex.X) + vertex.Y)
+		{
+			bInside = !bInside;
+		}
+	}
+
+	return bInside;
+}
+
+bool FDISAreaOfInterest::FilterEntityStatePacket(const TArray<uint8>& InData)
+{
+	return FilterEntityPacket(InData, ENTITY_STATE_LOCATION_OFFSET, ENTITY_STATE_ENTITY_TYPE_OFFSET);
+}
+
+bool FDISAreaOfInterest::FilterEntityStateUpdatePacket(const TArray<uint8>& InData)
+{
+	//Entity State Update PDUs do not carry an Entity Type
+	return FilterEntityPacket(InData, ENTITY_STATE_UPDATE_LOCATION_OFFSET, INDEX_NONE);
+}
+
+bool FDISAreaOfInterest::FilterEntityPacket(const TArray<uint8>& InData, int32 LocationOffset, int32 EntityTypeOffset)
+{
+	const uint8* bytes = InData.GetData();
+	if (InData.Num() < LocationOffset + 24 || bytes[EXERCISE_ID_OFFSET] != ExerciseID.Load())
+	{
+		return true;
+	}
+
+	FEntityID entityID;
+	entityID.Site = ReadUInt16(bytes + ENTITY_ID_OFFSET);
+	entityID.Application = ReadUInt16(bytes + ENTITY_ID_OFFSET + 2);
+	entityID.Entity = ReadUInt16(bytes + ENTITY_ID_OFFSET + 4);
+
+	{
+		FReadScopeLock lock(RegisteredEntitiesLock);
+		if (RegisteredEntities.Contains(entityID.ToUInt64()))
+		{
+			return true;
+		}
+	}
+
+	const double ecefLocation[3] = { ReadDouble(bytes + LocationOffset), ReadDouble(bytes + LocationOffset + 8), ReadDouble(bytes + LocationOffset + 16) };
+	if (IsRelevant(ecefLocation))
+	{
+		return true;
+	}
+
+	if (bTrackOutOfAreaEntities)
+	{
+		if (EntityTypeOffset != INDEX_NONE)
+		{
+			const uint8* entityTypeBytes = bytes + EntityTypeOffset;
+			FEntityType entityType;
+			entityType.EntityKind = entityTypeBytes[0];
+			entityType.Domain = entityTypeBytes[1];
+			entityType.Country = ReadUInt16(entityTypeBytes + 2);
+			entityType.Category = entityTypeBytes[4];
+			entityType.Subcategory = entityTypeBytes[5];
+			entityType.Specific = entityTypeBytes[6];
+			entityType.Extra = entityTypeBytes[7];
+			UpdateOutOfAreaEntity(entityID, &entityType, ecefLocation);
+		}
+		else
+		{
+			UpdateOutOfAreaEntity(entityID, nullptr, ecefLocation);
+		}
+	}
+
+	return false;
+}
+
+void FDISAreaOfInterest::AddRegisteredEntity(const FEntityID& EntityID)
+{
+	FWriteScopeLock lock(RegisteredEntitiesLock);
+	RegisteredEntities.Add(EntityID.ToUInt64());
+}
+
+void FDISAreaOfInterest::RemoveRegisteredEntity(const FEntityID& EntityID)
+{
+	FWriteScopeLock lock(RegisteredEntitiesLock);
+	RegisteredEntities.Remove(EntityID.ToUInt64());
+}
+
+void FDISAreaOfInterest::UpdateOutOfAreaEntity(const FEntityID& EntityID, const FEntityType* EntityType, const double ECEFLocation[3])
+{
+	FScopeLock lock(&OutOfAreaEntitiesCriticalSection);
+
+	//Entity State Update PDUs cannot start a record since they do not say what the entity is
+	FOutOfAreaRecord* record = EntityType != nullptr ? &OutOfAreaEntities.FindOrAdd(EntityID.ToUInt64()) : OutOfAreaEntities.Find(EntityID.ToUInt64());
+	if (record == nullptr)
+	{
+		return;
+	}
+
+	if (EntityType != nullptr)
+	{
+		record->EntityType = *EntityType;
+	}
+	record->ECEFLocation[0] = ECEFLocation[0];
+	record->ECEFLocation[1] = ECEFLocation[1];
+	record->ECEFLocation[2] = ECEFLocation[2];
+	record->LastUpdateSeconds = FPlatformTime::Seconds();
+}
+
+bool FDISAreaOfInterest::RemoveOutOfAreaEntity(const FEntityID& EntityID)
+{
+	FScopeLock lock(&OutOfAreaEntitiesCriticalSection);
+	return OutOfAreaEntities.Remove(EntityID.ToUInt64()) > 0;
+}
+
+int32 FDISAreaOfInterest::PruneOutOfAreaEntities(double MaxSecondsSinceLastUpdate)
+{
+	const double oldestUpdateSeconds = FPlatformTime::Seconds() - MaxSecondsSinceLastUpdate;
+
+	FScopeLock lock(&OutOfAreaEntitiesCriticalSection);
+	int32 numPruned = 0;
+	for (auto recordIterator = OutOfAreaEntities.CreateIterator(); recordIterator; ++recordIterator)
+	{
+		if (recordIterator.Value().LastUpdateSeconds < oldestUpdateSeconds)
+		{
+			recordIterator.RemoveCurrent();
+			numPruned++;
+		}
+	}
+
+	return numPruned;
+}
+
+void FDISAreaOfInterest::GetOutOfAreaEntities(TArray<FDISOutOfAreaEntity>& OutEntities) const
+{
+	const double currentSeconds = FPlatformTime::Seconds();
+
+	FScopeLock lock(&OutOfAreaEntitiesCriticalSection);
+	OutEntities.Reserve(OutEntities.Num() + OutOfAreaEntities.Num());
+	for (const TPair<uint64, FOutOfAreaRecord>& record : OutOfAreaEntities)
+	{
+		FDISOutOfAreaEntity& outOfAreaEntity = OutEntities.AddDefaulted_GetRef();
+		outOfAreaEntity.EntityID.Site = static_cast<int32>((record.Key >> 32) & 0xFFFF);
+		outOfAreaEntity.EntityID.Application = static_cast<int32>((record.Key >> 16) & 0xFFFF);
+		outOfAreaEntity.EntityID.Entity = static_cast<int32>(record.Key & 0xFFFF);
+		outOfAreaEntity.EntityType = record.Value.EntityType;
+		outOfAreaEntity.ECEFLocation = FVector(record.Value.ECEFLocation[0], record.Value.ECEFLocation[1], record.Value.ECEFLocation[2]);
+		outOfAreaEntity.SecondsSinceLastUpdate = static_cast<float>(currentSeconds - record.Value.LastUpdateSeconds);
+	}
+}
+
+int32 FDISAreaOfInterest::GetNumOutOfAreaEntities() const
+{
+	FScopeLock lock(&OutOfAreaEntitiesCriticalSection);
+	return OutOfAreaEntities.Num();
+}
+
+void FDISAreaOfInterest::Reset()
+{
+	{
+		FWriteScopeLock lock(VolumesLock);
+		Polygons.Reset();
+		AltitudeBands.Reset();
+		Viewpoints.Reset();
+		ViewpointRadiusMeters = 0;
+	}
+	{
+		FWriteScopeLock lock(RegisteredEntitiesLock);
+		RegisteredEntities.Reset();
+	}
+	{
+		FScopeLock lock(&OutOfAreaEntitiesCriticalSection);
+		OutOfAreaEntities.Reset();
+	}
+}
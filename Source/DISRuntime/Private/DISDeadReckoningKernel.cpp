@@ -0,0 +1,269 @@
+// Copyright 2022 Gaming Research Integration for Learning Lab. All Rights Reserved.
+
+#include "DISDeadReckoningKernel.h"
+#include "DeadReckoning_BPFL.h"
+#include "DIS_BPFL.h"
+
+namespace
+{
+	/** Compile time properties of each dead reckoning algorithm. */
+	template<EDeadReckoningAlgorithm Algorithm>
+	struct TDeadReckoningAlgorithmTraits
+	{
+		/** Whether or not the location changes. */
+		static constexpr bool bMoves = Algorithm != EDeadReckoningAlgorithm::Static;
+		/** Whether or not velocity and acceleration are given in body coordinates. */
+		static constexpr bool bBodyCoordinates = Algorithm == EDeadReckoningAlgorithm::FPB || Algorithm == EDeadReckoningAlgorithm::RPB
+			|| Algorithm == EDeadReckoningAlgorithm::RVB || Algorithm == EDeadReckoningAlgorithm::FVB;
+		/** Whether or not linear acceleration contributes to world coordinate location. */
+		static constexpr bool bUsesAcceleration = Algorithm == EDeadReckoningAlgorithm::RVW || Algorithm == EDeadReckoningAlgorithm::FVW;
+		/** Whether or not the orientation rotates with the angular velocity. */
+		static constexpr bool bRotates = Algorithm == EDeadReckoningAlgorithm::RPW || Algorithm == EDeadReckoningAlgorithm::RVW
+			|| Algorithm == EDeadReckoningAlgorithm::RPB || Algorithm == EDeadReckoningAlgorithm::RVB;
+	};
+}
+
+FDISDeadReckoningKernel::FDISDeadReckoningKernel()
+{
+	Precompute(FDISEntityState());
+}
+
+void FDISDeadReckoningKernel::Precompute(const FDISEntityState& EntityState)
+{
+	Location = glm::dvec3(EntityState.EntityLocation[0], EntityState.EntityLocation[1], EntityState.EntityLocation[2]);
+	Orientation = EntityState.EntityOrientation;
+	LinearVelocity = EntityState.EntityLinearVelocity;
+	LinearAcceleration = EntityState.EntityLinearAcceleration;
+
+	WorldVelocity = glm::dvec3(LinearVelocity.X, LinearVelocity.Y, LinearVelocity.Z);
+	WorldAcceleration = glm::dvec3(LinearAcceleration.X, LinearAcceleration.Y, LinearAcceleration.Z);
+
+	OrientationMode = EOrientationMode::Constant;
+	RotationRate = 0;
+	bBodyRotating = false;
+	BodyAngularSpeed = 0;
+
+	const glm::dvec3 angularVelocity = glm::dvec3(EntityState.EntityAngularVelocity.X, EntityState.EntityAngularVelocity.Y, EntityState.EntityAngularVelocity.Z);
+
+	//If the entity is frozen, don't update dead reckoning
+	if (EntityState.EntityAppearance.IsFrozen)
+	{
+		EvaluateFunction = &EvaluateNotDeadReckoned;
+		bStationary = true;
+		return;
+	}
+
+	switch (EntityState.DeadReckoningAlgorithm)
+	{
+	case EDeadReckoningAlgorithm::Static:
+		EvaluateFunction = &EvaluateAlgorithm<EDeadReckoningAlgorithm::Static>;
+		PrecomputeOrientation(EntityState, false, angularVelocity, angularVelocity);
+		break;
+
+	case EDeadReckoningAlgorithm::FPW:
+		EvaluateFunction = &EvaluateAlgorithm<EDeadReckoningAlgorithm::FPW>;
+		PrecomputeOrientation(EntityState, false, angularVelocity, angularVelocity);
+		break;
+
+	case EDeadReckoningAlgorithm::RPW:
+		EvaluateFunction = &EvaluateAlgorithm<EDeadReckoningAlgorithm::RPW>;
+		PrecomputeOrientation(EntityState, true, angularVelocity, angularVelocity);
+		break;
+
+	case EDeadReckoningAlgorithm::RVW:
+		EvaluateFunction = &EvaluateAlgorithm<EDeadReckoningAlgorithm::RVW>;
+		PrecomputeOrientation(EntityState, true, angularVelocity, angularVelocity);
+		break;
+
+	case EDeadReckoningAlgorithm::FVW:
+		EvaluateFunction = &EvaluateAlgorithm<EDeadReckoningAlgorithm::FVW>;
+		PrecomputeOrientation(EntityState, false, angularVelocity, angularVelocity);
+		break;
+
+	case EDeadReckoningAlgorithm::FPB:
+		EvaluateFunction = &EvaluateAlgorithm<EDeadReckoningAlgorithm::FPB>;
+		PrecomputeBodyMotion(glm::dvec3(0));
+		PrecomputeOrientation(EntityState, false, angularVelocity, angularVelocity);
+		break;
+
+	case EDeadReckoningAlgorithm::RPB:
+		//Rotation Position Body dead reckons location without angular velocity, and only uses angular velocity to rotate the other parameters quaternion
+		EvaluateFunction = &EvaluateAlgorithm<EDeadReckoningAlgorithm::RPB>;
+		PrecomputeBodyMotion(glm::dvec3(0));
+		PrecomputeOrientation(EntityState, true, angularVelocity, glm::dvec3(0));
+		break;
+
+	case EDeadReckoningAlgorithm::RVB:
+		EvaluateFunction = &EvaluateAlgorithm<EDeadReckoningAlgorithm::RVB>;
+		PrecomputeBodyMotion(angularVelocity);
+		PrecomputeOrientation(EntityState, true, angularVelocity, angularVelocity);
+		break;
+
+	case EDeadReckoningAlgorithm::FVB:
+		EvaluateFunction = &EvaluateAlgorithm<EDeadReckoningAlgorithm::FVB>;
+		PrecomputeBodyMotion(angularVelocity);
+		PrecomputeOrientation(EntityState, false, angularVelocity, angularVelocity);
+		break;
+
+	default:
+		EvaluateFunction = &EvaluateNotDeadReckoned;
+		break;
+	}
+
+	//The pose cannot change if nothing moves it. A zero angular velocity is only nudged to avoid dividing by zero, so it does not count as rotating.
+	bStationary = EntityState.DeadReckoningAlgorithm == EDeadReckoningAlgorithm::Static || EvaluateFunction == &EvaluateNotDeadReckoned
+		|| (WorldVelocity == glm::dvec3(0) && WorldAcceleration == glm::dvec3(0) && (OrientationMode == EOrientationMode::Constant || angularVelocity == glm::dvec3(0)));
+}
+
+void FDISDeadReckoningKernel::PrecomputeBodyMotion(const glm::dvec3& AngularVelocity)
+{
+	const glm::dmat3 skewMatrix = UDIS_BPFL::CreateNCrossXMatrix(AngularVelocity);
+	const glm::dvec3 bodyVelocity = WorldVelocity;
+	const glm::dvec3 bodyAcceleration = WorldAcceleration - (skewMatrix * bodyVelocity);
+
+	//Rotate everything from body coordinates into world coordinates up front so only scalar coefficients change per evaluation
+	const glm::dmat3 inverseOrientationMatrix = glm::transpose(UDeadReckoning_BPFL::GetEntityOrientationMatrix(Orientation.Yaw, Orientation.Pitch, Orientation.Roll));
+	const glm::dmat3 omegaMatrix = glm::dmat3(AngularVelocity, glm::dvec3(0), glm::dvec3(0)) * glm::transpose(glm::dmat3(AngularVelocity, glm::dvec3(0), glm::dvec3(0)));
+
+	BodyAngularSpeed = glm::length(AngularVelocity);
+	bBodyRotating = BodyAngularSpeed >= UDeadReckoning_BPFL::MIN_ROTATION_RATE;
+
+	BodyVelocityTerms[0] = inverseOrientationMatrix * (omegaMatrix * bodyVelocity);
+	BodyVelocityTerms[1] = inverseOrientationMatrix * bodyVelocity;
+	BodyVelocityTerms[2] = inverseOrientationMatrix * (skewMatrix * bodyVelocity);
+	BodyAccelerationTerms[0] = inverseOrientationMatrix * (omegaMatrix * bodyAcceleration);
+	BodyAccelerationTerms[1] = inverseOrientationMatrix * bodyAcceleration;
+	BodyAccelerationTerms[2] = inverseOrientationMatrix * (skewMatrix * bodyAcceleration);
+}
+
+void FDISDeadReckoningKernel::PrecomputeOrientation(const FDISEntityState& EntityState, bool bRotates, const glm::dvec3& QuaternionAngularVelocity, const glm::dvec3& MatrixAngularVelocity)
+{
+	if (!bRotates)
+	{
+		//Fixed orientation algorithms take their orientation from the other parameters if they are set, which only needs converting once
+		FRotator localRotator;
+		if (UDeadReckoning_BPFL::GetLocalEulerAngles(MakeArrayView(EntityState.OtherDeadReckoningParameters), localRotator))
+		{
+			FPsiThetaPhi psiThetaPhiRadians;
+			UDeadReckoning_BPFL::ConvertLocalRotatorToPsiThetaPhiRadians(EntityState.EntityLocation, localRotator, psiThetaPhiRadians);
+			Orientation = FRotator(psiThetaPhiRadians.Theta, psiThetaPhiRadians.Psi, psiThetaPhiRadians.Phi);
+		}
+		return;
+	}
+
+	const bool bUseQuaternion = UDeadReckoning_BPFL::GetLocalQuaternionAngles(MakeArrayView(EntityState.OtherDeadReckoningParameters), InitialQuaternion);
+
+	//A zero angular velocity is nudged to avoid dividing by zero, matching UDeadReckoning_BPFL::CreateDeadReckoningQuaternion and CreateDeadReckoningMatrix
+	glm::dvec3 angularVelocity = bUseQuaternion ? QuaternionAngularVelocity : MatrixAngularVelocity;
+	RotationRate = glm::length(angularVelocity);
+	if (RotationRate == 0)
+	{
+		RotationRate = 1e-5;
+		angularVelocity += glm::dvec3(1e-5);
+	}
+
+	if (bUseQuaternion)
+	{
+		OrientationMode = EOrientationMode::Quaternion;
+		RotationAxis = angularVelocity / RotationRate;
+	}
+	else
+	{
+		OrientationMode = EOrientationMode::Matrix;
+		InitialOrientationMatrix = UDeadReckoning_BPFL::GetEntityOrientationMatrix(Orientation.Yaw, Orientation.Pitch, Orientation.Roll);
+		RotationAxisOuterProduct = (glm::dmat3(angularVelocity, glm::dvec3(0), glm::dvec3(0)) * glm::transpose(glm::dmat3(angularVelocity, glm::dvec3(0), glm::dvec3(0)))) / (RotationRate * RotationRate);
+		RotationAxisCrossMatrix = UDIS_BPFL::CreateNCrossXMatrix(angularVelocity) / RotationRate;
+	}
+}
+
+glm::dvec3 FDISDeadReckoningKernel::EvaluateBodyPosition(double DeltaTime) const
+{
+	if (!bBodyRotating)
+	{
+		return Location + (BodyVelocityTerms[1] * DeltaTime) + (BodyAccelerationTerms[1] * (DeltaTime * DeltaTime / 2));
+	}
+
+	const double w = BodyAngularSpeed;
+	const double wt = w * DeltaTime;
+	const double sinWt = glm::sin(wt);
+	const double cosWt = glm::cos(wt);
+	const double w2 = w * w;
+	const double w3 = w2 * w;
+	const double w4 = w2 * w2;
+
+	//Coefficients of the R1 and R2 matrices from IEEE 1278.1 Annex E applied to the precomputed Omega, identity, and skew terms
+	const double r1Omega = (wt - sinWt) / w3;
+	const double r1Identity = sinWt / w;
+	const double r1Skew = (1 - cosWt) / w2;
+	const double r2Omega = ((0.5 * wt * wt) - cosWt - (wt * sinWt) + 1) / w4;
+	const double r2Identity = (cosWt + (wt * sinWt) - 1) / w2;
+	const double r2Skew = (sinWt - (wt * cosWt)) / w3;
+
+	return Location
+		+ (BodyVelocityTerms[0] * r1Omega) + (BodyVelocityTerms[1] * r1Identity) + (BodyVelocityTerms[2] * r1Skew)
+		+ (BodyAccelerationTerms[0] * r2Omega) + (BodyAccelerationTerms[1] * r2Identity) + (BodyAccelerationTerms[2] * r2Skew);
+}
+
+FRotator FDISDeadReckoningKernel::EvaluateOrientation(double DeltaTime) const
+{
+	switch (OrientationMode)
+	{
+	case EOrientationMode::Quaternion:
+	{
+		const double halfBeta = RotationRate * DeltaTime / 2;
+		const double sinHalfBeta = glm::sin(halfBeta);
+		const FQuat deadReckoningQuaternion(RotationAxis.x * sinHalfBeta, RotationAxis.y * sinHalfBeta, RotationAxis.z * sinHalfBeta, glm::cos(halfBeta));
+		return UDeadReckoning_BPFL::ConvertQuaternionToPsiThetaPhiRadians(InitialQuaternion * deadReckoningQuaternion);
+	}
+
+	case EOrientationMode::Matrix:
+	{
+		const double cosBeta = glm::cos(RotationRate * DeltaTime);
+		const double sinBeta = glm::sin(RotationRate * DeltaTime);
+		const glm::dmat3 deadReckoningMatrix = ((1 - cosBeta) * RotationAxisOuterProduct) + (cosBeta * glm::dmat3(1)) - (sinBeta * RotationAxisCrossMatrix);
+		return UDeadReckoning_BPFL::ConvertOrientationMatrixToPsiThetaPhiRadians(deadReckoningMatrix * InitialOrientationMatrix);
+	}
+
+	default:
+		return Orientation;
+	}
+}
+
+template<EDeadReckoningAlgorithm Algorithm>
+bool FDISDeadReckoningKernel::EvaluateAlgorithm(const FDISDeadReckoningKernel& Kernel, double DeltaTime, FDISEntityState& DeadReckonedEntityState)
+{
+	using FTraits = TDeadReckoningAlgorithmTraits<Algorithm>;
+
+	glm::dvec3 location = Kernel.Location;
+	if (FTraits::bBodyCoordinates)
+	{
+		location = Kernel.EvaluateBodyPosition(DeltaTime);
+	}
+	else if (FTraits::bMoves)
+	{
+		location += Kernel.WorldVelocity * DeltaTime;
+		if (FTraits::bUsesAcceleration)
+		{
+			location += Kernel.WorldAcceleration * (0.5 * DeltaTime * DeltaTime);
+		}
+	}
+
+	DeadReckonedEntityState.EntityLocation[0] = location.x;
+	DeadReckonedEntityState.EntityLocation[1] = location.y;
+	DeadReckonedEntityState.EntityLocation[2] = location.z;
+	DeadReckonedEntityState.EntityOrientation = FTraits::bRotates ? Kernel.EvaluateOrientation(DeltaTime) : Kernel.Orientation;
+	DeadReckonedEntityState.EntityLinearVelocity = Kernel.LinearVelocity + (Kernel.LinearAcceleration * static_cast<float>(DeltaTime));
+
+	return true;
+}
+
+bool FDISDeadReckoningKernel::EvaluateNotDeadReckoned(const FDISDeadReckoningKernel& Kernel, double DeltaTime, FDISEntityState& DeadReckonedEntityState)
+{
+	DeadReckonedEntityState.EntityLocation[0] = Kernel.Location.x;
+	DeadReckonedEntityState.EntityLocation[1] = Kernel.Location.y;
+	DeadReckonedEntityState.EntityLocation[2] = Kernel.Location.z;
+	DeadReckonedEntityState.EntityOrientation = Kernel.Orientation;
+	DeadReckonedEntityState.EntityLinearVelocity = Kernel.LinearVelocity;
+
+	return false;
+}
@@ -0,0 +1,393 @@
+// Copyright 2022 Gaming Research Integration for Learning Lab. All Rights Reserved.
+
+#include "DISEntityRegistry.h"
+#include "UObject/UObjectGlobals.h"
+#include "GameFramework/Actor.h"
+#include "DISReceiveComponent.h"
+#include "Async/ParallelFor.h"
+
+FDISEntityRegistry::FDISEntityRegistry()
+{
+	BucketKeys.SetNumZeroed(MIN_BUCKETS);
+	BucketDenseIndices.Init(INDEX_NONE, MIN_BUCKETS);
+	BucketMask = MIN_BUCKETS - 1;
+}
+
+FDISEntityHandle FDISEntityRegistry::Add(const FEntityID& EntityID, AActor* Actor, UDISReceiveComponent* Component)
+{
+	const uint64 key = EntityID.ToUInt64();
+
+	const int32 existingIndex = FindIndexByKey(key);
+	if (existingIndex != INDEX_NONE)
+	{
+		Actors[existingIndex] = Actor;
+		Components[existingIndex] = Component;
+		return GetHandle(existingIndex);
+	}
+
+	//Keep the load factor at or below one half so probe sequences stay short
+	if ((EntityIDs.Num() + 1) * 2 > BucketKeys.Num())
+	{
+		Rehash(BucketKeys.Num() * 2);
+	}
+
+	int32 slotIndex;
+	if (FreeSlots.Num() > 0)
+	{
+		slotIndex = FreeSlots.Pop(false);
+	}
+	else
+	{
+		slotIndex = SlotToDense.Add(INDEX_NONE);
+		SlotGenerations.Add(1);
+	}
+
+	const int32 denseIndex = EntityIDs.Add(EntityID);
+	EntityKeys.Add(key);
+	Actors.Add(Actor);
+	Components.Add(Component);
+	DenseToSlot.Add(slotIndex);
+	ReceivedEntityStates.AddDefaulted();
+	DeadReckonedEntityStates.AddDefaulted();
+	DeadReckoningParameters.AddDefaulted();
+	DeadReckoningKernels.AddDefaulted();
+	ProxyInstances.AddDefaulted();
+	InterpolationBuffers.AddDefaulted();
+	SlotToDense[slotIndex] = denseIndex;
+
+	InsertIntoBuckets(key, denseIndex);
+
+	return FDISEntityHandle(slotIndex, SlotGenerations[slotIndex]);
+}
+
+bool FDISEntityRegistry::Remove(const FEntityID& EntityID)
+{
+	const int32 denseIndex = FindIndex(EntityID);
+	if (denseIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	RemoveAtDense(denseIndex);
+	return true;
+}
+
+bool FDISEntityRegistry::Remove(FDISEntityHandle Handle)
+{
+	const int32 denseIndex = FindIndex(Handle);
+	if (denseIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	RemoveAtDense(denseIndex);
+	return true;
+}
+
+void FDISEntityRegistry::Reset()
+{
+	//Invalidate every outstanding handle before releasing the slots
+	for (int32 denseIndex = 0; denseIndex < DenseToSlot.Num(); denseIndex++)
+	{
+		const int32 slotIndex = DenseToSlot[denseIndex];
+		SlotGenerations[slotIndex]++;
+		SlotToDense[slotIndex] = INDEX_NONE;
+		FreeSlots.Add(slotIndex);
+	}
+
+	EntityKeys.Reset();
+	EntityIDs.Reset();
+	Actors.Reset();
+	Components.Reset();
+	DenseToSlot.Reset();
+	ReceivedEntityStates.Reset();
+	DeadReckonedEntityStates.Reset();
+	DeadReckoningParameters.Reset();
+	DeadReckoningKernels.Reset();
+	ProxyInstances.Reset();
+	InterpolationBuffers.Reset();
+
+	for (int32& bucketDenseIndex : BucketDenseIndices)
+	{
+		bucketDenseIndex = INDEX_NONE;
+	}
+}
+
+void FDISEntityRegistry::AddReferencedObjects(FReferenceCollector& Collector, const UObject* ReferencingObject)
+{
+	Collector.AddReferencedObjects(Actors, ReferencingObject);
+	Collector.AddReferencedObjects(Components, ReferencingObject);
+}
+
+int32 FDISEntityRegistry::FindIndexByKey(uint64 Key) const
+{
+	const int32 bucketIndex = FindBucket(Key);
+	return bucketIndex == INDEX_NONE ? INDEX_NONE : BucketDenseIndices[bucketIndex];
+}
+
+int32 FDISEntityRegistry::FindBucket(uint64 Key) const
+{
+	uint32 bucketIndex = HashKey(Key) & BucketMask;
+
+	//The load factor guarantees an empty bucket, so the probe always terminates
+	while (BucketDenseIndices[bucketIndex] != INDEX_NONE)
+	{
+		if (BucketKeys[bucketIndex] == Key)
+		{
+			return bucketIndex;
+		}
+		bucketIndex = (bucketIndex + 1) & BucketMask;
+	}
+
+	return INDEX_NONE;
+}
+
+void FDISEntityRegistry::InsertIntoBuckets(uint64 Key, int32 DenseIndex)
+{
+	uint32 bucketIndex = HashKey(Key) & BucketMask;
+	while (BucketDenseIndices[bucketIndex] != INDEX_NONE)
+	{
+		bucketIndex = (bucketIndex + 1) & BucketMask;
+	}
+
+	BucketKeys[bucketIndex] = Key;
+	BucketDenseIndices[bucketIndex] = DenseIndex;
+}
+
+void FDISEntityRegistry::RemoveBucket(int32 BucketIndex)
+{
+	uint32 holeIndex = BucketIndex;
+	uint32 bucketIndex = (holeIndex + 1) & BucketMask;
+
+	while (BucketDenseIndices[bucketIndex] != INDEX_NONE)
+	{
+		const uint32 homeIndex = HashKey(BucketKeys[bucketIndex]) & BucketMask;
+
+		//Move the entry back into the hole if its home bucket does not lie cyclically between the hole and its current bucket
+		const uint32 distanceFromHome = (bucketIndex - homeIndex) & BucketMask;
+		const uint32 distanceFromHole = (bucketIndex - holeIndex) & BucketMask;
+		if (distanceFromHome >= distanceFromHole)
+		{
+			BucketKeys[holeIndex] = BucketKeys[bucketIndex];
+			BucketDenseIndices[holeIndex] = BucketDenseIndices[bucketIndex];
+			holeIndex = bucketIndex;
+		}
+
+		bucketIndex = (bucketIndex + 1) & BucketMask;
+	}
+
+	BucketDenseIndices[holeIndex] = INDEX_NONE;
+}
+
+void FDISEntityRegistry::Rehash(int32 NewBucketCount)
+{
+	check(FMath::IsPowerOfTwo(NewBucketCount));
+
+	BucketKeys.SetNumZeroed(NewBucketCount);
+	BucketDenseIndices.Init(INDEX_NONE, NewBucketCount);
+	BucketMask = NewBucketCount - 1;
+
+	for (int32 denseIndex = 0; denseIndex < EntityKeys.Num(); denseIndex++)
+	{
+		InsertIntoBuckets(EntityKeys[denseIndex], denseIndex);
+	}
+}
+
+void FDISEntityRegistry::RemoveAtDense(int32 DenseIndex)
+{
+	const uint64 removedKey = EntityKeys[DenseIndex];
+	RemoveBucket(FindBucket(removedKey));
+
+	const int32 removedSlot = DenseToSlot[DenseIndex];
+	SlotGenerations[removedSlot]++;
+	SlotToDense[removedSlot] = INDEX_NONE;
+	FreeSlots.Add(removedSlot);
+
+	//Move the last entity into the removed entity's place and repoint its bucket and slot
+	const int32 lastIndex = EntityKeys.Num() - 1;
+	if (DenseIndex != lastIndex)
+	{
+		const uint64 movedKey = EntityKeys[lastIndex];
+		BucketDenseIndices[FindBucket(movedKey)] = DenseIndex;
+		SlotToDense[DenseToSlot[lastIndex]] = DenseIndex;
+	}
+
+	EntityKeys.RemoveAtSwap(DenseIndex, 1, false);
+	EntityIDs.RemoveAtSwap(DenseIndex, 1, false);
+	Actors.RemoveAtSwap(DenseIndex, 1, false);
+	Components.RemoveAtSwap(DenseIndex, 1, false);
+	DenseToSlot.RemoveAtSwap(DenseIndex, 1, false);
+	ReceivedEntityStates.RemoveAtSwap(DenseIndex, 1, false);
+	DeadReckonedEntityStates.RemoveAtSwap(DenseIndex, 1, false);
+	DeadReckoningParameters.RemoveAtSwap(DenseIndex, 1, false);
+	DeadReckoningKernels.RemoveAtSwap(DenseIndex, 1, false);
+	ProxyInstances.RemoveAtSwap(DenseIndex, 1, false);
+	InterpolationBuffers.RemoveAtSwap(DenseIndex, 1, false);
+}
+
+void FDISEntityRegistry::UpdateDeadReckoning(float DeltaTime, TArrayView<const FVector> ViewpointECEFLocations, const FDISDeadReckoningLODSettings* LODSettings, bool bAllowDormancy, float InterpolationDelay)
+{
+	const bool bUseLOD = LODSettings != nullptr && LODSettings->Num() > 0;
+
+	CurrentTime += DeltaTime;
+	const double interpolationTime = CurrentTime - InterpolationDelay;
+
+	ParallelFor(EntityIDs.Num(), [this, DeltaTime, ViewpointECEFLocations, LODSettings, bUseLOD, bAllowDormancy, InterpolationDelay, interpolationTime](int32 DenseIndex)
+	{
+		FDISDeadReckoningParameters& parameters = DeadReckoningParameters[DenseIndex];
+		parameters.TimeSinceLastUpdate += DeltaTime;
+		parameters.TimeSinceLODUpdate += DeltaTime;
+		parameters.bCulled = false;
+		parameters.bUpdated = false;
+		parameters.bSkippedByLOD = false;
+		parameters.bSkippedWhileDormant = false;
+
+		//Dormant entities already show the only pose their dead reckoning can produce
+		if (parameters.bDormant && bAllowDormancy)
+		{
+			parameters.bSkippedWhileDormant = true;
+			return;
+		}
+		parameters.bDormant = false;
+
+		if (!parameters.bPerformDeadReckoning)
+		{
+			return;
+		}
+
+		//Distance to the closest viewpoint drives both culling and distance based level of detail.
+		//It is measured from the last dead reckoned location, so entities without an actor are tiered the same way as those with one.
+		const bool bUseDistanceLOD = bUseLOD && parameters.SignificanceLODTier == INDEX_NONE;
+		float closestViewpointDistanceSquared = 0;
+		if ((parameters.bCullDeadReckoning || bUseDistanceLOD) && ViewpointECEFLocations.Num() > 0)
+		{
+			const double* entityLocation = DeadReckonedEntityStates[DenseIndex].EntityLocation;
+
+			double closestDistanceSquaredMeters = TNumericLimits<double>::Max();
+			for (const FVector& viewpointECEFLocation : ViewpointECEFLocations)
+			{
+				const double deltaX = entityLocation[0] - viewpointECEFLocation.X;
+				const double deltaY = entityLocation[1] - viewpointECEFLocation.Y;
+				const double deltaZ = entityLocation[2] - viewpointECEFLocation.Z;
+				closestDistanceSquaredMeters = FMath::Min(closestDistanceSquaredMeters, deltaX * deltaX + deltaY * deltaY + deltaZ * deltaZ);
+			}
+
+			//Culling and tier distances are in Unreal units
+			closestViewpointDistanceSquared = static_cast<float>(FMath::Min(closestDistanceSquaredMeters * 10000.0, double(TNumericLimits<float>::Max())));
+
+			//Skip entities that are further than the culling distance from every viewpoint
+			if (parameters.bCullDeadReckoning && closestViewpointDistanceSquared > FMath::Square(parameters.CullingDistance))
+			{
+				parameters.bCulled = true;
+				return;
+			}
+		}
+
+		parameters.LODTier = 0;
+		if (bUseLOD)
+		{
+			parameters.LODTier = bUseDistanceLOD ? LODSettings->GetTier(closestViewpointDistanceSquared) : FMath::Clamp(parameters.SignificanceLODTier, 0, LODSettings->Num() - 1);
+
+			if (!parameters.bForceLODUpdate && parameters.TimeSinceLODUpdate < LODSettings->UpdateIntervals[parameters.LODTier])
+			{
+				parameters.bSkippedByLOD = true;
+				return;
+			}
+		}
+		parameters.TimeSinceLODUpdate = 0;
+		parameters.bForceLODUpdate = false;
+
+		FDISEntityState& deadReckonedEntityState = DeadReckonedEntityStates[DenseIndex];
+		if (InterpolationDelay > 0)
+		{
+			//Interpolate between received states while the buffer reaches the interpolation time, and dead reckon past the newest state once it runs dry
+			if (InterpolationBuffers[DenseIndex].Interpolate(interpolationTime, deadReckonedEntityState))
+			{
+				parameters.bUpdated = true;
+			}
+			else
+			{
+				parameters.bUpdated = DeadReckoningKernels[DenseIndex].Evaluate(FMath::Max(parameters.TimeSinceLastUpdate - InterpolationDelay, 0.0f), deadReckonedEntityState);
+				parameters.bDormant = bAllowDormancy && DeadReckoningKernels[DenseIndex].IsStationary();
+			}
+			return;
+		}
+
+		parameters.bUpdated = DeadReckoningKernels[DenseIndex].Evaluate(parameters.TimeSinceLastUpdate, deadReckonedEntityState);
+
+		const bool bSmoothing = parameters.bUpdated && parameters.bPerformSmoothing && parameters.TimeSinceLastUpdate <= parameters.SmoothingPeriodSeconds;
+		if (bSmoothing)
+		{
+			parameters.Smooth(deadReckonedEntityState);
+		}
+
+		//Stationary entities sleep from the next update on, once this pose has been applied and any smoothing has settled
+		parameters.bDormant = bAllowDormancy && !bSmoothing && DeadReckoningKernels[DenseIndex].IsStationary();
+	}, EntityIDs.Num() < MIN_PARALLEL_DEAD_RECKONING_ENTITIES);
+}
+
+void FDISDeadReckoningParameters::Smooth(FDISEntityState& DeadReckonedEntityState) const
+{
+	const float alpha = FMath::GetMappedRangeValueClamped(FVector2D(0.0f, SmoothingPeriodSeconds), FVector2D(0.0f, 1.0f), TimeSinceLastUpdate);
+
+	DeadReckonedEntityState.EntityLocation[0] -= FMath::Lerp(SmoothingLocationOffset[0], 0., alpha);
+	DeadReckonedEntityState.EntityLocation[1] -= FMath::Lerp(SmoothingLocationOffset[1], 0., alpha);
+	DeadReckonedEntityState.EntityLocation[2] -= FMath::Lerp(SmoothingLocationOffset[2], 0., alpha);
+
+	DeadReckonedEntityState.EntityOrientation -= FMath::Lerp(SmoothingRotationOffset, FRotator(0, 0, 0), alpha);
+}
+
+void FDISInterpolationBuffer::Push(const FDISEntityState& EntityState, double Time)
+{
+	if (Count > 0 && Time < GetSample(Count - 1).Time)
+	{
+		return;
+	}
+
+	FSample* sample;
+	if (Count < CAPACITY)
+	{
+		sample = &Samples[(First + Count) % CAPACITY];
+		Count++;
+	}
+	else
+	{
+		sample = &Samples[First];
+		First = (First + 1) % CAPACITY;
+	}
+
+	sample->Time = Time;
+	sample->Location[0] = EntityState.EntityLocation[0];
+	sample->Location[1] = EntityState.EntityLocation[1];
+	sample->Location[2] = EntityState.EntityLocation[2];
+	sample->Orientation = FMath::RadiansToDegrees(EntityState.EntityOrientation).Quaternion();
+	sample->LinearVelocity = EntityState.EntityLinearVelocity;
+}
+
+bool FDISInterpolationBuffer::Interpolate(double Time, FDISEntityState& OutEntityState) const
+{
+	if (Count == 0 || Time > GetSample(Count - 1).Time)
+	{
+		return false;
+	}
+
+	//Find the newest sample at or before the time, holding the oldest sample if the time is before all of them
+	int32 fromIndex = Count - 1;
+	while (fromIndex > 0 && GetSample(fromIndex).Time > Time)
+	{
+		fromIndex--;
+	}
+
+	const FSample& from = GetSample(fromIndex);
+	const FSample& to = GetSample(FMath::Min(fromIndex + 1, Count - 1));
+	const double interval = to.Time - from.Time;
+	const double alpha = interval > 0 ? FMath::Clamp((Time - from.Time) / interval, 0.0, 1.0) : 0.0;
+
+	OutEntityState.EntityLocation[0] = FMath::Lerp(from.Location[0], to.Location[0], alpha);
+	OutEntityState.EntityLocation[1] = FMath::Lerp(from.Location[1], to.Location[1], alpha);
+	OutEntityState.EntityLocation[2] = FMath::Lerp(from.Location[2], to.Location[2], alpha);
+	OutEntityState.EntityOrientation = FMath::DegreesToRadians(FQuat::Slerp(from.Orientation, to.Orientation, static_cast<float>(alpha)).Rotator());
+	OutEntityState.EntityLinearVelocity = FMath::Lerp(from.LinearVelocity, to.LinearVelocity, static_cast<float>(alpha));
+
+	return true;
+}
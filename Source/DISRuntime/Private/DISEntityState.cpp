@@ -0,0 +1,234 @@
+// Copyright 2022 Gaming Research Integration for Learning Lab. All Rights Reserved.
+
+#include "DISEntityState.h"
+
+uint8 FDISEntityState::FromEntityStatePDU(const FEntityStatePDU& EntityStatePDUIn)
+{
+	uint8 changes = 0;
+
+	ProtocolVersion = EntityStatePDUIn.ProtocolVersion;
+	ExerciseID = EntityStatePDUIn.ExerciseID;
+	ProtocolFamily = EntityStatePDUIn.ProtocolFamily;
+	Timestamp = EntityStatePDUIn.Timestamp;
+	Length = EntityStatePDUIn.Length;
+	Padding = EntityStatePDUIn.Padding;
+
+	EntityID = EntityStatePDUIn.EntityID;
+	if (ForceID != EntityStatePDUIn.ForceID)
+	{
+		ForceID = EntityStatePDUIn.ForceID;
+		changes |= CHANGED_FORCE_ID;
+	}
+	if (EntityType != EntityStatePDUIn.EntityType || AlternativeEntityType != EntityStatePDUIn.AlternativeEntityType)
+	{
+		EntityType = EntityStatePDUIn.EntityType;
+		AlternativeEntityType = EntityStatePDUIn.AlternativeEntityType;
+		changes |= CHANGED_ENTITY_TYPE;
+	}
+
+	for (int i = 0; i < 3; i++)
+	{
+		EntityLocation[i] = EntityStatePDUIn.EntityLocationDouble.IsValidIndex(i) ? EntityStatePDUIn.EntityLocationDouble[i] : EntityStatePDUIn.EntityLocation[i];
+	}
+	EntityOrientation = EntityStatePDUIn.EntityOrientation;
+	EntityLinearVelocity = EntityStatePDUIn.EntityLinearVelocity;
+
+	DeadReckoningAlgorithm = EntityStatePDUIn.DeadReckoningParameters.DeadReckoningAlgorithm;
+	SetOtherDeadReckoningParameters(EntityStatePDUIn.DeadReckoningParameters.OtherParameters);
+	EntityLinearAcceleration = EntityStatePDUIn.DeadReckoningParameters.EntityLinearAcceleration;
+	EntityAngularVelocity = EntityStatePDUIn.DeadReckoningParameters.EntityAngularVelocity;
+
+	if (EntityAppearance.RawVal != EntityStatePDUIn.EntityAppearance.RawVal)
+	{
+		EntityAppearance = EntityStatePDUIn.EntityAppearance;
+		changes |= CHANGED_APPEARANCE;
+	}
+	if (Capabilities != EntityStatePDUIn.Capabilities)
+	{
+		Capabilities = EntityStatePDUIn.Capabilities;
+		changes |= CHANGED_CAPABILITIES;
+	}
+	if (!IsMarkingEqual(EntityStatePDUIn.Marking))
+	{
+		SetMarking(EntityStatePDUIn.Marking);
+		changes |= CHANGED_MARKING;
+	}
+
+	changes |= UpdateArticulationParameters(EntityStatePDUIn.ArticulationParameters);
+
+	return changes;
+}
+
+uint8 FDISEntityState::ApplyEntityStateUpdatePDU(const FEntityStateUpdatePDU& EntityStateUpdatePDUIn)
+{
+	uint8 changes = 0;
+
+	ProtocolVersion = EntityStateUpdatePDUIn.ProtocolVersion;
+	ExerciseID = EntityStateUpdatePDUIn.ExerciseID;
+	ProtocolFamily = EntityStateUpdatePDUIn.ProtocolFamily;
+	Timestamp = EntityStateUpdatePDUIn.Timestamp;
+	Length = EntityStateUpdatePDUIn.Length;
+	Padding = EntityStateUpdatePDUIn.Padding;
+
+	EntityID = EntityStateUpdatePDUIn.EntityID;
+	for (int i = 0; i < 3; i++)
+	{
+		EntityLocation[i] = EntityStateUpdatePDUIn.EntityLocationDouble.IsValidIndex(i) ? EntityStateUpdatePDUIn.EntityLocationDouble[i] : EntityStateUpdatePDUIn.EntityLocation[i];
+	}
+	EntityOrientation = EntityStateUpdatePDUIn.EntityOrientation;
+	EntityLinearVelocity = EntityStateUpdatePDUIn.EntityLinearVelocity;
+
+	if (EntityAppearance.RawVal != EntityStateUpdatePDUIn.EntityAppearance.RawVal)
+	{
+		EntityAppearance = EntityStateUpdatePDUIn.EntityAppearance;
+		changes |= CHANGED_APPEARANCE;
+	}
+
+	changes |= UpdateArticulationParameters(EntityStateUpdatePDUIn.ArticulationParameters);
+
+	return changes;
+}
+
+void FDISEntityState::ToEntityStatePDU(FEntityStatePDU& EntityStatePDUOut) const
+{
+	EntityStatePDUOut.ProtocolVersion = ProtocolVersion;
+	EntityStatePDUOut.ExerciseID = ExerciseID;
+	EntityStatePDUOut.ProtocolFamily = ProtocolFamily;
+	EntityStatePDUOut.Timestamp = Timestamp;
+	EntityStatePDUOut.Length = Length;
+	EntityStatePDUOut.Padding = Padding;
+
+	EntityStatePDUOut.EntityID = EntityID;
+	EntityStatePDUOut.ForceID = ForceID;
+	EntityStatePDUOut.EntityType = EntityType;
+	EntityStatePDUOut.AlternativeEntityType = AlternativeEntityType;
+
+	CopyKinematicsToEntityStatePDU(EntityStatePDUOut);
+
+	EntityStatePDUOut.DeadReckoningParameters.DeadReckoningAlgorithm = DeadReckoningAlgorithm;
+	EntityStatePDUOut.DeadReckoningParameters.OtherParameters.SetNumUninitialized(OTHER_PARAMETERS_BYTES);
+	FMemory::Memcpy(EntityStatePDUOut.DeadReckoningParameters.OtherParameters.GetData(), OtherDeadReckoningParameters, OTHER_PARAMETERS_BYTES);
+	EntityStatePDUOut.DeadReckoningParameters.EntityLinearAcceleration = EntityLinearAcceleration;
+	EntityStatePDUOut.DeadReckoningParameters.EntityAngularVelocity = EntityAngularVelocity;
+
+	EntityStatePDUOut.EntityAppearance = EntityAppearance;
+	EntityStatePDUOut.Capabilities = Capabilities;
+	EntityStatePDUOut.Marking = GetMarking();
+
+	EntityStatePDUOut.ArticulationParameters.Reset();
+	EntityStatePDUOut.ArticulationParameters.Append(ArticulationParameters);
+}
+
+FEntityStatePDU FDISEntityState::ToEntityStatePDU() const
+{
+	FEntityStatePDU entityStatePDU;
+	ToEntityStatePDU(entityStatePDU);
+	return entityStatePDU;
+}
+
+void FDISEntityState::CopyKinematicsToEntityStatePDU(FEntityStatePDU& EntityStatePDUOut) const
+{
+	EntityStatePDUOut.EntityLocationDouble.SetNumUninitialized(3);
+	for (int i = 0; i < 3; i++)
+	{
+		EntityStatePDUOut.EntityLocationDouble[i] = EntityLocation[i];
+		EntityStatePDUOut.EntityLocation[i] = EntityLocation[i];
+	}
+	EntityStatePDUOut.EntityOrientation = EntityOrientation;
+	EntityStatePDUOut.EntityLinearVelocity = EntityLinearVelocity;
+}
+
+void FDISEntityState::CopyKinematicsFrom(const FDISEntityState& EntityStateIn)
+{
+	EntityLocation[0] = EntityStateIn.EntityLocation[0];
+	EntityLocation[1] = EntityStateIn.EntityLocation[1];
+	EntityLocation[2] = EntityStateIn.EntityLocation[2];
+	EntityOrientation = EntityStateIn.EntityOrientation;
+	EntityLinearVelocity = EntityStateIn.EntityLinearVelocity;
+}
+
+FString FDISEntityState::GetMarking() const
+{
+	return FString(ANSI_TO_TCHAR(Marking));
+}
+
+void FDISEntityState::SetMarking(const FString& MarkingIn)
+{
+	SetMarking(TCHAR_TO_ANSI(*MarkingIn.Left(MARKING_CHARACTERS)));
+}
+
+void FDISEntityState::SetMarking(const ANSICHAR* MarkingIn)
+{
+	FCStringAnsi::Strncpy(Marking, MarkingIn, MARKING_CHARACTERS + 1);
+}
+
+void FDISEntityState::SetOtherDeadReckoningParameters(const TArray<uint8>& OtherParametersIn)
+{
+	const int32 bytesToCopy = FMath::Min(OtherParametersIn.Num(), OTHER_PARAMETERS_BYTES);
+	FMemory::Memcpy(OtherDeadReckoningParameters, OtherParametersIn.GetData(), bytesToCopy);
+	FMemory::Memzero(OtherDeadReckoningParameters + bytesToCopy, OTHER_PARAMETERS_BYTES - bytesToCopy);
+}
+
+uint32 FDISEntityState::HashArticulationParameters(TArrayView<const FArticulationParameters> ArticulationParametersIn)
+{
+	uint32 hash = 0;
+	for (const FArticulationParameters& articulationParameter : ArticulationParametersIn)
+	{
+		hash = HashCombine(hash, ::GetTypeHash(articulationParameter.ParameterTypeDesignator));
+		hash = HashCombine(hash, ::GetTypeHash(articulationParameter.ChangeIndicator));
+		hash = HashCombine(hash, ::GetTypeHash(articulationParameter.PartAttachedTo));
+		hash = HashCombine(hash, ::GetTypeHash(articulationParameter.ParameterType));
+		hash = HashCombine(hash, ::GetTypeHash(articulationParameter.ParameterValue));
+		hash = HashCombine(hash, GetTypeHash(articulationParameter.AttachedPartType));
+	}
+	return hash;
+}
+
+bool FDISEntityState::IsMarkingEqual(const FString& MarkingIn) const
+{
+	const int32 length = FMath::Min(MarkingIn.Len(), MARKING_CHARACTERS);
+	for (int32 i = 0; i < length; i++)
+	{
+		if (Marking[i] != static_cast<ANSICHAR>(MarkingIn[i]))
+		{
+			return false;
+		}
+	}
+	return Marking[length] == '\0';
+}
+
+bool FDISEntityState::AreArticulationParametersEqual(TArrayView<const FArticulationParameters> ArticulationParametersIn) const
+{
+	if (ArticulationParametersIn.Num() != ArticulationParameters.Num())
+	{
+		return false;
+	}
+
+	for (int32 i = 0; i < ArticulationParametersIn.Num(); i++)
+	{
+		const FArticulationParameters& received = ArticulationParametersIn[i];
+		const FArticulationParameters& stored = ArticulationParameters[i];
+		if (received.ParameterTypeDesignator != stored.ParameterTypeDesignator || received.ChangeIndicator != stored.ChangeIndicator
+			|| received.PartAttachedTo != stored.PartAttachedTo || received.ParameterType != stored.ParameterType
+			|| received.ParameterValue != stored.ParameterValue || received.AttachedPartType != stored.AttachedPartType)
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+uint8 FDISEntityState::UpdateArticulationParameters(TArrayView<const FArticulationParameters> ArticulationParametersIn)
+{
+	const uint32 hash = HashArticulationParameters(ArticulationParametersIn);
+	//The hash only rules out changes cheaply, a match is confirmed field by field so that colliding hashes cannot hide a change
+	if (hash == ArticulationHash && AreArticulationParametersEqual(ArticulationParametersIn))
+	{
+		return 0;
+	}
+
+	ArticulationParameters.Reset();
+	ArticulationParameters.Append(ArticulationParametersIn.GetData(), ArticulationParametersIn.Num());
+	ArticulationHash = hash;
+	return CHANGED_ARTICULATION;
+}
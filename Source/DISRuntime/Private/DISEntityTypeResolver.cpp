@@ -0,0 +1,154 @@
+// Copyright 2022 Gaming Research Integration for Learning Lab. All Rights Reserved.
+
+#include "DISEntityTypeResolver.h"
+#include "DISClassEnumMappings.h"
+
+DEFINE_LOG_CATEGORY(LogDISEntityTypeResolver);
+
+FDISEntityTypeResolver::FDISEntityTypeResolver()
+{
+	Reset();
+}
+
+int32 FDISEntityTypeResolver::Compile(const UDISClassEnumMappings* ClassEnumMappings)
+{
+	Reset();
+
+	if (!ClassEnumMappings)
+	{
+		return 0;
+	}
+
+	for (const FDISClassEnumStruct& DISMapping : ClassEnumMappings->DISClassEnumArray)
+	{
+		for (const FEntityType& EntityType : DISMapping.AssociatedDISEnumerations)
+		{
+			AddMapping(EntityType, DISMapping.DISEntity, DISMapping.ProxyMesh);
+		}
+	}
+
+	return MappedClasses.Num();
+}
+
+bool FDISEntityTypeResolver::AddMapping(const FEntityType& EntityType, const TSoftClassPtr<AActor>& ActorClass, const TSoftObjectPtr<UStaticMesh>& ProxyMesh)
+{
+	int32 fields[NUMBER_OF_FIELDS];
+	GetFields(EntityType, fields);
+
+	int32 nodeIndex = 0;
+	for (int32 depth = 0; depth < NUMBER_OF_FIELDS; depth++)
+	{
+		const bool bIsWildcard = fields[depth] == -1;
+		int32 childIndex = Nodes[nodeIndex].WildcardChild;
+		if (!bIsWildcard)
+		{
+			const int32* exactChild = Nodes[nodeIndex].ExactChildren.Find(fields[depth]);
+			childIndex = exactChild ? *exactChild : INDEX_NONE;
+		}
+
+		if (childIndex == INDEX_NONE)
+		{
+			//Adding a node may reallocate the node array, so look the parent back up afterwards
+			childIndex = Nodes.AddDefaulted();
+			if (bIsWildcard)
+			{
+				Nodes[nodeIndex].WildcardChild = childIndex;
+			}
+			else
+			{
+				Nodes[nodeIndex].ExactChildren.Add(fields[depth], childIndex);
+			}
+		}
+
+		nodeIndex = childIndex;
+	}
+
+	//New mappings invalidate every previously cached resolution
+	ResolutionCache.Reset();
+
+	FNode& leaf = Nodes[nodeIndex];
+	if (leaf.MappingIndex != INDEX_NONE)
+	{
+		UE_LOG(LogDISEntityTypeResolver, Warning, TEXT("A DIS Enumeration mapping already exists for %s and is linked to %s. This enumeration will now point to: %s"), *EntityType.ToString(), *MappedClasses[leaf.MappingIndex].GetAssetName(), *ActorClass.GetAssetName());
+		MappedClasses[leaf.MappingIndex] = ActorClass;
+		MappedProxyMeshes[leaf.MappingIndex] = ProxyMesh;
+		return true;
+	}
+
+	leaf.MappingIndex = MappedClasses.Add(ActorClass);
+	MappedProxyMeshes.Add(ProxyMesh);
+	return false;
+}
+
+void FDISEntityTypeResolver::Reset()
+{
+	Nodes.Reset();
+	Nodes.AddDefaulted();
+	MappedClasses.Reset();
+	MappedProxyMeshes.Reset();
+	ResolutionCache.Reset();
+	CacheHits = 0;
+	CacheMisses = 0;
+}
+
+int32 FDISEntityTypeResolver::ResolveMappingIndex(const FEntityType& EntityType, bool& bOutWasCached)
+{
+	const uint64 packedEntityType = EntityType.ToUInt64();
+
+	int32 mappingIndex;
+	if (const int32* cachedMappingIndex = ResolutionCache.Find(packedEntityType))
+	{
+		CacheHits++;
+		bOutWasCached = true;
+		mappingIndex = *cachedMappingIndex;
+	}
+	else
+	{
+		CacheMisses++;
+		bOutWasCached = false;
+
+		int32 fields[NUMBER_OF_FIELDS];
+		GetFields(EntityType, fields);
+		mappingIndex = FindMapping(0, fields, 0);
+		ResolutionCache.Add(packedEntityType, mappingIndex);
+	}
+
+	return mappingIndex;
+}
+
+void FDISEntityTypeResolver::GetFields(const FEntityType& EntityType, int32 OutFields[NUMBER_OF_FIELDS])
+{
+	OutFields[0] = EntityType.EntityKind;
+	OutFields[1] = EntityType.Domain;
+	OutFields[2] = EntityType.Country;
+	OutFields[3] = EntityType.Category;
+	OutFields[4] = EntityType.Subcategory;
+	OutFields[5] = EntityType.Specific;
+	OutFields[6] = EntityType.Extra;
+}
+
+int32 FDISEntityTypeResolver::FindMapping(int32 NodeIndex, const int32 Fields[NUMBER_OF_FIELDS], int32 Depth) const
+{
+	const FNode& node = Nodes[NodeIndex];
+	if (Depth == NUMBER_OF_FIELDS)
+	{
+		return node.MappingIndex;
+	}
+
+	//Prefer the exact match, falling back to the wildcard if nothing under the exact match resolves
+	if (const int32* exactChild = node.ExactChildren.Find(Fields[Depth]))
+	{
+		const int32 mappingIndex = FindMapping(*exactChild, Fields, Depth + 1);
+		if (mappingIndex != INDEX_NONE)
+		{
+			return mappingIndex;
+		}
+	}
+
+	if (node.WildcardChild != INDEX_NONE)
+	{
+		return FindMapping(node.WildcardChild, Fields, Depth + 1);
+	}
+
+	return INDEX_NONE;
+}
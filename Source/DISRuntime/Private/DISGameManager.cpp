@@ -5,12 +5,29 @@
 #include "DIS_BPFL.h"
 #include "Engine/Engine.h"
 #include "PDUProcessor.h"
+#include "DISPoolableInterface.h"
+#include "Async/ParallelFor.h"
+#include "GameFramework/PlayerController.h"
+#include "SignificanceManager.h"
+#include "Components/PrimitiveComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "glm/common.hpp"
 
 DEFINE_LOG_CATEGORY(LogDISGameManager);
 
+const FName ADISGameManager::SIGNIFICANCE_TAG = TEXT("DISEntity");
+
 ADISGameManager::ADISGameManager() 
 {
 	PrimaryActorTick.bCanEverTick = true;	
+
+	EntityTransformTickFunction.bCanEverTick = true;
+	EntityTransformTickFunction.bStartWithTickEnabled = true;
+
+	DeadReckoningLODTiers.Add(FDISDeadReckoningLODTier(100000.0f, 0.0f));
+	DeadReckoningLODTiers.Add(FDISDeadReckoningLODTier(500000.0f, 10.0f));
+	DeadReckoningLODTiers.Add(FDISDeadReckoningLODTier(2000000.0f, 1.0f));
 }
 
 ADISGameManager* ADISGameManager::GetDISGameManager(UObject* WorldContextObject)
@@ -39,22 +56,42 @@ ADISGameManager* ADISGameManager::GetDISGameManager(UObject* WorldContextObject)
 	return Actor;
 }
 
+void FDISEntityTransformTickFunction::ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent)
+{
+	if (IsValid(Target))
+	{
+		Target->ApplyQueuedEntityTransforms();
+	}
+}
+
+FString FDISEntityTransformTickFunction::DiagnosticMessage()
+{
+	return (Target ? Target->GetFullName() : TEXT("<NULL>")) + TEXT("[ApplyQueuedEntityTransforms]");
+}
+
 // Called when the game starts
 void ADISGameManager::BeginPlay()
 {
 	Super::BeginPlay();
 
-	GetGameInstance()->GetSubsystem<UPDUProcessor>()->OnEntityStatePDUProcessed.AddDynamic(this, &ADISGameManager::HandleEntityStatePDU);
-	GetGameInstance()->GetSubsystem<UPDUProcessor>()->OnEntityStateUpdatePDUProcessed.AddDynamic(this, &ADISGameManager::HandleEntityStateUpdatePDU);
-	GetGameInstance()->GetSubsystem<UPDUProcessor>()->OnFirePDUProcessed.AddDynamic(this, &ADISGameManager::HandleFirePDU);
-	GetGameInstance()->GetSubsystem<UPDUProcessor>()->OnDetonationPDUProcessed.AddDynamic(this, &ADISGameManager::HandleDetonationPDU);
-	GetGameInstance()->GetSubsystem<UPDUProcessor>()->OnRemoveEntityPDUProcessed.AddDynamic(this, &ADISGameManager::HandleRemoveEntityPDU);
-	GetGameInstance()->GetSubsystem<UPDUProcessor>()->OnStopFreezePDUProcessed.AddDynamic(this, &ADISGameManager::HandleStopFreezePDU);
-	GetGameInstance()->GetSubsystem<UPDUProcessor>()->OnStartResumePDUProcessed.AddDynamic(this, &ADISGameManager::HandleStartResumePDU);
-	GetGameInstance()->GetSubsystem<UPDUProcessor>()->OnElectromagneticEmissionsPDUProcessed.AddDynamic(this, &ADISGameManager::HandleElectromagneticEmissionsPDU);
+	UPDUProcessor* PDUProcessor = GetGameInstance()->GetSubsystem<UPDUProcessor>();
+	PDUProcessor->OnEntityStatePDUProcessedNative.AddUObject(this, &ADISGameManager::HandleEntityStatePDU);
+	PDUProcessor->OnEntityStateUpdatePDUProcessedNative.AddUObject(this, &ADISGameManager::HandleEntityStateUpdatePDU);
+	PDUProcessor->OnFirePDUProcessedNative.AddUObject(this, &ADISGameManager::HandleFirePDU);
+	PDUProcessor->OnDetonationPDUProcessedNative.AddUObject(this, &ADISGameManager::HandleDetonationPDU);
+	PDUProcessor->OnRemoveEntityPDUProcessedNative.AddUObject(this, &ADISGameManager::HandleRemoveEntityPDU);
+	PDUProcessor->OnStopFreezePDUProcessedNative.AddUObject(this, &ADISGameManager::HandleStopFreezePDU);
+	PDUProcessor->OnStartResumePDUProcessedNative.AddUObject(this, &ADISGameManager::HandleStartResumePDU);
+	PDUProcessor->OnElectromagneticEmissionsPDUProcessedNative.AddUObject(this, &ADISGameManager::HandleElectromagneticEmissionsPDU);
 
 	GeoReferencingSystem = AGeoReferencingSystem::GetGeoReferencingSystem(Cast<UObject>(GetWorld()));
 
+	EntitySpatialIndex.SetCellSize(SpatialIndexCellSizeMeters);
+
+	UpdateAreaOfInterest();
+	UpdateDeadReckoningLODSettings();
+	TimestampClock.SetMaxAge(MaxTimestampCompensationSeconds);
+
 	//Auto connect sockets if needed
 	if (AutoConnectReceiveAddresses) 
 	{
@@ -75,53 +112,463 @@ void ADISGameManager::BeginPlay()
 
 	if (DISClassEnum) 
 	{
-		//Initialize DISClassMappings from the loaded settings
-		for (FDISClassEnumStruct DISMapping : DISClassEnum->DISClassEnumArray)
+		//Compile the loaded settings into the entity type resolver -- Duplicate mappings are reported by the resolver
+		EntityTypeResolver.Compile(DISClassEnum);
+
+		//Headless entities only load their class when they are materialized
+		if (LoadEntityClassesAsynchronously && PreloadEntityClasses && !EnableHeadlessMode)
 		{
-			for (FEntityType EntityType : DISMapping.AssociatedDISEnumerations)
-			{
-				//Check to see if there is an associated actor for the entity type already
-				TSoftClassPtr<AActor>* associatedSoftClassReference = DISClassMappings.Find(EntityType);
+			PreloadMappedEntityClasses();
+		}
 
-				if (associatedSoftClassReference != nullptr)
+		if (EnableActorPooling && !EnableHeadlessMode)
+		{
+			PrewarmConfiguredActorPools();
+		}
+
+		if (EnableProxyEntities && !EnableHeadlessMode)
+		{
+			//Entities of types whose proxy mesh is still loading are spawned as actors in the meantime
+			for (const TSoftObjectPtr<UStaticMesh>& proxyMesh : EntityTypeResolver.GetMappedProxyMeshes())
+			{
+				const FSoftObjectPath proxyMeshPath = proxyMesh.ToSoftObjectPath();
+				if (!proxyMeshPath.IsNull() && !ProxyMeshLoadHandles.Contains(proxyMeshPath))
 				{
-					UE_LOG(LogDISGameManager, Warning, TEXT("A DIS Enumeration mapping already exists for %s and is linked to %s. This enumeration will now point to: %s"), *EntityType.ToString(), *associatedSoftClassReference->GetAssetName(), *DISMapping.DISEntity.GetAssetName());
+					ProxyMeshLoadHandles.Add(proxyMeshPath, StreamableManager.RequestAsyncLoad(proxyMeshPath));
 				}
+			}
 
-				DISClassMappings.Add(EntityType, DISMapping.DISEntity);
-				RawDISClassMappings.insert_or_assign(EntityType, DISMapping.DISEntity);
+			if (!IsValid(GeoReferencingSystem))
+			{
+				UE_LOG(LogDISGameManager, Warning, TEXT("EnableProxyEntities is set but there is no GeoReferencing System in the level. Entities will not be drawn as proxies."));
 			}
 		}
 	}
-	else
+	else if (!EnableHeadlessMode)
 	{
 		UE_LOG(LogDISGameManager, Error, TEXT("No DIS Class Enum Mapping has been set within the DIS Game Manager actor!"));
 	}
 }
 
+void ADISGameManager::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	//Unbind from the PDU Processor so that PDU types without any other listeners stop being decoded
+	UGameInstance* GameInstance = GetGameInstance();
+	UPDUProcessor* PDUProcessor = GameInstance ? GameInstance->GetSubsystem<UPDUProcessor>() : nullptr;
+	if (PDUProcessor)
+	{
+		PDUProcessor->OnEntityStatePDUProcessedNative.RemoveAll(this);
+		PDUProcessor->OnEntityStateUpdatePDUProcessedNative.RemoveAll(this);
+		PDUProcessor->OnFirePDUProcessedNative.RemoveAll(this);
+		PDUProcessor->OnDetonationPDUProcessedNative.RemoveAll(this);
+		PDUProcessor->OnRemoveEntityPDUProcessedNative.RemoveAll(this);
+		PDUProcessor->OnStopFreezePDUProcessedNative.RemoveAll(this);
+		PDUProcessor->OnStartResumePDUProcessedNative.RemoveAll(this);
+		PDUProcessor->OnElectromagneticEmissionsPDUProcessedNative.RemoveAll(this);
+	}
+
+	//Stop any entity class loads that are still in progress
+	for (TPair<FSoftObjectPath, TSharedPtr<FStreamableHandle>>& EntityClassLoadHandle : EntityClassLoadHandles)
+	{
+		if (EntityClassLoadHandle.Value.IsValid())
+		{
+			EntityClassLoadHandle.Value->CancelHandle();
+		}
+	}
+	for (TSharedPtr<FStreamableHandle>& prewarmLoadHandle : ActorPoolPrewarmLoadHandles)
+	{
+		if (prewarmLoadHandle.IsValid())
+		{
+			prewarmLoadHandle->CancelHandle();
+		}
+	}
+	for (TPair<FSoftObjectPath, TSharedPtr<FStreamableHandle>>& proxyMeshLoadHandle : ProxyMeshLoadHandles)
+	{
+		if (proxyMeshLoadHandle.Value.IsValid())
+		{
+			proxyMeshLoadHandle.Value->CancelHandle();
+		}
+	}
+	if (IsValid(ProxyMeshActor))
+	{
+		ProxyMeshActor->Destroy();
+	}
+	if (AreaOfInterest.IsValid())
+	{
+		SetAreaOfInterestPacketFilters(false);
+		AreaOfInterest.Reset();
+	}
+
+	if (UseSignificanceManager)
+	{
+		if (USignificanceManager* significanceManager = USignificanceManager::Get(GetWorld()))
+		{
+			significanceManager->UnregisterAll(SIGNIFICANCE_TAG);
+		}
+	}
+
+	EntityClassLoadHandles.Empty();
+	ActorPoolPrewarmLoadHandles.Empty();
+	PendingEntitySpawns.Empty();
+	ActorPools.Empty();
+	ProxyMeshLoadHandles.Empty();
+	ProxyMeshBatches.Empty();
+	ProxyMeshBatchIndices.Empty();
+	ProxyMeshActor = nullptr;
+	NumProxyEntities = 0;
+	EntityTimeouts.Reset();
+	EntitySpatialIndex.Reset();
+	QueuedEntityTransforms.Empty();
+	TimestampClock.Reset();
+
+	Super::EndPlay(EndPlayReason);
+}
+
 void ADISGameManager::Tick(float DeltaTime)
 {
 	Super::Tick(DeltaTime);
 
-	for (std::pair<FEntityID, AActor*> DisEntity : RawDISActorMappings)
+	if (AreaOfInterest.IsValid())
+	{
+		if (AreaOfInterestViewpointRadius > 0)
+		{
+			TArray<FVector, TInlineAllocator<4>> viewpointECEFLocations;
+			GetViewpointECEFLocations(viewpointECEFLocations);
+			AreaOfInterest->SetViewpoints(viewpointECEFLocations);
+		}
+
+		TimeSinceOutOfAreaEntitiesPruned += DeltaTime;
+		if (TimeSinceOutOfAreaEntitiesPruned >= 1.0f)
+		{
+			AreaOfInterest->PruneOutOfAreaEntities(OutOfAreaEntityTimeoutSeconds);
+			TimeSinceOutOfAreaEntitiesPruned = 0;
+		}
+	}
+
+	ProcessPendingEntitySpawns();
+
+	ExpireEntityTimeouts();
+
+	UpdateDeadReckoning(DeltaTime);
+
+	UpdateProxyEntities();
+}
+
+void ADISGameManager::RegisterActorTickFunctions(bool bRegister)
+{
+	Super::RegisterActorTickFunctions(bRegister);
+
+	if (bRegister)
+	{
+		if (PrimaryActorTick.IsTickFunctionRegistered())
+		{
+			EntityTransformTickFunction.Target = this;
+			EntityTransformTickFunction.TickGroup = EntityTransformTickGroup;
+			EntityTransformTickFunction.EndTickGroup = EntityTransformTickGroup;
+			EntityTransformTickFunction.RegisterTickFunction(GetLevel());
+			EntityTransformTickFunction.AddPrerequisite(this, PrimaryActorTick);
+		}
+	}
+	else if (EntityTransformTickFunction.IsTickFunctionRegistered())
+	{
+		EntityTransformTickFunction.UnRegisterTickFunction();
+	}
+}
+
+#if WITH_EDITOR
+void ADISGameManager::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	//Edits to a tier's fields report the tier array as the member property
+	const FName memberPropertyName = PropertyChangedEvent.MemberProperty != nullptr ? PropertyChangedEvent.MemberProperty->GetFName() : NAME_None;
+	if (memberPropertyName == GET_MEMBER_NAME_CHECKED(ADISGameManager, DeadReckoningLODTiers))
+	{
+		UpdateDeadReckoningLODSettings();
+	}
+	else if (memberPropertyName == GET_MEMBER_NAME_CHECKED(ADISGameManager, MaxTimestampCompensationSeconds))
+	{
+		TimestampClock.SetMaxAge(MaxTimestampCompensationSeconds);
+	}
+}
+#endif
+
+void ADISGameManager::QueueEntityTransform(UDISReceiveComponent* DISComponent, const FVector& Location, const FRotator& Rotation)
+{
+	//Ground clamping and dead reckoning can both move an entity in the same frame, only the last pose is applied
+	const int32 queuedTransformIndex = DISComponent->QueuedTransformIndex;
+	if (QueuedEntityTransforms.IsValidIndex(queuedTransformIndex) && QueuedEntityTransforms[queuedTransformIndex].DISComponent == DISComponent)
+	{
+		QueuedEntityTransforms[queuedTransformIndex].Location = Location;
+		QueuedEntityTransforms[queuedTransformIndex].Rotation = Rotation;
+		return;
+	}
+
+	DISComponent->QueuedTransformIndex = QueuedEntityTransforms.Add({ DISComponent, Location, Rotation });
+}
+
+void ADISGameManager::CancelQueuedEntityTransform(UDISReceiveComponent* DISComponent)
+{
+	const int32 queuedTransformIndex = DISComponent->QueuedTransformIndex;
+	if (QueuedEntityTransforms.IsValidIndex(queuedTransformIndex) && QueuedEntityTransforms[queuedTransformIndex].DISComponent == DISComponent)
+	{
+		QueuedEntityTransforms[queuedTransformIndex].DISComponent = nullptr;
+	}
+	DISComponent->QueuedTransformIndex = INDEX_NONE;
+}
+
+void ADISGameManager::ApplyQueuedEntityTransforms()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ApplyEntityTransforms);
+
+	for (const FQueuedEntityTransform& queuedTransform : QueuedEntityTransforms)
+	{
+		UDISReceiveComponent* DISComponent = queuedTransform.DISComponent.Get();
+		if (!IsValid(DISComponent))
+		{
+			continue;
+		}
+		DISComponent->QueuedTransformIndex = INDEX_NONE;
+
+		AActor* entityActor = DISComponent->GetOwner();
+		USceneComponent* rootComponent = IsValid(entityActor) ? entityActor->GetRootComponent() : nullptr;
+		if (rootComponent == nullptr)
+		{
+			continue;
+		}
+
+		//Moves too small to see are not worth a transform update
+		if (rootComponent->GetComponentLocation().Equals(queuedTransform.Location, EntityTransformLocationTolerance)
+			&& rootComponent->GetComponentRotation().Equals(queuedTransform.Rotation, EntityTransformRotationTolerance))
+		{
+			continue;
+		}
+
+		//Entities jump to their new pose, so teleport instead of sweeping, and propagate to attached components and overlaps once at the end of the move
+		FScopedMovementUpdate scopedMovementUpdate(rootComponent, EScopedUpdate::DeferredUpdates);
+		entityActor->SetActorLocationAndRotation(queuedTransform.Location, queuedTransform.Rotation, false, nullptr, ETeleportType::TeleportPhysics);
+	}
+
+	QueuedEntityTransforms.Reset();
+}
+
+void ADISGameManager::ExpireEntityTimeouts()
+{
+	SCOPE_CYCLE_COUNTER(STAT_ExpireEntityTimeouts);
+
+	ExpiredEntityHandles.Reset();
+	EntityTimeouts.Advance(GetWorld()->GetTimeSeconds(), ExpiredEntityHandles);
+
+	for (const FDISEntityHandle& expiredEntityHandle : ExpiredEntityHandles)
+	{
+		//Entities removed earlier in the loop no longer resolve
+		const int32 entityIndex = EntityRegistry.FindIndex(expiredEntityHandle);
+		if (entityIndex == INDEX_NONE)
+		{
+			continue;
+		}
+
+		UDISReceiveComponent* DISComponent = EntityRegistry.GetComponent(entityIndex);
+		if (DISComponent != nullptr)
+		{
+			DISComponent->HandleEntityTimedOut();
+		}
+		else if (EntityRegistry.IsHeadless(entityIndex))
+		{
+			UE_LOG(LogDISGameManager, Verbose, TEXT("Headless entity %s timed out, removing entity..."), *EntityRegistry.GetEntityID(entityIndex).ToString());
+			RemoveHeadlessEntity(EntityRegistry.GetEntityID(entityIndex));
+		}
+	}
+}
+
+bool ADISGameManager::RefreshEntityTimeout(const UDISReceiveComponent* DISComponent)
+{
+	if (DISComponent == nullptr || !EntityRegistry.IsValid(DISComponent->EntityHandle))
+	{
+		return false;
+	}
+
+	const double currentTime = GetWorld()->GetTimeSeconds();
+	if (!EntityTimeouts.Refresh(DISComponent->EntityHandle, currentTime))
+	{
+		EntityTimeouts.Schedule(DISComponent->EntityHandle, currentTime, GetEntityTimeoutSeconds(DISComponent->EntityType, DISComponent->DISTimeoutSeconds));
+	}
+
+	return true;
+}
+
+float ADISGameManager::GetEntityTimeoutSeconds(const FEntityType& EntityType, float DefaultTimeoutSeconds) const
+{
+	if (EntityTypeTimeoutSeconds.Num() == 0)
+	{
+		return DefaultTimeoutSeconds;
+	}
+
+	//Broaden the Entity Type one field at a time, from extra up to domain, until a listed type matches
+	FEntityType searchType = EntityType;
+	int32* const wildcardFields[] = { &searchType.Extra, &searchType.Specific, &searchType.Subcategory, &searchType.Category, &searchType.Country, &searchType.Domain };
+
+	const float* timeoutSeconds = EntityTypeTimeoutSeconds.Find(searchType);
+	for (int32 fieldIndex = 0; timeoutSeconds == nullptr && fieldIndex < UE_ARRAY_COUNT(wildcardFields); fieldIndex++)
+	{
+		*wildcardFields[fieldIndex] = -1;
+		timeoutSeconds = EntityTypeTimeoutSeconds.Find(searchType);
+	}
+
+	return timeoutSeconds != nullptr ? *timeoutSeconds : DefaultTimeoutSeconds;
+}
+
+void ADISGameManager::UpdateDeadReckoning(float DeltaTime)
+{
+	TArray<FVector, TInlineAllocator<4>> viewpointECEFLocations;
+	GetViewpointECEFLocations(viewpointECEFLocations);
+
+	{
+		SCOPE_CYCLE_COUNTER(STAT_UpdateDeadReckoning);
+		EntityRegistry.UpdateDeadReckoning(DeltaTime, viewpointECEFLocations, EnableDeadReckoningLOD ? &DeadReckoningLODSettings : nullptr, EnableEntityDormancy,
+			UseInterpolationBuffer ? InterpolationDelaySeconds : 0);
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_ApplyDeadReckoning);
+
+	//Applying an update can fire events that add or remove entities, which moves entities around the dense arrays.
+	//Index the updated locations and collect the entities to apply first, then look each one back up by handle while applying.
+	DeadReckonedEntityHandles.Reset();
+	for (int32 entityIndex = 0; entityIndex < EntityRegistry.Num(); entityIndex++)
+	{
+		const FDISDeadReckoningParameters& parameters = EntityRegistry.GetDeadReckoningParameters(entityIndex);
+
+		//Dormant entities keep the transform, ground clamp, and index location from the update that put them to sleep
+		if (parameters.bSkippedWhileDormant)
+		{
+			continue;
+		}
+
+		if (parameters.bUpdated)
+		{
+			const double* deadReckonedLocation = EntityRegistry.GetDeadReckonedEntityState(entityIndex).EntityLocation;
+			EntitySpatialIndex.Update(EntityRegistry.GetHandle(entityIndex), glm::dvec3(deadReckonedLocation[0], deadReckonedLocation[1], deadReckonedLocation[2]));
+		}
+
+		//Headless entities have no actor to apply the update to
+		if (!EntityRegistry.IsHeadless(entityIndex))
+		{
+			DeadReckonedEntityHandles.Add(EntityRegistry.GetHandle(entityIndex));
+		}
+	}
+
+	for (const FDISEntityHandle entityHandle : DeadReckonedEntityHandles)
 	{
-		if (IsValid(DisEntity.second))
+		//Skip entities removed by an update applied earlier this frame
+		const int32 entityIndex = EntityRegistry.FindIndex(entityHandle);
+		if (entityIndex == INDEX_NONE)
+		{
+			continue;
+		}
+
+		AActor* DISEntity = EntityRegistry.GetActor(entityIndex);
+		if (IsValid(DISEntity))
 		{
-			UDISReceiveComponent* DISComponent = IDISInterface::Execute_GetActorDISReceiveComponent(DisEntity.second);
+			UDISReceiveComponent* DISComponent = EntityRegistry.GetComponent(entityIndex);
 
 			if (DISComponent)
 			{
-				DISComponent->DoDeadReckoning(DeltaTime);
+				DISComponent->ApplyDeadReckoningUpdate(EntityRegistry.GetDeadReckonedEntityState(entityIndex), EntityRegistry.GetDeadReckoningParameters(entityIndex));
+
+				//Entities waiting on an asynchronous ground clamping trace are updated again next frame, before its result expires
+				const int32 pendingClampIndex = DISComponent->IsGroundClampPending() ? EntityRegistry.FindIndex(entityHandle) : INDEX_NONE;
+				if (pendingClampIndex != INDEX_NONE && EntityRegistry.GetComponent(pendingClampIndex) == DISComponent)
+				{
+					FDISDeadReckoningParameters& pendingClampParameters = EntityRegistry.GetDeadReckoningParameters(pendingClampIndex);
+					pendingClampParameters.bForceLODUpdate = true;
+					pendingClampParameters.bDormant = false;
+				}
 			}
 			else 
 			{
-				UE_LOG(LogDISGameManager, Warning, TEXT("Cannot find DISComponent on entity %s"), *DisEntity.second->GetName())
+				UE_LOG(LogDISGameManager, Warning, TEXT("Cannot find DISComponent on entity %s"), *DISEntity->GetName())
 			}
 		}
 		else
 		{
-			UE_LOG(LogDISGameManager, Error, TEXT("Encountered null reference within RawDISActorMapping! Check C++ side usage of RawDISActorMapping to verify using properly!"));
+			UE_LOG(LogDISGameManager, Error, TEXT("Encountered null reference within the entity registry for %s! Verify that entities are removed from the DIS Game Manager before being destroyed."), *EntityRegistry.GetEntityID(entityIndex).ToString());
+		}
+	}
+}
+
+void ADISGameManager::UpdateEntityDeadReckoningState(const UDISReceiveComponent* DISComponent)
+{
+	const int32 entityIndex = EntityRegistry.FindIndex(DISComponent->EntityHandle);
+	if (entityIndex == INDEX_NONE || EntityRegistry.GetComponent(entityIndex) != DISComponent)
+	{
+		return;
+	}
+
+	DISComponent->WriteDeadReckoningState(EntityRegistry.GetReceivedEntityState(entityIndex), EntityRegistry.GetDeadReckonedEntityState(entityIndex), EntityRegistry.GetDeadReckoningParameters(entityIndex));
+	EntityRegistry.PrecomputeDeadReckoningKernel(entityIndex);
+	if (UseInterpolationBuffer)
+	{
+		EntityRegistry.PushInterpolationSample(entityIndex);
+	}
+
+	const double* deadReckonedLocation = EntityRegistry.GetDeadReckonedEntityState(entityIndex).EntityLocation;
+	EntitySpatialIndex.Update(DISComponent->EntityHandle, glm::dvec3(deadReckonedLocation[0], deadReckonedLocation[1], deadReckonedLocation[2]));
+
+	//Show the new state right away instead of waiting for the entity's level of detail tier to come around
+	EntityRegistry.GetDeadReckoningParameters(entityIndex).bForceLODUpdate = true;
+}
+
+void ADISGameManager::UpdateDeadReckoningLODSettings()
+{
+	DeadReckoningLODSettings.Reset();
+
+	TArray<FDISDeadReckoningLODTier, TInlineAllocator<4>> sortedTiers(DeadReckoningLODTiers);
+	sortedTiers.Sort([](const FDISDeadReckoningLODTier& A, const FDISDeadReckoningLODTier& B)
+	{
+		return A.MaxDistance < B.MaxDistance;
+	});
+
+	for (const FDISDeadReckoningLODTier& tier : sortedTiers)
+	{
+		DeadReckoningLODSettings.MaxDistancesSquared.Add(FMath::Square(tier.MaxDistance));
+		DeadReckoningLODSettings.UpdateIntervals.Add(tier.UpdateRate > 0 ? 1.0f / tier.UpdateRate : 0.0f);
+	}
+}
+
+void ADISGameManager::RegisterWithSignificanceManager(AActor* EntityActor, FDISEntityHandle EntityHandle)
+{
+	USignificanceManager* significanceManager = USignificanceManager::Get(GetWorld());
+	if (significanceManager == nullptr)
+	{
+		UE_LOG(LogDISGameManager, Warning, TEXT("UseSignificanceManager is enabled but no Significance Manager exists for this world. Entity tiers will be picked by distance instead."));
+		return;
+	}
+
+	//Tier 0 is the most significant. Significance functions may run on worker threads, so they only read the tier settings, which are rebuilt on the game thread.
+	auto significanceFunction = [this](USignificanceManager::FManagedObjectInfo* ObjectInfo, const FTransform& Viewpoint) -> float
+	{
+		const AActor* entityActor = CastChecked<AActor>(ObjectInfo->GetObject());
+		const int32 tier = DeadReckoningLODSettings.GetTier(FVector::DistSquared(entityActor->GetActorLocation(), Viewpoint.GetLocation()));
+		return DeadReckoningLODSettings.Num() - tier;
+	};
+
+	auto postSignificanceFunction = [this, EntityHandle](USignificanceManager::FManagedObjectInfo* ObjectInfo, float OldSignificance, float Significance, bool bFinal)
+	{
+		const int32 entityIndex = EntityRegistry.FindIndex(EntityHandle);
+		if (entityIndex != INDEX_NONE)
+		{
+			EntityRegistry.GetDeadReckoningParameters(entityIndex).SignificanceLODTier = Significance > 0 ? DeadReckoningLODSettings.Num() - FMath::RoundToInt(Significance) : INDEX_NONE;
 		}
+	};
+
+	significanceManager->RegisterObject(EntityActor, SIGNIFICANCE_TAG, significanceFunction, USignificanceManager::EPostSignificanceType::Sequential, postSignificanceFunction);
+}
+
+void ADISGameManager::UnregisterFromSignificanceManager(AActor* EntityActor)
+{
+	if (USignificanceManager* significanceManager = USignificanceManager::Get(GetWorld()))
+	{
+		significanceManager->UnregisterObject(EntityActor);
 	}
 }
 
@@ -129,11 +576,25 @@ void ADISGameManager::HandleOnDISEntityDestroyed(AActor* DestroyedActor)
 {
 	bool anyRemoved = false;
 
+	//Pooled actors are not in the entity mapping while they wait in their pool
+	FDISActorPool* actorPool = ActorPools.Find(DestroyedActor->GetClass());
+	if (actorPool != nullptr && actorPool->InactiveActors.Remove(DestroyedActor) > 0)
+	{
+		return;
+	}
+
 	//Remove the actor from the dis entity mapping
 	UDISReceiveComponent* DISComponent = IDISInterface::Execute_GetActorDISReceiveComponent(DestroyedActor);
 
 	if (DISComponent != nullptr)
 	{
+		//The entity may have moved on to another actor or to a proxy, in which case its registry entry is kept
+		const AActor* registeredActor = EntityRegistry.FindActor(DISComponent->EntityID);
+		if (registeredActor != DestroyedActor && EntityRegistry.Contains(DISComponent->EntityID))
+		{
+			return;
+		}
+
 		anyRemoved = RemoveDISEntityFromMap(DISComponent->EntityID);
 	}
 
@@ -143,20 +604,28 @@ void ADISGameManager::HandleOnDISEntityDestroyed(AActor* DestroyedActor)
 	}
 }
 
-void ADISGameManager::HandleEntityStatePDU(FEntityStatePDU EntityStatePDUIn)
+void ADISGameManager::HandleEntityStatePDU(const FEntityStatePDU& EntityStatePDUIn)
 {
 	if (EntityStatePDUIn.ExerciseID == ExerciseID)
 	{
-		//Find associated actor in the DISActorMappings map -- If actor does not exist spawn one
-		auto associatedActor = RawDISActorMappings.find(EntityStatePDUIn.EntityID);
-		if (associatedActor != RawDISActorMappings.end())
+		//Find associated entity in the entity registry -- If entity does not exist spawn one
+		const int32 entityIndex = EntityRegistry.FindIndex(EntityStatePDUIn.EntityID);
+		if (entityIndex != INDEX_NONE)
 		{
-			//If an actor was found, relay information to the associated component
-			UDISReceiveComponent* DISComponent = IDISInterface::Execute_GetActorDISReceiveComponent(associatedActor->second);
+			//If an entity was found, relay information to the associated component
+			UDISReceiveComponent* DISComponent = EntityRegistry.GetComponent(entityIndex);
 
 			if (DISComponent != nullptr)
 			{
-				DISComponent->HandleEntityStatePDU(EntityStatePDUIn);
+				if (!RemoveIfOutsideAreaOfInterest(DISComponent, EntityStatePDUIn.EntityLocationDouble))
+				{
+					DISComponent->HandleEntityStatePDU(EntityStatePDUIn);
+				}
+			}
+			else if (EntityRegistry.IsHeadless(entityIndex))
+			{
+				EntityRegistry.GetReceivedEntityState(entityIndex).FromEntityStatePDU(EntityStatePDUIn);
+				UpdateHeadlessEntity(entityIndex);
 			}
 		}
 		else
@@ -164,7 +633,33 @@ void ADISGameManager::HandleEntityStatePDU(FEntityStatePDU EntityStatePDUIn)
 			//Check if the entity has been deactivated -- Entity is deactivated if the 23rd bit of the Entity Appearance value is set
 			if (EntityStatePDUIn.EntityAppearance.IsDeactivated)
 			{
-				UE_LOG(LogDISGameManager, Log, TEXT("Received Entity State PDU with a Deactivated Entity Appearance for an entity that is not in the level. Ignoring the PDU. Entity marking: %s"), *EntityStatePDUIn.Marking);
+				if (PendingEntitySpawns.Remove(EntityStatePDUIn.EntityID) > 0)
+				{
+					UE_LOG(LogDISGameManager, Log, TEXT("Received Entity State PDU with a Deactivated Entity Appearance for an entity that is waiting on its class to load. Cancelling the spawn. Entity marking: %s"), *EntityStatePDUIn.Marking);
+				}
+				else
+				{
+					UE_LOG(LogDISGameManager, Log, TEXT("Received Entity State PDU with a Deactivated Entity Appearance for an entity that is not in the level. Ignoring the PDU. Entity marking: %s"), *EntityStatePDUIn.Marking);
+				}
+				return;
+			}
+
+			//If the entity is already waiting on its class to load, keep the latest state for when it spawns
+			FPendingEntitySpawn* pendingEntitySpawn = PendingEntitySpawns.Find(EntityStatePDUIn.EntityID);
+			if (pendingEntitySpawn != nullptr)
+			{
+				pendingEntitySpawn->EntityState.FromEntityStatePDU(EntityStatePDUIn);
+				return;
+			}
+
+			if (EnableHeadlessMode)
+			{
+				AddHeadlessEntity(EntityStatePDUIn, HeadlessDeadReckoning);
+				return;
+			}
+
+			if (EnableProxyEntities && AddProxyEntity(EntityStatePDUIn))
+			{
 				return;
 			}
 
@@ -173,23 +668,37 @@ void ADISGameManager::HandleEntityStatePDU(FEntityStatePDU EntityStatePDUIn)
 	}
 }
 
-void ADISGameManager::HandleEntityStateUpdatePDU(FEntityStateUpdatePDU EntityStateUpdatePDUIn)
+void ADISGameManager::HandleEntityStateUpdatePDU(const FEntityStateUpdatePDU& EntityStateUpdatePDUIn)
 {
 	if (EntityStateUpdatePDUIn.ExerciseID == ExerciseID)
 	{
 		// NOTE: Entity State Update PDUs do not contain an Entity Type, so we cannot spawn an entity from one
 
 		//Get associated OpenDISComponent and relay information
-		UDISReceiveComponent* DISComponent = GetAssociatedDISComponent(EntityStateUpdatePDUIn.EntityID);
+		const int32 entityIndex = EntityRegistry.FindIndex(EntityStateUpdatePDUIn.EntityID);
+		UDISReceiveComponent* DISComponent = entityIndex != INDEX_NONE ? EntityRegistry.GetComponent(entityIndex) : nullptr;
 
 		if (DISComponent != nullptr)
 		{
-			DISComponent->HandleEntityStateUpdatePDU(EntityStateUpdatePDUIn);
+			if (!RemoveIfOutsideAreaOfInterest(DISComponent, EntityStateUpdatePDUIn.EntityLocationDouble))
+			{
+				DISComponent->HandleEntityStateUpdatePDU(EntityStateUpdatePDUIn);
+			}
+		}
+		else if (entityIndex != INDEX_NONE && EntityRegistry.IsHeadless(entityIndex))
+		{
+			EntityRegistry.GetReceivedEntityState(entityIndex).ApplyEntityStateUpdatePDU(EntityStateUpdatePDUIn);
+			UpdateHeadlessEntity(entityIndex);
+		}
+		else if (FPendingEntitySpawn* pendingEntitySpawn = PendingEntitySpawns.Find(EntityStateUpdatePDUIn.EntityID))
+		{
+			//The entity is waiting on its class to load, so merge the update into the state it will spawn with
+			pendingEntitySpawn->EntityState.ApplyEntityStateUpdatePDU(EntityStateUpdatePDUIn);
 		}
 	}
 }
 
-void ADISGameManager::HandleFirePDU(FFirePDU FirePDUIn)
+void ADISGameManager::HandleFirePDU(const FFirePDU& FirePDUIn)
 {
 	if (FirePDUIn.ExerciseID == ExerciseID)
 	{
@@ -200,10 +709,16 @@ void ADISGameManager::HandleFirePDU(FFirePDU FirePDUIn)
 		{
 			DISComponent->HandleFirePDU(FirePDUIn);
 		}
+
+		if (EnableProxyEntities && PromoteProxiesOnFireAndDetonation)
+		{
+			PromoteProxyEntity(FirePDUIn.FiringEntityID);
+			PromoteProxyEntity(FirePDUIn.TargetEntityID);
+		}
 	}
 }
 
-void ADISGameManager::HandleDetonationPDU(FDetonationPDU DetonationPDUIn)
+void ADISGameManager::HandleDetonationPDU(const FDetonationPDU& DetonationPDUIn)
 {	
 	if (DetonationPDUIn.ExerciseID == ExerciseID)
 	{
@@ -214,10 +729,16 @@ void ADISGameManager::HandleDetonationPDU(FDetonationPDU DetonationPDUIn)
 		{
 			DISComponent->HandleDetonationPDU(DetonationPDUIn);
 		}
+
+		if (EnableProxyEntities && PromoteProxiesOnFireAndDetonation)
+		{
+			PromoteProxyEntity(DetonationPDUIn.FiringEntityID);
+			PromoteProxyEntity(DetonationPDUIn.TargetEntityID);
+		}
 	}
 }
 
-void ADISGameManager::HandleRemoveEntityPDU(FRemoveEntityPDU RemoveEntityPDUIn)
+void ADISGameManager::HandleRemoveEntityPDU(const FRemoveEntityPDU& RemoveEntityPDUIn)
 {
 	//Verify that we are the appropriate sim to handle the RemoveEntityPDU
 	if (RemoveEntityPDUIn.ExerciseID == ExerciseID && RemoveEntityPDUIn.ReceivingEntityID.Site == SiteID && RemoveEntityPDUIn.ReceivingEntityID.Application == ApplicationID)
@@ -232,7 +753,7 @@ void ADISGameManager::HandleRemoveEntityPDU(FRemoveEntityPDU RemoveEntityPDUIn)
 	}
 }
 
-void ADISGameManager::HandleStopFreezePDU(FStopFreezePDU StopFreezePDUIn)
+void ADISGameManager::HandleStopFreezePDU(const FStopFreezePDU& StopFreezePDUIn)
 {
 	//Verify that we are the appropriate sim to handle the StopFreezePDU
 	if (StopFreezePDUIn.ExerciseID == ExerciseID && StopFreezePDUIn.ReceivingEntityID.Site == SiteID && StopFreezePDUIn.ReceivingEntityID.Application == ApplicationID)
@@ -247,7 +768,7 @@ void ADISGameManager::HandleStopFreezePDU(FStopFreezePDU StopFreezePDUIn)
 	}
 }
 
-void ADISGameManager::HandleStartResumePDU(FStartResumePDU StartResumePDUIn)
+void ADISGameManager::HandleStartResumePDU(const FStartResumePDU& StartResumePDUIn)
 {
 	//Verify that we are the appropriate sim to handle the StartResumePDU
 	if (StartResumePDUIn.ExerciseID == ExerciseID && StartResumePDUIn.ReceivingEntityID.Site == SiteID && StartResumePDUIn.ReceivingEntityID.Application == ApplicationID)
@@ -262,7 +783,7 @@ void ADISGameManager::HandleStartResumePDU(FStartResumePDU StartResumePDUIn)
 	}
 }
 
-void ADISGameManager::HandleElectromagneticEmissionsPDU(FElectromagneticEmissionsPDU ElectromagneticEmissionsPDUIn)
+void ADISGameManager::HandleElectromagneticEmissionsPDU(const FElectromagneticEmissionsPDU& ElectromagneticEmissionsPDUIn)
 {
 	//Verify that we are the appropriate sim to handle the ElectromagneticEmissionsPDUIn
 	if (ElectromagneticEmissionsPDUIn.ExerciseID == ExerciseID)
@@ -277,104 +798,465 @@ void ADISGameManager::HandleElectromagneticEmissionsPDU(FElectromagneticEmission
 	}
 }
 
-void ADISGameManager::SpawnNewEntityFromEntityState(FEntityStatePDU EntityStatePDUIn)
+void ADISGameManager::SpawnNewEntityFromEntityState(const FEntityStatePDU& EntityStatePDUIn)
 {	
-	auto associatedSoftClassReference = RawDISClassMappings.find(EntityStatePDUIn.EntityType);
-	UClass* associatedClass = nullptr;
+	const TSoftClassPtr<AActor>* associatedSoftClassReference = nullptr;
+	bool bWasCached = false;
+	{
+		SCOPE_CYCLE_COUNTER(STAT_ResolveEntityType);
+		associatedSoftClassReference = EntityTypeResolver.Resolve(EntityStatePDUIn.EntityType, bWasCached);
+	}
 
-	//If an actor was not found, check to see if there is a wildcard mapping -- else, load the found actor
-	if (associatedSoftClassReference == RawDISClassMappings.end())
+	if (associatedSoftClassReference == nullptr)
 	{
-		std::map<FEntityType, TSoftClassPtr<AActor>> WildcardMappings;
-		for (std::pair<FEntityType, TSoftClassPtr<AActor>> Pair : RawDISClassMappings)
+		//Only notify the user the first time an unmapped enumeration is seen -- Later misses are served from the resolver's cache
+		if (!bWasCached)
 		{
-			FEntityType Key = Pair.first;
-			FEntityType FilledKey = FEntityType(Pair.first).FillWildcards(EntityStatePDUIn.EntityType);
-			if (!(Key == FilledKey))
-			{
-				Key = FilledKey;
-				//WildcardMappings.Add(Key, Pair.Value);
-				WildcardMappings.insert({ Key, Pair.second });
-			}
+			UE_LOG(LogDISGameManager, Warning, TEXT("No mapping exists between an actor and the DIS enumeration of: %s"), *EntityStatePDUIn.EntityType.ToString());
 		}
+		return;
+	}
 
-		auto NewSoftClassRef = WildcardMappings.find(EntityStatePDUIn.EntityType);
-		if (NewSoftClassRef != WildcardMappings.end()) 
+	if (associatedSoftClassReference->IsNull())
+	{
+		if (!bWasCached)
 		{
-			associatedClass = NewSoftClassRef->second.LoadSynchronous();
-
-			if (associatedClass == nullptr)
-			{
-				UE_LOG(LogDISGameManager, Warning, TEXT("Mapping found, but points to a null class for the enumeration of: %s"), *EntityStatePDUIn.EntityType.ToString());
-				return;
-			}
+			UE_LOG(LogDISGameManager, Warning, TEXT("Mapping points to a null class for the enumeration of: %s"), *EntityStatePDUIn.EntityType.ToString());
 		}
+		return;
 	}
-	else
-	{
-		associatedClass = associatedSoftClassReference->second.LoadSynchronous();
 
-		if (associatedClass == nullptr) 
+	//Classes that failed to load have already been reported, so do not keep queueing entities for them
+	if (FailedEntityClassLoads.Contains(associatedSoftClassReference->ToSoftObjectPath()))
+	{
+		return;
+	}
+
+	if (!LoadEntityClassesAsynchronously && associatedSoftClassReference->LoadSynchronous() == nullptr)
+	{
+		UE_LOG(LogDISGameManager, Warning, TEXT("Mapping points to a class that failed to load for the enumeration of: %s"), *EntityStatePDUIn.EntityType.ToString());
+		FailedEntityClassLoads.Add(associatedSoftClassReference->ToSoftObjectPath());
+		return;
+	}
+
+	//Entities are spawned from the spawn queue so that the number of spawns per frame can be limited
+	QueuePendingEntitySpawn(*associatedSoftClassReference, EntityStatePDUIn);
+}
+
+void ADISGameManager::SpawnEntityActor(UClass* EntityClass, const FEntityStatePDU& EntityStatePDUIn)
+{
+	//Spawn the actor and relay information to the associated component
+	FVector spawnLocation;
+	FRotator spawnRotation;
+	UDIS_BPFL::GetUnrealLocationAndOrientationFromEntityStatePdu(EntityStatePDUIn, GeoReferencingSystem, spawnLocation, spawnRotation);
+
+	FTransform spawnTransform = FTransform(spawnRotation, spawnLocation);
+
+	//Reuse an inactive actor of the same class if one is available
+	if (EnableActorPooling)
+	{
+		AActor* pooledActor = AcquirePooledActor(EntityClass);
+		if (pooledActor != nullptr)
 		{
-			UE_LOG(LogDISGameManager, Warning, TEXT("Mapping points to a null class for the enumeration of: %s"), *EntityStatePDUIn.EntityType.ToString());
+			ReuseEntityActor(pooledActor, spawnTransform, EntityStatePDUIn);
 			return;
 		}
 	}
 
-	//If an actor has been found, spawn one and relay information to the associated component
-	if (associatedClass != nullptr)
+	//Defer spawning of the actor. Allows an uncompleted actor reference to be used to add a tag to prior to finishing spawning of the actor.
+	AActor* spawnedActor = GetWorld()->SpawnActorDeferred<AActor>(EntityClass, spawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+
+	FInitialDISConditions initialDISConditions = FInitialDISConditions(EntityStatePDUIn, true);
+	//Store the initial received ESPDU -- This gets used by the DISReceiveComponents later to set initial conditions when initializing themselves
+	InitialEntityConditions.Add(spawnedActor, initialDISConditions);
+
+	UGameplayStatics::FinishSpawningActor(spawnedActor, spawnTransform);
+
+	if (spawnedActor != nullptr)
+	{
+		//Add actor to the map
+		AddDISEntityToMap(EntityStatePDUIn.EntityID, spawnedActor);
+		spawnedActor->OnDestroyed.AddUniqueDynamic(this, &ADISGameManager::HandleOnDISEntityDestroyed);
+
+		//Get DIS Component of the newly spawned actor
+		UDISReceiveComponent* DISComponent = EntityRegistry.FindComponent(EntityStatePDUIn.EntityID);
+
+		if (DISComponent != nullptr)
+		{
+			if (EnableActorPooling)
+			{
+				//Pooled actors are returned to the pool rather than destroyed when they are removed or time out
+				DISComponent->bPooledActor = true;
+			}
+
+			DISComponent->HandleEntityStatePDU(EntityStatePDUIn);
+		}
+	}
+}
+
+void ADISGameManager::QueuePendingEntitySpawn(const TSoftClassPtr<AActor>& EntityClass, const FEntityStatePDU& EntityStatePDUIn)
+{
+	FPendingEntitySpawn& pendingEntitySpawn = PendingEntitySpawns.FindOrAdd(EntityStatePDUIn.EntityID);
+	pendingEntitySpawn.EntityClass = EntityClass;
+	pendingEntitySpawn.EntityState.FromEntityStatePDU(EntityStatePDUIn);
+
+	//Only request the class once -- Entities waiting on it become eligible to spawn when the load completes
+	const FSoftObjectPath entityClassPath = EntityClass.ToSoftObjectPath();
+	if (LoadEntityClassesAsynchronously && EntityClass.Get() == nullptr && !EntityClassLoadHandles.Contains(entityClassPath))
+	{
+		TSharedPtr<FStreamableHandle> loadHandle = StreamableManager.RequestAsyncLoad(entityClassPath, FStreamableDelegate::CreateUObject(this, &ADISGameManager::HandleEntityClassLoaded, entityClassPath));
+		EntityClassLoadHandles.Add(entityClassPath, loadHandle);
+	}
+}
+
+void ADISGameManager::HandleEntityClassLoaded(FSoftObjectPath EntityClassPath)
+{
+	if (EntityClassPath.ResolveObject() != nullptr)
+	{
+		//Entities waiting on the class are spawned by the spawn queue
+		return;
+	}
+
+	UE_LOG(LogDISGameManager, Warning, TEXT("Failed to load entity class %s. Entities mapped to it will not be spawned."), *EntityClassPath.ToString());
+	FailedEntityClassLoads.Add(EntityClassPath);
+	EntityClassLoadHandles.Remove(EntityClassPath);
+
+	for (auto pendingIterator = PendingEntitySpawns.CreateIterator(); pendingIterator; ++pendingIterator)
+	{
+		if (pendingIterator->Value.EntityClass.ToSoftObjectPath() == EntityClassPath)
+		{
+			pendingIterator.RemoveCurrent();
+		}
+	}
+}
+
+void ADISGameManager::ProcessPendingEntitySpawns()
+{
+	if (PendingEntitySpawns.Num() == 0)
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_ProcessPendingEntitySpawns);
+
+	//Only entities whose class has finished loading can be spawned
+	SpawnCandidates.Reset();
+	for (TPair<FEntityID, FPendingEntitySpawn>& pendingEntitySpawn : PendingEntitySpawns)
+	{
+		if (pendingEntitySpawn.Value.EntityClass.Get() != nullptr)
+		{
+			SpawnCandidates.Add(&pendingEntitySpawn.Value);
+		}
+	}
+
+	if (SpawnCandidates.Num() == 0)
+	{
+		return;
+	}
+
+	//Find each candidate's distance to the closest viewpoint across worker threads. Only the ECEF distance is calculated here, as converting to Unreal space goes through the GeoReferencing System, which is not thread safe.
+	TArray<FVector, TInlineAllocator<4>> viewpointECEFLocations;
+	GetViewpointECEFLocations(viewpointECEFLocations);
+
+	ParallelFor(SpawnCandidates.Num(), [this, &viewpointECEFLocations](int32 candidateIndex)
+	{
+		FPendingEntitySpawn& candidate = *SpawnCandidates[candidateIndex];
+		const double* entityLocation = candidate.EntityState.EntityLocation;
+
+		double closestDistanceSquared = viewpointECEFLocations.Num() > 0 ? TNumericLimits<double>::Max() : 0;
+		for (const FVector& viewpointECEFLocation : viewpointECEFLocations)
+		{
+			const double deltaX = entityLocation[0] - viewpointECEFLocation.X;
+			const double deltaY = entityLocation[1] - viewpointECEFLocation.Y;
+			const double deltaZ = entityLocation[2] - viewpointECEFLocation.Z;
+			closestDistanceSquared = FMath::Min(closestDistanceSquared, deltaX * deltaX + deltaY * deltaY + deltaZ * deltaZ);
+		}
+
+		candidate.SpawnImportance = -FMath::Sqrt(closestDistanceSquared);
+	}, SpawnCandidates.Num() < MIN_PARALLEL_SPAWN_CANDIDATES);
+
+	//The importance override may touch game state, so it is evaluated on the game thread once the distances are known
+	if (SpawnImportanceDelegate.IsBound())
+	{
+		for (FPendingEntitySpawn* candidate : SpawnCandidates)
+		{
+			candidate->SpawnImportance = SpawnImportanceDelegate.Execute(candidate->EntityState, -candidate->SpawnImportance);
+		}
+	}
+
+	SpawnCandidates.Sort([](const FPendingEntitySpawn& A, const FPendingEntitySpawn& B)
+	{
+		return A.SpawnImportance > B.SpawnImportance;
+	});
+
+	//Copy out the spawn order, as spawning runs user code that may add to or remove from the spawn queue
+	const int32 maxSpawns = MaxSpawnsPerFrame > 0 ? FMath::Min(MaxSpawnsPerFrame, SpawnCandidates.Num()) : SpawnCandidates.Num();
+	SpawnOrder.Reset();
+	for (int32 candidateIndex = 0; candidateIndex < maxSpawns; candidateIndex++)
+	{
+		SpawnOrder.Add(SpawnCandidates[candidateIndex]->EntityState.EntityID);
+	}
+	SpawnCandidates.Reset();
+
+	const uint64 startCycles = FPlatformTime::Cycles64();
+	FPendingEntitySpawn entityToSpawn;
+	FEntityStatePDU entityStatePDU;
+	for (const FEntityID& entityID : SpawnOrder)
+	{
+		if (!PendingEntitySpawns.RemoveAndCopyValue(entityID, entityToSpawn))
+		{
+			continue;
+		}
+
+		UClass* entityClass = entityToSpawn.EntityClass.Get();
+		entityToSpawn.EntityState.ToEntityStatePDU(entityStatePDU);
+
+		//An Entity State Update PDU may have deactivated the entity while it was waiting
+		if (entityClass != nullptr && !entityStatePDU.EntityAppearance.IsDeactivated)
+		{
+			SpawnEntityActor(entityClass, entityStatePDU);
+		}
+
+		if (SpawnBudgetMilliseconds > 0 && FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - startCycles) >= SpawnBudgetMilliseconds)
+		{
+			break;
+		}
+	}
+}
+
+void ADISGameManager::GetViewpointLocations(TArray<FVector, TInlineAllocator<4>>& ViewpointLocations) const
+{
+	for (FConstPlayerControllerIterator playerControllerIterator = GetWorld()->GetPlayerControllerIterator(); playerControllerIterator; ++playerControllerIterator)
+	{
+		const APlayerController* playerController = playerControllerIterator->Get();
+		if (playerController == nullptr || !playerController->IsLocalController())
+		{
+			continue;
+		}
+
+		FVector viewpointLocation;
+		FRotator viewpointRotation;
+		playerController->GetPlayerViewPoint(viewpointLocation, viewpointRotation);
+		ViewpointLocations.Add(viewpointLocation);
+	}
+}
+
+void ADISGameManager::GetViewpointECEFLocations(TArray<FVector, TInlineAllocator<4>>& ViewpointECEFLocations) const
+{
+	if (!IsValid(GeoReferencingSystem))
+	{
+		return;
+	}
+
+	GetViewpointLocations(ViewpointECEFLocations);
+
+	for (FVector& viewpointLocation : ViewpointECEFLocations)
+	{
+		FCartesianCoordinates viewpointECEF;
+		GeoReferencingSystem->EngineToECEF(viewpointLocation, viewpointECEF);
+		viewpointLocation = FVector(viewpointECEF.X, viewpointECEF.Y, viewpointECEF.Z);
+	}
+}
+
+void ADISGameManager::PreloadMappedEntityClasses()
+{
+	for (const TSoftClassPtr<AActor>& mappedClass : EntityTypeResolver.GetMappedClasses())
+	{
+		const FSoftObjectPath entityClassPath = mappedClass.ToSoftObjectPath();
+		if (entityClassPath.IsNull() || EntityClassLoadHandles.Contains(entityClassPath))
+		{
+			continue;
+		}
+
+		TSharedPtr<FStreamableHandle> loadHandle = StreamableManager.RequestAsyncLoad(entityClassPath, FStreamableDelegate::CreateUObject(this, &ADISGameManager::HandleEntityClassLoaded, entityClassPath));
+		EntityClassLoadHandles.Add(entityClassPath, loadHandle);
+	}
+
+	UE_LOG(LogDISGameManager, Log, TEXT("Preloading %d entity classes."), EntityClassLoadHandles.Num());
+}
+
+bool ADISGameManager::ReleaseEntityActor(AActor* EntityActor)
+{
+	if (!IsValid(EntityActor))
+	{
+		return false;
+	}
+
+	UDISReceiveComponent* DISComponent = nullptr;
+	if (EntityActor->GetClass()->ImplementsInterface(UDISInterface::StaticClass()))
+	{
+		DISComponent = IDISInterface::Execute_GetActorDISReceiveComponent(EntityActor);
+	}
+
+	const bool bCanPool = EnableActorPooling && DISComponent != nullptr && DISComponent->bPooledActor;
+	FDISActorPool* actorPool = bCanPool ? &ActorPools.FindOrAdd(EntityActor->GetClass()) : nullptr;
+	if (actorPool == nullptr || actorPool->InactiveActors.Num() >= MaxPooledActorsPerClass)
+	{
+		EntityActor->Destroy();
+		return false;
+	}
+
+	//Only remove the mapping if it still points at this actor -- A newer actor may have taken over the entity ID
+	if (EntityRegistry.FindActor(DISComponent->EntityID) == EntityActor)
+	{
+		RemoveDISEntityFromMap(DISComponent->EntityID);
+	}
+
+	DISComponent->PrepareForPool();
+	DeactivatePooledActor(EntityActor);
+	actorPool->InactiveActors.Add(EntityActor);
+
+	if (EntityActor->GetClass()->ImplementsInterface(UDISPoolableInterface::StaticClass()))
 	{
-		FVector spawnLocation;
-		FRotator spawnRotation;
-		UDIS_BPFL::GetUnrealLocationAndOrientationFromEntityStatePdu(EntityStatePDUIn, GeoReferencingSystem, spawnLocation, spawnRotation);
+		IDISPoolableInterface::Execute_OnReleasedToPool(EntityActor);
+	}
 
-		FTransform spawnTransform = FTransform(spawnRotation, spawnLocation);
+	return true;
+}
 
-		//Defer spawning of the actor. Allows an uncompleted actor reference to be used to add a tag to prior to finishing spawning of the actor.
-		AActor* spawnedActor = GetWorld()->SpawnActorDeferred<AActor>(associatedClass, spawnTransform, nullptr, nullptr, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+int32 ADISGameManager::PrewarmActorPool(TSubclassOf<AActor> EntityClass, int32 Count)
+{
+	if (!EntityClass || !GetWorld())
+	{
+		return 0;
+	}
 
-		FInitialDISConditions initialDISConditions = FInitialDISConditions(EntityStatePDUIn, true);
-		//Store the initial received ESPDU -- This gets used by the DISReceiveComponents later to set initial conditions when initializing themselves
-		InitialEntityConditions.Add(spawnedActor, initialDISConditions);
+	FDISActorPool& actorPool = ActorPools.FindOrAdd(EntityClass);
+	const int32 numberToSpawn = FMath::Min(Count, MaxPooledActorsPerClass - actorPool.InactiveActors.Num());
 
-		UGameplayStatics::FinishSpawningActor(spawnedActor, spawnTransform);
+	FActorSpawnParameters spawnParameters;
+	spawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
 
-		if (spawnedActor != nullptr)
+	int32 numberSpawned = 0;
+	for (; numberSpawned < numberToSpawn; numberSpawned++)
+	{
+		AActor* pooledActor = GetWorld()->SpawnActor<AActor>(EntityClass, FTransform::Identity, spawnParameters);
+		if (pooledActor == nullptr)
 		{
-			//Add actor to the map
-			AddDISEntityToMap(EntityStatePDUIn.EntityID, spawnedActor);
-			spawnedActor->OnDestroyed.AddDynamic(this, &ADISGameManager::HandleOnDISEntityDestroyed);
+			UE_LOG(LogDISGameManager, Warning, TEXT("Failed to spawn a pooled actor of class %s."), *EntityClass->GetName());
+			break;
+		}
 
-			//Get DIS Component of the newly spawned actor
-			UDISReceiveComponent* DISComponent = IDISInterface::Execute_GetActorDISReceiveComponent(spawnedActor);
+		pooledActor->OnDestroyed.AddUniqueDynamic(this, &ADISGameManager::HandleOnDISEntityDestroyed);
 
+		if (pooledActor->GetClass()->ImplementsInterface(UDISInterface::StaticClass()))
+		{
+			UDISReceiveComponent* DISComponent = IDISInterface::Execute_GetActorDISReceiveComponent(pooledActor);
 			if (DISComponent != nullptr)
 			{
-				DISComponent->HandleEntityStatePDU(EntityStatePDUIn);
+				DISComponent->OwningDISGameManager = this;
+				DISComponent->bPooledActor = true;
 			}
 		}
+
+		DeactivatePooledActor(pooledActor);
+		actorPool.InactiveActors.Add(pooledActor);
 	}
-	else
+
+	return numberSpawned;
+}
+
+int32 ADISGameManager::GetNumPooledActors(TSubclassOf<AActor> EntityClass) const
+{
+	const FDISActorPool* actorPool = ActorPools.Find(EntityClass);
+	return actorPool ? actorPool->InactiveActors.Num() : 0;
+}
+
+AActor* ADISGameManager::AcquirePooledActor(UClass* EntityClass)
+{
+	FDISActorPool* actorPool = ActorPools.Find(EntityClass);
+	if (actorPool == nullptr)
+	{
+		return nullptr;
+	}
+
+	//Skip over any actors that were destroyed while waiting in the pool
+	while (actorPool->InactiveActors.Num() > 0)
 	{
-		//Otherwise notify the user that no such mapping exists
-		UE_LOG(LogDISGameManager, Warning, TEXT("No mapping exists between an actor and the DIS enumeration of: %s"), *EntityStatePDUIn.EntityType.ToString());
+		AActor* pooledActor = actorPool->InactiveActors.Pop(false);
+		if (IsValid(pooledActor))
+		{
+			return pooledActor;
+		}
 	}
+
+	return nullptr;
 }
 
-UDISReceiveComponent* ADISGameManager::GetAssociatedDISComponent(FEntityID EntityIDIn)
+void ADISGameManager::ReuseEntityActor(AActor* PooledActor, const FTransform& SpawnTransform, const FEntityStatePDU& EntityStatePDUIn)
 {
-	SCOPE_CYCLE_COUNTER(STAT_GetAssociatedDISComponent);
-	UDISReceiveComponent* DISComponent = nullptr;
+	PooledActor->SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::TeleportPhysics);
+	PooledActor->SetActorHiddenInGame(false);
+	PooledActor->SetActorEnableCollision(true);
+	PooledActor->SetActorTickEnabled(true);
+
+	AddDISEntityToMap(EntityStatePDUIn.EntityID, PooledActor);
+
+	UDISReceiveComponent* DISComponent = EntityRegistry.FindComponent(EntityStatePDUIn.EntityID);
+	if (DISComponent != nullptr)
+	{
+		DISComponent->bPooledActor = true;
+		DISComponent->ResetForReuse(EntityStatePDUIn);
+	}
 
-	//Find associated actor in the DISActorMappings map
-	auto associatedActor = RawDISActorMappings.find(EntityIDIn);
-	if (associatedActor != RawDISActorMappings.end())
+	if (PooledActor->GetClass()->ImplementsInterface(UDISPoolableInterface::StaticClass()))
 	{
-		//If an actor was found, relay information to the associated component
-		DISComponent = IDISInterface::Execute_GetActorDISReceiveComponent(associatedActor->second);
+		IDISPoolableInterface::Execute_OnAcquiredFromPool(PooledActor);
 	}
 
-	return DISComponent;
+	if (DISComponent != nullptr)
+	{
+		DISComponent->HandleEntityStatePDU(EntityStatePDUIn);
+	}
+}
+
+void ADISGameManager::DeactivatePooledActor(AActor* PooledActor)
+{
+	PooledActor->SetLifeSpan(0);
+	PooledActor->SetActorHiddenInGame(true);
+	PooledActor->SetActorEnableCollision(false);
+	PooledActor->SetActorTickEnabled(false);
+}
+
+void ADISGameManager::HandlePrewarmClassLoaded(FSoftObjectPath EntityClassPath, int32 Count)
+{
+	UClass* loadedClass = Cast<UClass>(EntityClassPath.ResolveObject());
+	if (loadedClass == nullptr)
+	{
+		UE_LOG(LogDISGameManager, Warning, TEXT("Failed to load entity class %s. Its actor pool will not be prewarmed."), *EntityClassPath.ToString());
+		return;
+	}
+
+	PrewarmActorPool(loadedClass, Count);
+}
+
+void ADISGameManager::PrewarmConfiguredActorPools()
+{
+	for (const TPair<TSoftClassPtr<AActor>, int32>& prewarmCount : ActorPoolPrewarmCounts)
+	{
+		if (prewarmCount.Key.IsNull() || prewarmCount.Value <= 0)
+		{
+			continue;
+		}
+
+		if (LoadEntityClassesAsynchronously)
+		{
+			const FSoftObjectPath entityClassPath = prewarmCount.Key.ToSoftObjectPath();
+			ActorPoolPrewarmLoadHandles.Add(StreamableManager.RequestAsyncLoad(entityClassPath, FStreamableDelegate::CreateUObject(this, &ADISGameManager::HandlePrewarmClassLoaded, entityClassPath, prewarmCount.Value)));
+		}
+		else
+		{
+			PrewarmActorPool(prewarmCount.Key.LoadSynchronous(), prewarmCount.Value);
+		}
+	}
+}
+
+UDISReceiveComponent* ADISGameManager::GetAssociatedDISComponent(FEntityID EntityIDIn)
+{
+	SCOPE_CYCLE_COUNTER(STAT_GetAssociatedDISComponent);
+
+	//The DIS Receive Component is cached in the entity registry when the entity is added
+	return EntityRegistry.FindComponent(EntityIDIn);
 }
 
 bool ADISGameManager::AddDISEntityToMap(FEntityID EntityIDToAdd, AActor* EntityToAdd)
@@ -388,14 +1270,65 @@ bool ADISGameManager::AddDISEntityToMap(FEntityID EntityIDToAdd, AActor* EntityT
 	}
 
 	//Check to see if there is an associated actor for the entity ID already
-	auto associatedActor = RawDISActorMappings.find(EntityIDToAdd);
-	if (associatedActor != RawDISActorMappings.end())
+	AActor* associatedActor = EntityRegistry.FindActor(EntityIDToAdd);
+	if (associatedActor != nullptr)
+	{
+		UE_LOG(LogDISGameManager, Warning, TEXT("A DIS Entity ID mapping already exists for %s and is linked to %s. This entity ID will now point to: %s"), *EntityIDToAdd.ToString(), *associatedActor->GetFName().ToString(), *EntityToAdd->GetFName().ToString());
+	}
+	else
+	{
+		//A materialized headless entity is timed out through its DIS Receive Component from now on
+		EntityTimeouts.Cancel(EntityRegistry.FindHandle(EntityIDToAdd));
+	}
+
+	//Cache the DIS Receive Component so it does not need to be looked up through the DIS Interface for every PDU
+	UDISReceiveComponent* DISComponent = nullptr;
+	if (EntityToAdd->GetClass()->ImplementsInterface(UDISInterface::StaticClass()))
 	{
-		UE_LOG(LogDISGameManager, Warning, TEXT("A DIS Entity ID mapping already exists for %s and is linked to %s. This entity ID will now point to: %s"), *EntityIDToAdd.ToString(), *associatedActor->second->GetFName().ToString(), *EntityToAdd->GetFName().ToString());
+		DISComponent = IDISInterface::Execute_GetActorDISReceiveComponent(EntityToAdd);
 	}
 
-	DISActorMappings.Add(EntityIDToAdd, EntityToAdd);
-	RawDISActorMappings.insert_or_assign(EntityIDToAdd, EntityToAdd);
+	const FDISEntityHandle entityHandle = EntityRegistry.Add(EntityIDToAdd, EntityToAdd, DISComponent);
+
+	//The actor takes over from the entity's proxy, if it had one
+	ReleaseProxyInstance(EntityRegistry.FindIndex(entityHandle));
+
+	if (DISComponent != nullptr)
+	{
+		DISComponent->EntityHandle = entityHandle;
+		DISComponent->OwningDISGameManager = this;
+		UpdateEntityDeadReckoningState(DISComponent);
+
+		//Moving network entities should not pay for overlap updates nobody listens to
+		if (DisableEntityOverlapUpdates && DISComponent->SpawnedFromNetwork)
+		{
+			TInlineComponentArray<UPrimitiveComponent*> primitiveComponents(EntityToAdd);
+			for (UPrimitiveComponent* primitiveComponent : primitiveComponents)
+			{
+				primitiveComponent->SetGenerateOverlapEvents(false);
+			}
+		}
+
+		//Entities that already received a PDU move their timeout from the owner's life span to the timing wheel
+		if (EntityToAdd->GetLifeSpan() > 0)
+		{
+			EntityToAdd->SetLifeSpan(0);
+			RefreshEntityTimeout(DISComponent);
+		}
+	}
+	if (UseSignificanceManager)
+	{
+		//Replaced actors are registered again with the handle of their entity
+		UnregisterFromSignificanceManager(EntityToAdd);
+		RegisterWithSignificanceManager(EntityToAdd, entityHandle);
+	}
+	if (AreaOfInterest.IsValid())
+	{
+		//The entity is promoted from its lightweight record, if it had one
+		AreaOfInterest->RemoveOutOfAreaEntity(EntityIDToAdd);
+		AreaOfInterest->AddRegisteredEntity(EntityIDToAdd);
+	}
+	bDISActorMappingsDirty = true;
 
 	successful = true;
 	return successful;
@@ -403,7 +1336,762 @@ bool ADISGameManager::AddDISEntityToMap(FEntityID EntityIDToAdd, AActor* EntityT
 
 bool ADISGameManager::RemoveDISEntityFromMap(FEntityID EntityIDToRemove)
 {
-	DISActorMappings.Remove(EntityIDToRemove);
-	const int AmountRemoved = RawDISActorMappings.erase(EntityIDToRemove);
-	return (AmountRemoved > 0);
+	UDISReceiveComponent* DISComponent = EntityRegistry.FindComponent(EntityIDToRemove);
+	if (DISComponent != nullptr)
+	{
+		DISComponent->EntityHandle.Reset();
+		CancelQueuedEntityTransform(DISComponent);
+	}
+
+	AActor* entityActor = EntityRegistry.FindActor(EntityIDToRemove);
+	if (UseSignificanceManager && entityActor != nullptr)
+	{
+		UnregisterFromSignificanceManager(entityActor);
+	}
+
+	if (AreaOfInterest.IsValid())
+	{
+		AreaOfInterest->RemoveRegisteredEntity(EntityIDToRemove);
+	}
+
+	const FDISEntityHandle entityHandle = EntityRegistry.FindHandle(EntityIDToRemove);
+	EntityTimeouts.Cancel(entityHandle);
+	EntitySpatialIndex.Remove(entityHandle);
+	if (entityHandle.IsSet())
+	{
+		ReleaseProxyInstance(EntityRegistry.FindIndex(entityHandle));
+	}
+
+	const bool bRemoved = EntityRegistry.Remove(EntityIDToRemove);
+	bDISActorMappingsDirty |= bRemoved;
+	return bRemoved;
+}
+
+TArray<AActor*> ADISGameManager::GetEntitiesInRadius(FVector Location, float Radius) const
+{
+	TArray<AActor*> entitiesInRadius;
+
+	glm::dvec3 ecefLocation;
+	if (GetECEFLocation(Location, ecefLocation))
+	{
+		TArray<FDISEntityHandle> entityHandles;
+		EntitySpatialIndex.QueryRadius(ecefLocation, Radius / 100.0, entityHandles);
+		GetEntityActors(entityHandles, entitiesInRadius);
+	}
+
+	return entitiesInRadius;
+}
+
+TArray<FEntityID> ADISGameManager::GetEntityIDsInRadius(FVector Location, float Radius) const
+{
+	TArray<FEntityID> entityIDsInRadius;
+
+	glm::dvec3 ecefLocation;
+	if (GetECEFLocation(Location, ecefLocation))
+	{
+		TArray<FDISEntityHandle> entityHandles;
+		EntitySpatialIndex.QueryRadius(ecefLocation, Radius / 100.0, entityHandles);
+
+		entityIDsInRadius.Reserve(entityHandles.Num());
+		for (const FDISEntityHandle& entityHandle : entityHandles)
+		{
+			const int32 entityIndex = EntityRegistry.FindIndex(entityHandle);
+			if (entityIndex != INDEX_NONE)
+			{
+				entityIDsInRadius.Add(EntityRegistry.GetEntityID(entityIndex));
+			}
+		}
+	}
+
+	return entityIDsInRadius;
+}
+
+TArray<AActor*> ADISGameManager::GetEntitiesInBox(FBox Box) const
+{
+	TArray<AActor*> entitiesInBox;
+
+	if (!Box.IsValid)
+	{
+		return entitiesInBox;
+	}
+
+	//Query the ECEF bounds of the box's corners, then keep the entities whose actors are inside the box itself
+	glm::dvec3 ecefMin(TNumericLimits<double>::Max());
+	glm::dvec3 ecefMax(TNumericLimits<double>::Lowest());
+	for (int32 cornerIndex = 0; cornerIndex < 8; cornerIndex++)
+	{
+		const FVector corner((cornerIndex & 1) ? Box.Max.X : Box.Min.X, (cornerIndex & 2) ? Box.Max.Y : Box.Min.Y, (cornerIndex & 4) ? Box.Max.Z : Box.Min.Z);
+
+		glm::dvec3 ecefCorner;
+		if (!GetECEFLocation(corner, ecefCorner))
+		{
+			return entitiesInBox;
+		}
+		ecefMin = glm::min(ecefMin, ecefCorner);
+		ecefMax = glm::max(ecefMax, ecefCorner);
+	}
+
+	TArray<FDISEntityHandle> entityHandles;
+	EntitySpatialIndex.QueryBox(ecefMin, ecefMax, entityHandles);
+	GetEntityActors(entityHandles, entitiesInBox);
+
+	entitiesInBox.RemoveAllSwap([&Box](const AActor* EntityActor)
+	{
+		return !Box.IsInsideOrOn(EntityActor->GetActorLocation());
+	});
+
+	return entitiesInBox;
+}
+
+TArray<AActor*> ADISGameManager::GetNearestEntities(FVector Location, int32 Count, float MaxDistance) const
+{
+	TArray<AActor*> nearestEntities;
+
+	glm::dvec3 ecefLocation;
+	if (GetECEFLocation(Location, ecefLocation))
+	{
+		//Skip proxy and headless entities during the search so that they do not take the place of entities with actors
+		TArray<FDISEntityHandle> entityHandles;
+		EntitySpatialIndex.QueryNearest(ecefLocation, Count, MaxDistance / 100.0, [this](FDISEntityHandle EntityHandle)
+		{
+			const int32 entityIndex = EntityRegistry.FindIndex(EntityHandle);
+			return entityIndex != INDEX_NONE && IsValid(EntityRegistry.GetActor(entityIndex));
+		}, entityHandles);
+		GetEntityActors(entityHandles, nearestEntities);
+	}
+
+	return nearestEntities;
+}
+
+void ADISGameManager::UpdateAreaOfInterest()
+{
+	if (!EnableAreaOfInterest)
+	{
+		if (AreaOfInterest.IsValid())
+		{
+			SetAreaOfInterestPacketFilters(false);
+			AreaOfInterest.Reset();
+		}
+		return;
+	}
+
+	if (!AreaOfInterest.IsValid())
+	{
+		AreaOfInterest = MakeShared<FDISAreaOfInterest, ESPMode::ThreadSafe>();
+
+		//Entities registered before the area of interest was enabled keep receiving PDUs until they leave it
+		for (int32 entityIndex = 0; entityIndex < EntityRegistry.Num(); entityIndex++)
+		{
+			AreaOfInterest->AddRegisteredEntity(EntityRegistry.GetEntityID(entityIndex));
+		}
+	}
+
+	AreaOfInterest->SetExerciseID(ExerciseID);
+	AreaOfInterest->SetTrackOutOfAreaEntities(TrackOutOfAreaEntities);
+	AreaOfInterest->SetVolumes(AreaOfInterestPolygons, AreaOfInterestAltitudeBands, AreaOfInterestViewpointRadius);
+
+	if (AreaOfInterestViewpointRadius > 0)
+	{
+		TArray<FVector, TInlineAllocator<4>> viewpointECEFLocations;
+		GetViewpointECEFLocations(viewpointECEFLocations);
+		AreaOfInterest->SetViewpoints(viewpointECEFLocations);
+	}
+
+	SetAreaOfInterestPacketFilters(true);
+}
+
+void ADISGameManager::SetAreaOfInterestPacketFilters(bool bEnabled)
+{
+	UGameInstance* GameInstance = GetGameInstance();
+	UPDUProcessor* PDUProcessor = GameInstance ? GameInstance->GetSubsystem<UPDUProcessor>() : nullptr;
+	if (PDUProcessor == nullptr)
+	{
+		return;
+	}
+
+	if (!bEnabled)
+	{
+		PDUProcessor->SetPDUPacketFilter(EPDUType::EntityState, nullptr);
+		PDUProcessor->SetPDUPacketFilter(EPDUType::EntityStateUpdate, nullptr);
+		return;
+	}
+
+	//The filters hold their own reference so the area of interest outlives any packet still being filtered on a receive thread
+	TSharedRef<FDISAreaOfInterest, ESPMode::ThreadSafe> areaOfInterest = AreaOfInterest.ToSharedRef();
+	PDUProcessor->SetPDUPacketFilter(EPDUType::EntityState, [areaOfInterest](const TArray<uint8>& InData) { return areaOfInterest->FilterEntityStatePacket(InData); });
+	PDUProcessor->SetPDUPacketFilter(EPDUType::EntityStateUpdate, [areaOfInterest](const TArray<uint8>& InData) { return areaOfInterest->FilterEntityStateUpdatePacket(InData); });
+}
+
+bool ADISGameManager::RemoveIfOutsideAreaOfInterest(UDISReceiveComponent* DISComponent, const TArray<double>& ECEFLocation)
+{
+	//Only entities spawned from the network are removed, since actors placed in the level would not come back
+	if (!AreaOfInterest.IsValid() || !DISComponent->SpawnedFromNetwork || ECEFLocation.Num() < 3 || AreaOfInterest->IsRelevant(ECEFLocation.GetData()))
+	{
+		return false;
+	}
+
+	UE_LOG(LogDISGameManager, Verbose, TEXT("%s left the area of interest, removing entity..."), *DISComponent->EntityID.ToString());
+
+	if (TrackOutOfAreaEntities)
+	{
+		AreaOfInterest->UpdateOutOfAreaEntity(DISComponent->EntityID, &DISComponent->EntityType, ECEFLocation.GetData());
+	}
+	DISComponent->RemoveEntity();
+
+	return true;
+}
+
+TArray<FDISOutOfAreaEntity> ADISGameManager::GetOutOfAreaEntities() const
+{
+	TArray<FDISOutOfAreaEntity> outOfAreaEntities;
+	if (AreaOfInterest.IsValid())
+	{
+		AreaOfInterest->GetOutOfAreaEntities(outOfAreaEntities);
+	}
+	return outOfAreaEntities;
+}
+
+int32 ADISGameManager::GetNumOutOfAreaEntities() const
+{
+	return AreaOfInterest.IsValid() ? AreaOfInterest->GetNumOutOfAreaEntities() : 0;
+}
+
+FDISEntityHandle ADISGameManager::AddHeadlessEntity(const FEntityStatePDU& EntityStatePDUIn, bool bPerformDeadReckoning)
+{
+	const FDISEntityHandle entityHandle = EntityRegistry.Add(EntityStatePDUIn.EntityID, nullptr, nullptr);
+	const int32 entityIndex = EntityRegistry.FindIndex(entityHandle);
+
+	FDISDeadReckoningParameters& parameters = EntityRegistry.GetDeadReckoningParameters(entityIndex);
+	parameters.bPerformDeadReckoning = bPerformDeadReckoning;
+
+	if (AreaOfInterest.IsValid())
+	{
+		AreaOfInterest->RemoveOutOfAreaEntity(EntityStatePDUIn.EntityID);
+		AreaOfInterest->AddRegisteredEntity(EntityStatePDUIn.EntityID);
+	}
+
+	EntityTimeouts.Schedule(entityHandle, GetWorld()->GetTimeSeconds(), GetEntityTimeoutSeconds(EntityStatePDUIn.EntityType, HeadlessEntityTimeoutSeconds));
+
+	EntityRegistry.GetReceivedEntityState(entityIndex).FromEntityStatePDU(EntityStatePDUIn);
+	UpdateHeadlessEntity(entityIndex);
+
+	return entityHandle;
+}
+
+bool ADISGameManager::UpdateHeadlessEntity(int32 EntityIndex)
+{
+	const FDISEntityState& receivedEntityState = EntityRegistry.GetReceivedEntityState(EntityIndex);
+
+	//Check if the entity has been deactivated -- Entity is deactivated if the 23rd bit of the Entity Appearance value is set
+	if (receivedEntityState.EntityAppearance.IsDeactivated)
+	{
+		UE_LOG(LogDISGameManager, Verbose, TEXT("Headless entity %s Entity Appearance is set to deactivated, removing entity..."), *receivedEntityState.EntityID.ToString());
+		RemoveHeadlessEntity(receivedEntityState.EntityID);
+		return false;
+	}
+
+	if (AreaOfInterest.IsValid() && !AreaOfInterest->IsRelevant(receivedEntityState.EntityLocation))
+	{
+		UE_LOG(LogDISGameManager, Verbose, TEXT("Headless entity %s left the area of interest, removing entity..."), *receivedEntityState.EntityID.ToString());
+		if (TrackOutOfAreaEntities)
+		{
+			AreaOfInterest->UpdateOutOfAreaEntity(receivedEntityState.EntityID, &receivedEntityState.EntityType, receivedEntityState.EntityLocation);
+		}
+		RemoveHeadlessEntity(receivedEntityState.EntityID);
+		return false;
+	}
+
+	//Dead reckoning restarts from the new state, without smoothing as nothing is displayed
+	EntityRegistry.GetDeadReckonedEntityState(EntityIndex) = receivedEntityState;
+	EntityRegistry.PrecomputeDeadReckoningKernel(EntityIndex);
+
+	FDISDeadReckoningParameters& parameters = EntityRegistry.GetDeadReckoningParameters(EntityIndex);
+	parameters.TimeSinceLastUpdate = GetTimestampAge(receivedEntityState.EntityID, receivedEntityState.Timestamp);
+	parameters.bForceLODUpdate = true;
+	if (UseInterpolationBuffer)
+	{
+		EntityRegistry.PushInterpolationSample(EntityIndex);
+	}
+
+	const FDISEntityHandle entityHandle = EntityRegistry.GetHandle(EntityIndex);
+	EntitySpatialIndex.Update(entityHandle, glm::dvec3(receivedEntityState.EntityLocation[0], receivedEntityState.EntityLocation[1], receivedEntityState.EntityLocation[2]));
+	EntityTimeouts.Refresh(entityHandle, GetWorld()->GetTimeSeconds());
+
+	//A materialized entity waiting in the spawn queue spawns with the latest state
+	if (FPendingEntitySpawn* pendingEntitySpawn = PendingEntitySpawns.Find(receivedEntityState.EntityID))
+	{
+		pendingEntitySpawn->EntityState = receivedEntityState;
+	}
+
+	return true;
+}
+
+void ADISGameManager::RemoveHeadlessEntity(const FEntityID& EntityID)
+{
+	PendingEntitySpawns.Remove(EntityID);
+	RemoveDISEntityFromMap(EntityID);
+}
+
+bool ADISGameManager::GetEntityState(FEntityID EntityID, FEntityStatePDU& EntityStatePDUOut) const
+{
+	const FDISEntityState* deadReckonedEntityState = FindDeadReckonedEntityState(EntityID);
+	if (deadReckonedEntityState == nullptr)
+	{
+		return false;
+	}
+
+	deadReckonedEntityState->ToEntityStatePDU(EntityStatePDUOut);
+	return true;
+}
+
+TArray<FEntityID> ADISGameManager::GetEntityIDs() const
+{
+	TArray<FEntityID> entityIDs;
+	entityIDs.Reserve(EntityRegistry.Num());
+	for (int32 entityIndex = 0; entityIndex < EntityRegistry.Num(); entityIndex++)
+	{
+		entityIDs.Add(EntityRegistry.GetEntityID(entityIndex));
+	}
+	return entityIDs;
+}
+
+bool ADISGameManager::IsEntityHeadless(FEntityID EntityID) const
+{
+	const int32 entityIndex = EntityRegistry.FindIndex(EntityID);
+	return entityIndex != INDEX_NONE && EntityRegistry.IsHeadless(entityIndex);
+}
+
+bool ADISGameManager::MaterializeEntity(FEntityID EntityID)
+{
+	const int32 entityIndex = EntityRegistry.FindIndex(EntityID);
+	if (entityIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	if (!EntityRegistry.IsHeadless(entityIndex) || PendingEntitySpawns.Contains(EntityID))
+	{
+		return true;
+	}
+
+	//Spawn from the dead reckoned state so the actor starts where the entity is now rather than where it was last reported
+	FEntityStatePDU entityStatePDU;
+	EntityRegistry.GetDeadReckonedEntityState(entityIndex).ToEntityStatePDU(entityStatePDU);
+	SpawnNewEntityFromEntityState(entityStatePDU);
+
+	return PendingEntitySpawns.Contains(EntityID);
+}
+
+bool ADISGameManager::IsEntityDormant(FEntityID EntityID) const
+{
+	const int32 entityIndex = EntityRegistry.FindIndex(EntityID);
+	return entityIndex != INDEX_NONE && EntityRegistry.GetDeadReckoningParameters(entityIndex).bDormant;
+}
+
+bool ADISGameManager::WakeEntity(FEntityID EntityID)
+{
+	const int32 entityIndex = EntityRegistry.FindIndex(EntityID);
+	if (entityIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	FDISDeadReckoningParameters& parameters = EntityRegistry.GetDeadReckoningParameters(entityIndex);
+	parameters.bDormant = false;
+	parameters.bForceLODUpdate = true;
+	return true;
+}
+
+float ADISGameManager::GetTimestampAge(const FEntityID& SenderID, uint32 Timestamp)
+{
+	if (!EnableTimestampCompensation)
+	{
+		return 0;
+	}
+
+	return TimestampClock.GetTimestampAge(SenderID, Timestamp);
+}
+
+void ADISGameManager::SetMaxTimestampCompensationSeconds(float MaxSeconds)
+{
+	MaxTimestampCompensationSeconds = FMath::Max(MaxSeconds, 0.0f);
+	TimestampClock.SetMaxAge(MaxTimestampCompensationSeconds);
+}
+
+bool ADISGameManager::AddProxyEntity(const FEntityStatePDU& EntityStatePDUIn)
+{
+	if (EnableHeadlessMode || !IsValid(GeoReferencingSystem) || ProxyViewpointECEFLocations.Num() == 0 || EntityStatePDUIn.EntityLocationDouble.Num() < 3)
+	{
+		return false;
+	}
+
+	//Entities within the proxy distance are spawned as actors right away
+	if (GetClosestProxyViewpointDistanceSquared(EntityStatePDUIn.EntityLocationDouble.GetData()) <= FMath::Square(ProxyDistance / 100.0))
+	{
+		return false;
+	}
+
+	bool bPending;
+	const int32 batchIndex = ResolveProxyMeshBatch(EntityStatePDUIn.EntityType, bPending);
+	if (batchIndex == INDEX_NONE)
+	{
+		return false;
+	}
+
+	//Proxies are always dead reckoned so that their instances keep moving
+	const int32 entityIndex = EntityRegistry.FindIndex(AddHeadlessEntity(EntityStatePDUIn, true));
+	if (entityIndex != INDEX_NONE)
+	{
+		FDISProxyInstance& proxyInstance = EntityRegistry.GetProxyInstance(entityIndex);
+		proxyInstance.BatchIndex = batchIndex;
+		proxyInstance.bBatchResolved = true;
+		AcquireProxyInstance(entityIndex, batchIndex);
+	}
+
+	return true;
+}
+
+void ADISGameManager::UpdateProxyEntities()
+{
+	if (!EnableProxyEntities || EnableHeadlessMode || !IsValid(GeoReferencingSystem))
+	{
+		return;
+	}
+
+	SCOPE_CYCLE_COUNTER(STAT_UpdateProxyEntities);
+
+	ProxyViewpointECEFLocations.Reset();
+	GetViewpointECEFLocations(ProxyViewpointECEFLocations);
+
+	//Without a viewpoint there is nothing to measure distance from, so entities keep their current representation
+	const bool bHasViewpoints = ProxyViewpointECEFLocations.Num() > 0;
+	const double promoteDistanceSquared = FMath::Square(ProxyDistance / 100.0);
+	const double demoteDistanceSquared = FMath::Square((ProxyDistance + ProxyHysteresisDistance) / 100.0);
+
+	ProxyEntitiesToPromote.Reset();
+	ProxyEntitiesToDemote.Reset();
+
+	for (int32 entityIndex = 0; entityIndex < EntityRegistry.Num(); entityIndex++)
+	{
+		const FDISProxyInstance& proxyInstance = EntityRegistry.GetProxyInstance(entityIndex);
+		if (!proxyInstance.IsProxy() && EntityRegistry.IsHeadless(entityIndex))
+		{
+			continue;
+		}
+
+		const double distanceSquared = bHasViewpoints ? GetClosestProxyViewpointDistanceSquared(EntityRegistry.GetDeadReckonedEntityState(entityIndex).EntityLocation) : 0;
+
+		if (proxyInstance.IsProxy())
+		{
+			if (bHasViewpoints && distanceSquared <= promoteDistanceSquared)
+			{
+				ProxyEntitiesToPromote.Add(EntityRegistry.GetEntityID(entityIndex));
+			}
+
+			//Instances are only moved when the dead reckoning pass updated the entity, so proxies move at the update rate of their level of detail tier
+			if (EntityRegistry.GetDeadReckoningParameters(entityIndex).bUpdated)
+			{
+				FDISProxyMeshBatch& batch = ProxyMeshBatches[proxyInstance.BatchIndex];
+				batch.InstancedMesh->UpdateInstanceTransform(proxyInstance.InstanceIndex, GetProxyInstanceTransform(entityIndex), true, false, true);
+				batch.bRenderStateDirty = true;
+			}
+		}
+		else if (bHasViewpoints && distanceSquared > demoteDistanceSquared)
+		{
+			//Only network entities are demoted, since actors placed in the level would not come back
+			const UDISReceiveComponent* DISComponent = EntityRegistry.GetComponent(entityIndex);
+			if (DISComponent != nullptr && DISComponent->SpawnedFromNetwork && GetProxyMeshBatch(entityIndex) != INDEX_NONE)
+			{
+				ProxyEntitiesToDemote.Add(EntityRegistry.GetEntityID(entityIndex));
+			}
+		}
+	}
+
+	//Promoted proxies keep being drawn until their actor spawns and takes over
+	for (const FEntityID& entityID : ProxyEntitiesToPromote)
+	{
+		MaterializeEntity(entityID);
+	}
+
+	//Releasing actors runs user code, so look each entity back up
+	for (const FEntityID& entityID : ProxyEntitiesToDemote)
+	{
+		const int32 entityIndex = EntityRegistry.FindIndex(entityID);
+		if (entityIndex != INDEX_NONE && !EntityRegistry.IsHeadless(entityIndex))
+		{
+			DemoteEntityToProxy(entityIndex, GetProxyMeshBatch(entityIndex));
+		}
+	}
+
+	//Every instance change this frame is sent to the renderer in a single update per batch
+	for (FDISProxyMeshBatch& batch : ProxyMeshBatches)
+	{
+		if (batch.bRenderStateDirty && IsValid(batch.InstancedMesh))
+		{
+			batch.InstancedMesh->MarkRenderStateDirty();
+		}
+		batch.bRenderStateDirty = false;
+	}
+}
+
+int32 ADISGameManager::ResolveProxyMeshBatch(const FEntityType& EntityType, bool& bOutPending)
+{
+	bOutPending = false;
+
+	const TSoftObjectPtr<UStaticMesh>* proxyMesh = EntityTypeResolver.ResolveProxyMesh(EntityType);
+	if (proxyMesh == nullptr)
+	{
+		return INDEX_NONE;
+	}
+
+	const FSoftObjectPath proxyMeshPath = proxyMesh->ToSoftObjectPath();
+	if (const int32* batchIndex = ProxyMeshBatchIndices.Find(proxyMeshPath))
+	{
+		return *batchIndex;
+	}
+
+	UStaticMesh* loadedProxyMesh = proxyMesh->Get();
+	if (loadedProxyMesh == nullptr)
+	{
+		TSharedPtr<FStreamableHandle>& loadHandle = ProxyMeshLoadHandles.FindOrAdd(proxyMeshPath);
+		if (!loadHandle.IsValid())
+		{
+			loadHandle = StreamableManager.RequestAsyncLoad(proxyMeshPath);
+		}
+
+		if (!loadHandle.IsValid() || loadHandle->HasLoadCompleted())
+		{
+			UE_LOG(LogDISGameManager, Warning, TEXT("Failed to load proxy mesh %s. Entities mapped to it will be spawned as actors."), *proxyMeshPath.ToString());
+			ProxyMeshBatchIndices.Add(proxyMeshPath, INDEX_NONE);
+			return INDEX_NONE;
+		}
+
+		bOutPending = true;
+		return INDEX_NONE;
+	}
+
+	if (!IsValid(ProxyMeshActor))
+	{
+		FActorSpawnParameters spawnParameters;
+		spawnParameters.Owner = this;
+		spawnParameters.ObjectFlags |= RF_Transient;
+		ProxyMeshActor = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, spawnParameters);
+
+		USceneComponent* proxyRoot = NewObject<USceneComponent>(ProxyMeshActor, TEXT("ProxyRoot"));
+		ProxyMeshActor->SetRootComponent(proxyRoot);
+		proxyRoot->RegisterComponent();
+	}
+
+	UHierarchicalInstancedStaticMeshComponent* instancedMesh = NewObject<UHierarchicalInstancedStaticMeshComponent>(ProxyMeshActor);
+	instancedMesh->SetStaticMesh(loadedProxyMesh);
+	instancedMesh->SetMobility(EComponentMobility::Movable);
+	instancedMesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	instancedMesh->SetCanEverAffectNavigation(false);
+	instancedMesh->SetupAttachment(ProxyMeshActor->GetRootComponent());
+	instancedMesh->RegisterComponent();
+	ProxyMeshActor->AddInstanceComponent(instancedMesh);
+
+	const int32 batchIndex = ProxyMeshBatches.AddDefaulted();
+	ProxyMeshBatches[batchIndex].InstancedMesh = instancedMesh;
+	ProxyMeshBatchIndices.Add(proxyMeshPath, batchIndex);
+
+	return batchIndex;
+}
+
+int32 ADISGameManager::GetProxyMeshBatch(int32 EntityIndex)
+{
+	FDISProxyInstance& proxyInstance = EntityRegistry.GetProxyInstance(EntityIndex);
+	if (!proxyInstance.bBatchResolved)
+	{
+		bool bPending;
+		proxyInstance.BatchIndex = ResolveProxyMeshBatch(EntityRegistry.GetReceivedEntityState(EntityIndex).EntityType, bPending);
+		proxyInstance.bBatchResolved = !bPending;
+	}
+
+	return proxyInstance.BatchIndex;
+}
+
+void ADISGameManager::AcquireProxyInstance(int32 EntityIndex, int32 BatchIndex)
+{
+	FDISProxyMeshBatch& batch = ProxyMeshBatches[BatchIndex];
+	FDISProxyInstance& proxyInstance = EntityRegistry.GetProxyInstance(EntityIndex);
+	const FTransform instanceTransform = GetProxyInstanceTransform(EntityIndex);
+
+	if (batch.FreeInstances.Num() > 0)
+	{
+		proxyInstance.InstanceIndex = batch.FreeInstances.Pop(false);
+		batch.InstancedMesh->UpdateInstanceTransform(proxyInstance.InstanceIndex, instanceTransform, true, false, true);
+		batch.bRenderStateDirty = true;
+	}
+	else
+	{
+		proxyInstance.InstanceIndex = batch.InstancedMesh->AddInstanceWorldSpace(instanceTransform);
+	}
+
+	proxyInstance.BatchIndex = BatchIndex;
+	NumProxyEntities++;
+}
+
+void ADISGameManager::ReleaseProxyInstance(int32 EntityIndex)
+{
+	if (EntityIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	FDISProxyInstance& proxyInstance = EntityRegistry.GetProxyInstance(EntityIndex);
+	if (!proxyInstance.IsProxy())
+	{
+		return;
+	}
+
+	//Hide the instance at zero scale until it is reused, rather than removing it and shifting the indices of other instances
+	if (ProxyMeshBatches.IsValidIndex(proxyInstance.BatchIndex) && IsValid(ProxyMeshBatches[proxyInstance.BatchIndex].InstancedMesh))
+	{
+		FDISProxyMeshBatch& batch = ProxyMeshBatches[proxyInstance.BatchIndex];
+		batch.InstancedMesh->UpdateInstanceTransform(proxyInstance.InstanceIndex, FTransform(FQuat::Identity, FVector::ZeroVector, FVector::ZeroVector), true, false, true);
+		batch.FreeInstances.Add(proxyInstance.InstanceIndex);
+		batch.bRenderStateDirty = true;
+	}
+
+	proxyInstance.InstanceIndex = INDEX_NONE;
+	NumProxyEntities--;
+}
+
+FTransform ADISGameManager::GetProxyInstanceTransform(int32 EntityIndex)
+{
+	EntityRegistry.GetDeadReckonedEntityState(EntityIndex).CopyKinematicsToEntityStatePDU(ProxyEntityStatePDU);
+
+	FVector instanceLocation;
+	FRotator instanceRotation;
+	UDIS_BPFL::GetUnrealLocationAndOrientationFromEntityStatePdu(ProxyEntityStatePDU, GeoReferencingSystem, instanceLocation, instanceRotation);
+
+	return FTransform(instanceRotation, instanceLocation);
+}
+
+void ADISGameManager::DemoteEntityToProxy(int32 EntityIndex, int32 BatchIndex)
+{
+	const FEntityID entityID = EntityRegistry.GetEntityID(EntityIndex);
+	AActor* entityActor = EntityRegistry.GetActor(EntityIndex);
+	UDISReceiveComponent* DISComponent = EntityRegistry.GetComponent(EntityIndex);
+
+	UE_LOG(LogDISGameManager, Verbose, TEXT("%s moved beyond the proxy distance, replacing its actor with a proxy..."), *entityID.ToString());
+
+	//Detach the actor from the registry entry first so that releasing it keeps the entity registered. The entity's timeout keeps running under the same handle.
+	if (UseSignificanceManager)
+	{
+		UnregisterFromSignificanceManager(entityActor);
+	}
+	EntityRegistry.Add(entityID, nullptr, nullptr);
+	DISComponent->EntityHandle.Reset();
+	CancelQueuedEntityTransform(DISComponent);
+	bDISActorMappingsDirty = true;
+
+	//Keep dead reckoning from the most recently received state. Smoothing and culling only apply to actors.
+	FDISDeadReckoningParameters& parameters = EntityRegistry.GetDeadReckoningParameters(EntityIndex);
+	parameters.bPerformDeadReckoning = true;
+	parameters.bPerformSmoothing = false;
+	parameters.bCullDeadReckoning = false;
+	parameters.SignificanceLODTier = INDEX_NONE;
+	parameters.bForceLODUpdate = true;
+	parameters.bDormant = false;
+
+	AcquireProxyInstance(EntityIndex, BatchIndex);
+
+	ReleaseEntityActor(entityActor);
+}
+
+void ADISGameManager::PromoteProxyEntity(const FEntityID& EntityID)
+{
+	const int32 entityIndex = EntityRegistry.FindIndex(EntityID);
+	if (entityIndex != INDEX_NONE && EntityRegistry.GetProxyInstance(entityIndex).IsProxy())
+	{
+		MaterializeEntity(EntityID);
+	}
+}
+
+double ADISGameManager::GetClosestProxyViewpointDistanceSquared(const double ECEFLocation[3]) const
+{
+	double closestDistanceSquared = TNumericLimits<double>::Max();
+	for (const FVector& viewpointECEFLocation : ProxyViewpointECEFLocations)
+	{
+		const double deltaX = ECEFLocation[0] - viewpointECEFLocation.X;
+		const double deltaY = ECEFLocation[1] - viewpointECEFLocation.Y;
+		const double deltaZ = ECEFLocation[2] - viewpointECEFLocation.Z;
+		closestDistanceSquared = FMath::Min(closestDistanceSquared, deltaX * deltaX + deltaY * deltaY + deltaZ * deltaZ);
+	}
+	return closestDistanceSquared;
+}
+
+bool ADISGameManager::IsEntityProxy(FEntityID EntityID) const
+{
+	const int32 entityIndex = EntityRegistry.FindIndex(EntityID);
+	return entityIndex != INDEX_NONE && EntityRegistry.GetProxyInstance(entityIndex).IsProxy();
+}
+
+const FDISEntityState* ADISGameManager::FindReceivedEntityState(const FEntityID& EntityID) const
+{
+	const int32 entityIndex = EntityRegistry.FindIndex(EntityID);
+	return entityIndex != INDEX_NONE ? &EntityRegistry.GetReceivedEntityState(entityIndex) : nullptr;
+}
+
+const FDISEntityState* ADISGameManager::FindDeadReckonedEntityState(const FEntityID& EntityID) const
+{
+	const int32 entityIndex = EntityRegistry.FindIndex(EntityID);
+	return entityIndex != INDEX_NONE ? &EntityRegistry.GetDeadReckonedEntityState(entityIndex) : nullptr;
+}
+
+bool ADISGameManager::GetECEFLocation(const FVector& UnrealLocation, glm::dvec3& OutECEFLocation) const
+{
+	if (!IsValid(GeoReferencingSystem))
+	{
+		UE_LOG(LogDISGameManager, Warning, TEXT("Spatial queries need a GeoReferencing System in the level to convert Unreal locations to ECEF."));
+		return false;
+	}
+
+	FCartesianCoordinates ecefLocation;
+	GeoReferencingSystem->EngineToECEF(UnrealLocation, ecefLocation);
+	OutECEFLocation = glm::dvec3(ecefLocation.X, ecefLocation.Y, ecefLocation.Z);
+	return true;
+}
+
+void ADISGameManager::GetEntityActors(TArrayView<const FDISEntityHandle> EntityHandles, TArray<AActor*>& OutActors) const
+{
+	OutActors.Reserve(OutActors.Num() + EntityHandles.Num());
+	for (const FDISEntityHandle& entityHandle : EntityHandles)
+	{
+		const int32 entityIndex = EntityRegistry.FindIndex(entityHandle);
+		AActor* entityActor = entityIndex != INDEX_NONE ? EntityRegistry.GetActor(entityIndex) : nullptr;
+		if (IsValid(entityActor))
+		{
+			OutActors.Add(entityActor);
+		}
+	}
+}
+
+const TMap<FEntityID, AActor*>& ADISGameManager::GetDISActorMappings() const
+{
+	if (bDISActorMappingsDirty)
+	{
+		CachedDISActorMappings.Reset();
+		CachedDISActorMappings.Reserve(EntityRegistry.Num());
+		for (int32 entityIndex = 0; entityIndex < EntityRegistry.Num(); entityIndex++)
+		{
+			if (!EntityRegistry.IsHeadless(entityIndex))
+			{
+				CachedDISActorMappings.Add(EntityRegistry.GetEntityID(entityIndex), EntityRegistry.GetActor(entityIndex));
+			}
+		}
+		bDISActorMappingsDirty = false;
+	}
+
+	return CachedDISActorMappings;
+}
+
+void ADISGameManager::AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector)
+{
+	ADISGameManager* This = CastChecked<ADISGameManager>(InThis);
+	This->EntityRegistry.AddReferencedObjects(Collector, This);
+
+	Super::AddReferencedObjects(InThis, Collector);
 }
\ No newline at end of file
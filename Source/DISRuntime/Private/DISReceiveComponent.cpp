@@ -4,14 +4,85 @@
 
 #include "DeadReckoning_BPFL.h"
 #include "DISGameManager.h"
+#include "DISTerrainHeightField.h"
 #include "CollisionQueryParams.h"
 #include "Camera/PlayerCameraManager.h"
 #include "Engine/World.h"
+#include "TimerManager.h"
 #include "GameFramework/PlayerController.h"
 #include "Kismet/KismetMathLibrary.h"
 
 DEFINE_LOG_CATEGORY(LogDISReceiveComponent);
 
+namespace
+{
+	/**
+	 * Copies the fields of an Entity State PDU that are not heap allocated, along with the location and dead reckoning parameters, which reuse their allocation.
+	 * The articulation parameters and marking are only copied when they changed.
+	 */
+	void CopyEntityStatePDU(const FEntityStatePDU& Source, uint8 StateChanges, FEntityStatePDU& Destination)
+	{
+		Destination.ProtocolVersion = Source.ProtocolVersion;
+		Destination.ExerciseID = Source.ExerciseID;
+		Destination.PduType = Source.PduType;
+		Destination.ProtocolFamily = Source.ProtocolFamily;
+		Destination.Timestamp = Source.Timestamp;
+		Destination.Length = Source.Length;
+		Destination.Padding = Source.Padding;
+
+		Destination.EntityID = Source.EntityID;
+		Destination.ForceID = Source.ForceID;
+		Destination.EntityLocationDouble.SetNumUninitialized(Source.EntityLocationDouble.Num());
+		FMemory::Memcpy(Destination.EntityLocationDouble.GetData(), Source.EntityLocationDouble.GetData(), Source.EntityLocationDouble.Num() * sizeof(double));
+		Destination.EntityLocation = Source.EntityLocation;
+		Destination.EntityOrientation = Source.EntityOrientation;
+		Destination.EntityLinearVelocity = Source.EntityLinearVelocity;
+		Destination.EntityType = Source.EntityType;
+		Destination.EntityAppearance = Source.EntityAppearance;
+		Destination.Capabilities = Source.Capabilities;
+		Destination.AlternativeEntityType = Source.AlternativeEntityType;
+
+		Destination.DeadReckoningParameters.DeadReckoningAlgorithm = Source.DeadReckoningParameters.DeadReckoningAlgorithm;
+		Destination.DeadReckoningParameters.OtherParameters.SetNumUninitialized(Source.DeadReckoningParameters.OtherParameters.Num());
+		FMemory::Memcpy(Destination.DeadReckoningParameters.OtherParameters.GetData(), Source.DeadReckoningParameters.OtherParameters.GetData(), Source.DeadReckoningParameters.OtherParameters.Num());
+		Destination.DeadReckoningParameters.EntityLinearAcceleration = Source.DeadReckoningParameters.EntityLinearAcceleration;
+		Destination.DeadReckoningParameters.EntityAngularVelocity = Source.DeadReckoningParameters.EntityAngularVelocity;
+
+		if (StateChanges & FDISEntityState::CHANGED_MARKING)
+		{
+			Destination.Marking = Source.Marking;
+		}
+		if (StateChanges & FDISEntityState::CHANGED_ARTICULATION)
+		{
+			Destination.ArticulationParameters = Source.ArticulationParameters;
+		}
+	}
+
+	/** Copies the fields carried by an Entity State Update PDU into an Entity State PDU. The articulation parameters are only copied when they changed. */
+	void CopyEntityStateUpdatePDU(const FEntityStateUpdatePDU& Source, uint8 StateChanges, FEntityStatePDU& Destination)
+	{
+		Destination.ProtocolVersion = Source.ProtocolVersion;
+		Destination.ExerciseID = Source.ExerciseID;
+		Destination.ProtocolFamily = Source.ProtocolFamily;
+		Destination.Timestamp = Source.Timestamp;
+		Destination.Length = Source.Length;
+		Destination.Padding = Source.Padding;
+
+		Destination.EntityID = Source.EntityID;
+		Destination.EntityLocationDouble.SetNumUninitialized(Source.EntityLocationDouble.Num());
+		FMemory::Memcpy(Destination.EntityLocationDouble.GetData(), Source.EntityLocationDouble.GetData(), Source.EntityLocationDouble.Num() * sizeof(double));
+		Destination.EntityLocation = Source.EntityLocation;
+		Destination.EntityOrientation = Source.EntityOrientation;
+		Destination.EntityLinearVelocity = Source.EntityLinearVelocity;
+		Destination.EntityAppearance = Source.EntityAppearance;
+
+		if (StateChanges & FDISEntityState::CHANGED_ARTICULATION)
+		{
+			Destination.ArticulationParameters = Source.ArticulationParameters;
+		}
+	}
+}
+
 // Sets default values for this component's properties
 UDISReceiveComponent::UDISReceiveComponent()
 {
@@ -26,27 +97,83 @@ void UDISReceiveComponent::InitializeComponent()
 
 	ADISGameManager* DISGameManager = ADISGameManager::GetDISGameManager(Cast<UObject>(GetWorld()));
 
-	EntityECEFLocationDifference.Init(0, 3);
-
 	if (IsValid(DISGameManager))
 	{
 		auto const* FoundInitConditions = DISGameManager->InitialEntityConditions.Find(GetOwner());
 		if (FoundInitConditions)
 		{
-			FInitialDISConditions initDISConditions = *FoundInitConditions;
-			SpawnedFromNetwork = initDISConditions.SpawnedFromNetwork;
-
-			UpdateCommonEntityStateInfo(initDISConditions.EntityStatePDU);
-
-			EntityType = initDISConditions.EntityStatePDU.EntityType;
-			EntityForceID = initDISConditions.EntityStatePDU.ForceID;
-			EntityMarking = initDISConditions.EntityStatePDU.Marking;
+			ApplyInitialEntityState(FoundInitConditions->EntityStatePDU, FoundInitConditions->SpawnedFromNetwork);
 
 			DISGameManager->InitialEntityConditions.Remove(GetOwner());
 		}
 	}
 }
 
+void UDISReceiveComponent::ResetForReuse(const FEntityStatePDU& InitialEntityStatePDU)
+{
+	//Clear everything left over from the previous entity so it does not leak into smoothing or dead reckoning of the new one
+	MostRecentEntityState = FDISEntityState();
+	MostRecentDeadReckonedEntityState = FDISEntityState();
+	MostRecentEntityStatePDU = FEntityStatePDU();
+	MostRecentDeadReckonedEntityStatePDU = FEntityStatePDU();
+	EntityECEFLocationDifference[0] = 0;
+	EntityECEFLocationDifference[1] = 0;
+	EntityECEFLocationDifference[2] = 0;
+	EntityRotationDifference = FRotator::ZeroRotator;
+	DeltaTimeSinceLastPDU = 0;
+	NumberEntityStatePDUsReceived = 0;
+	ResetGroundClamp();
+
+	ApplyInitialEntityState(InitialEntityStatePDU, true);
+}
+
+void UDISReceiveComponent::ApplyInitialEntityState(const FEntityStatePDU& InitialEntityStatePDU, bool bSpawnedFromNetwork)
+{
+	SpawnedFromNetwork = bSpawnedFromNetwork;
+
+	UpdateCommonEntityStateInfo(InitialEntityStatePDU);
+
+	EntityType = InitialEntityStatePDU.EntityType;
+	EntityForceID = InitialEntityStatePDU.ForceID;
+	EntityMarking = InitialEntityStatePDU.Marking;
+}
+
+void UDISReceiveComponent::RemoveEntity()
+{
+	ADISGameManager* DISGameManager = OwningDISGameManager.Get();
+	if (bPooledActor && DISGameManager != nullptr)
+	{
+		DISGameManager->ReleaseEntityActor(GetOwner());
+	}
+	else
+	{
+		GetOwner()->Destroy();
+	}
+}
+
+void UDISReceiveComponent::PrepareForPool()
+{
+	EntityHandle.Reset();
+}
+
+void UDISReceiveComponent::ResetTimeout()
+{
+	//Registered entities time out through the DIS Game Manager, which only needs to store the new deadline
+	ADISGameManager* DISGameManager = OwningDISGameManager.Get();
+	if (DISGameManager != nullptr && DISGameManager->RefreshEntityTimeout(this))
+	{
+		return;
+	}
+
+	GetOwner()->SetLifeSpan(DISTimeoutSeconds);
+}
+
+void UDISReceiveComponent::HandleEntityTimedOut()
+{
+	UE_LOG(LogDISReceiveComponent, Log, TEXT("%s has not received an Entity State PDU in %f seconds, removing entity..."), *EntityID.ToString(), DISTimeoutSeconds);
+	RemoveEntity();
+}
+
 // Called when the game starts
 void UDISReceiveComponent::BeginPlay()
 {
@@ -61,23 +188,34 @@ void UDISReceiveComponent::TickComponent(float DeltaTime, ELevelTick TickType, F
 	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
 }
 
-void UDISReceiveComponent::HandleEntityStatePDU(FEntityStatePDU NewEntityStatePDU)
+void UDISReceiveComponent::HandleEntityStatePDU(const FEntityStatePDU& NewEntityStatePDU)
 {
 	//Check if the entity has been deactivated -- Entity is deactivated if the 23rd bit of the Entity Appearance value is set
 	if (NewEntityStatePDU.EntityAppearance.IsDeactivated)
 	{
 		UE_LOG(LogDISReceiveComponent, Log, TEXT("%s Entity Appearance is set to deactivated, deleting entity..."), *NewEntityStatePDU.Marking);
-		GetOwner()->Destroy();
+		RemoveEntity();
 		return;
 	}
 
-	UpdateCommonEntityStateInfo(NewEntityStatePDU);
+	const uint8 stateChanges = UpdateCommonEntityStateInfo(NewEntityStatePDU);
 
-	EntityType = NewEntityStatePDU.EntityType;
-	EntityForceID = NewEntityStatePDU.ForceID;
-	EntityMarking = NewEntityStatePDU.Marking;
+	//Type, force, and marking almost never change, so only reassign them when they do
+	if (EntityType != NewEntityStatePDU.EntityType)
+	{
+		EntityType = NewEntityStatePDU.EntityType;
+	}
+	if (EntityForceID != NewEntityStatePDU.ForceID)
+	{
+		EntityForceID = NewEntityStatePDU.ForceID;
+	}
+	if (!EntityMarking.Equals(NewEntityStatePDU.Marking, ESearchCase::CaseSensitive))
+	{
+		EntityMarking = NewEntityStatePDU.Marking;
+	}
 
-	OnReceivedEntityStatePDU.Broadcast(NewEntityStatePDU);
+	BroadcastEntityStateChanges(stateChanges);
+	BroadcastEvent(OnReceivedEntityStatePDUNative, OnReceivedEntityStatePDU, NewEntityStatePDU);
 
 	if (!PerformDeadReckoning)
 	{
@@ -89,20 +227,19 @@ void UDISReceiveComponent::HandleEntityStatePDU(FEntityStatePDU NewEntityStatePD
 	}
 }
 
-void UDISReceiveComponent::HandleEntityStateUpdatePDU(FEntityStateUpdatePDU NewEntityStateUpdatePDU)
+void UDISReceiveComponent::HandleEntityStateUpdatePDU(const FEntityStateUpdatePDU& NewEntityStateUpdatePDU)
 {
 	//Check if the entity has been deactivated -- Entity is deactivated if the 23rd bit of the Entity Appearance value is set
 	if (NewEntityStateUpdatePDU.EntityAppearance.IsDeactivated)
 	{
 		UE_LOG(LogDISReceiveComponent, Log, TEXT("%s Entity Appearance is set to deactivated, deleting entity..."), *NewEntityStateUpdatePDU.EntityID.ToString());
-		GetOwner()->Destroy();
+		RemoveEntity();
 		return;
 	}
 
-	MostRecentEntityStatePDU = NewEntityStateUpdatePDU;
-	UpdateCommonEntityStateInfo(MostRecentEntityStatePDU);
+	BroadcastEntityStateChanges(UpdateCommonEntityStateInfo(NewEntityStateUpdatePDU));
 
-	OnReceivedEntityStateUpdatePDU.Broadcast(NewEntityStateUpdatePDU);
+	BroadcastEvent(OnReceivedEntityStateUpdatePDUNative, OnReceivedEntityStateUpdatePDU, NewEntityStateUpdatePDU);
 
 	if (!PerformDeadReckoning)
 	{
@@ -114,59 +251,122 @@ void UDISReceiveComponent::HandleEntityStateUpdatePDU(FEntityStateUpdatePDU NewE
 	}
 }
 
-void UDISReceiveComponent::UpdateCommonEntityStateInfo(FEntityStatePDU NewEntityStatePDU)
+uint8 UDISReceiveComponent::UpdateCommonEntityStateInfo(const FEntityStatePDU& NewEntityStatePDU)
+{
+	const uint8 stateChanges = MostRecentEntityState.FromEntityStatePDU(NewEntityStatePDU);
+	CopyEntityStatePDU(NewEntityStatePDU, stateChanges, MostRecentEntityStatePDU);
+	return ApplyReceivedEntityState(stateChanges);
+}
+
+uint8 UDISReceiveComponent::UpdateCommonEntityStateInfo(const FEntityStateUpdatePDU& NewEntityStateUpdatePDU)
+{
+	//Entity State Update PDUs only carry a subset of the Entity State PDU fields
+	const uint8 stateChanges = MostRecentEntityState.ApplyEntityStateUpdatePDU(NewEntityStateUpdatePDU);
+	CopyEntityStateUpdatePDU(NewEntityStateUpdatePDU, stateChanges, MostRecentEntityStatePDU);
+	return ApplyReceivedEntityState(stateChanges);
+}
+
+uint8 UDISReceiveComponent::ApplyReceivedEntityState(uint8 StateChanges)
 {
+	//Dead reckoning starts from the time the state was valid at, which is earlier than now by the latency of the PDU
+	const float timestampAge = OwningDISGameManager.IsValid() ? OwningDISGameManager->GetTimestampAge(MostRecentEntityState.EntityID, MostRecentEntityState.Timestamp) : 0;
 	LatestEntityStatePDUTimestamp = FDateTime::Now();
-	DeltaTimeSinceLastPDU = 0;
+	DeltaTimeSinceLastPDU = timestampAge;
 
-	//Get difference in ECEF between most recent dead reckoning location and last known Dead Reckoning location
-	EntityECEFLocationDifference[0] = NewEntityStatePDU.EntityLocationDouble[0] - MostRecentDeadReckonedEntityStatePDU.EntityLocationDouble[0];
-	EntityECEFLocationDifference[1] = NewEntityStatePDU.EntityLocationDouble[1] - MostRecentDeadReckonedEntityStatePDU.EntityLocationDouble[1];
-	EntityECEFLocationDifference[2] = NewEntityStatePDU.EntityLocationDouble[2] - MostRecentDeadReckonedEntityStatePDU.EntityLocationDouble[2];
+	DeadReckoningKernel.Precompute(MostRecentEntityState);
+
+	FDISEntityState currentEntityState = MostRecentEntityState;
+	if (timestampAge > 0 && PerformDeadReckoning)
+	{
+		DeadReckoningKernel.Evaluate(timestampAge, currentEntityState);
+	}
+
+	//Get difference in ECEF between the new state at the current time and the last displayed Dead Reckoning location
+	EntityECEFLocationDifference[0] = currentEntityState.EntityLocation[0] - MostRecentDeadReckonedEntityState.EntityLocation[0];
+	EntityECEFLocationDifference[1] = currentEntityState.EntityLocation[1] - MostRecentDeadReckonedEntityState.EntityLocation[1];
+	EntityECEFLocationDifference[2] = currentEntityState.EntityLocation[2] - MostRecentDeadReckonedEntityState.EntityLocation[2];
 
 	//Get the rotation difference between the last known dead reckoning rotation and the current rotation. This will be used for internal smoothing.
-	FRotator prevRotDegrees = FMath::RadiansToDegrees(MostRecentDeadReckonedEntityStatePDU.EntityOrientation);
-	FRotator curRotDegrees = FMath::RadiansToDegrees(NewEntityStatePDU.EntityOrientation);
+	FRotator prevRotDegrees = FMath::RadiansToDegrees(MostRecentDeadReckonedEntityState.EntityOrientation);
+	FRotator curRotDegrees = FMath::RadiansToDegrees(currentEntityState.EntityOrientation);
 	EntityRotationDifference = FMath::DegreesToRadians((curRotDegrees - prevRotDegrees).GetNormalized());
 
-	MostRecentEntityStatePDU = NewEntityStatePDU;
-	MostRecentDeadReckonedEntityStatePDU = MostRecentEntityStatePDU;
+	//Smoothing is already part way through its period, so scale the differences up for the blend to start from the displayed pose
+	if (timestampAge > 0 && timestampAge < DeadReckoningSmoothingPeriodSeconds)
+	{
+		const float smoothingScale = 1.0f / (1.0f - timestampAge / DeadReckoningSmoothingPeriodSeconds);
+		EntityECEFLocationDifference[0] *= smoothingScale;
+		EntityECEFLocationDifference[1] *= smoothingScale;
+		EntityECEFLocationDifference[2] *= smoothingScale;
+		EntityRotationDifference *= smoothingScale;
+	}
 
-	EntityID = NewEntityStatePDU.EntityID;
+	MostRecentDeadReckonedEntityState = MostRecentEntityState;
 
-	GetOwner()->SetLifeSpan(DISTimeoutSeconds);
+	//The dead reckoned PDU only differs from the received one in its kinematics, so it shares the same unchanged sections
+	CopyEntityStatePDU(MostRecentEntityStatePDU, StateChanges, MostRecentDeadReckonedEntityStatePDU);
+
+	EntityID = MostRecentEntityState.EntityID;
+
+	ResetTimeout();
 
+	//The first state of an entity sets it up rather than changing it
+	const uint8 stateChanges = NumberEntityStatePDUsReceived == 0 ? 0 : StateChanges;
 	NumberEntityStatePDUsReceived++;
+
+	//Hand the new state to the DIS Game Manager so it is dead reckoned with the rest of the registered entities
+	if (OwningDISGameManager.IsValid())
+	{
+		OwningDISGameManager->UpdateEntityDeadReckoningState(this);
+	}
+
+	return stateChanges;
 }
 
-void UDISReceiveComponent::HandleFirePDU(FFirePDU FirePDUIn)
+void UDISReceiveComponent::BroadcastEntityStateChanges(uint8 StateChanges)
 {
-	OnReceivedFirePDU.Broadcast(FirePDUIn);
+	if (StateChanges & FDISEntityState::CHANGED_APPEARANCE)
+	{
+		BroadcastEvent(OnEntityAppearanceChangedNative, OnEntityAppearanceChanged, MostRecentEntityStatePDU.EntityAppearance);
+	}
+	if (StateChanges & FDISEntityState::CHANGED_ARTICULATION)
+	{
+		BroadcastEvent(OnArticulationParametersChangedNative, OnArticulationParametersChanged, MostRecentEntityStatePDU.ArticulationParameters);
+	}
+	if (StateChanges & FDISEntityState::CHANGED_ENTITY_TYPE)
+	{
+		BroadcastEvent(OnEntityTypeChangedNative, OnEntityTypeChanged, MostRecentEntityStatePDU.EntityType);
+	}
+}
+
+void UDISReceiveComponent::HandleFirePDU(const FFirePDU& FirePDUIn)
+{
+	BroadcastEvent(OnReceivedFirePDUNative, OnReceivedFirePDU, FirePDUIn);
 }
 
-void UDISReceiveComponent::HandleDetonationPDU(FDetonationPDU DetonationPDUIn)
+void UDISReceiveComponent::HandleDetonationPDU(const FDetonationPDU& DetonationPDUIn)
 {
-	OnReceivedDetonationPDU.Broadcast(DetonationPDUIn);
+	BroadcastEvent(OnReceivedDetonationPDUNative, OnReceivedDetonationPDU, DetonationPDUIn);
 }
 
-void UDISReceiveComponent::HandleRemoveEntityPDU(FRemoveEntityPDU RemoveEntityPDUIn)
+void UDISReceiveComponent::HandleRemoveEntityPDU(const FRemoveEntityPDU& RemoveEntityPDUIn)
 {
-	OnReceivedRemoveEntityPDU.Broadcast(RemoveEntityPDUIn);
+	BroadcastEvent(OnReceivedRemoveEntityPDUNative, OnReceivedRemoveEntityPDU, RemoveEntityPDUIn);
 }
 
-void UDISReceiveComponent::HandleStopFreezePDU(FStopFreezePDU StopFreezePDUIn)
+void UDISReceiveComponent::HandleStopFreezePDU(const FStopFreezePDU& StopFreezePDUIn)
 {
-	OnReceivedStopFreezePDU.Broadcast(StopFreezePDUIn);
+	BroadcastEvent(OnReceivedStopFreezePDUNative, OnReceivedStopFreezePDU, StopFreezePDUIn);
 }
 
-void UDISReceiveComponent::HandleStartResumePDU(FStartResumePDU StartResumePDUIn)
+void UDISReceiveComponent::HandleStartResumePDU(const FStartResumePDU& StartResumePDUIn)
 {
-	OnReceivedStartResumePDU.Broadcast(StartResumePDUIn);
+	BroadcastEvent(OnReceivedStartResumePDUNative, OnReceivedStartResumePDU, StartResumePDUIn);
 }
 
-void UDISReceiveComponent::HandleElectromagneticEmissionsPDU(FElectromagneticEmissionsPDU ElectromagneticEmissionsPDUIn)
+void UDISReceiveComponent::HandleElectromagneticEmissionsPDU(const FElectromagneticEmissionsPDU& ElectromagneticEmissionsPDUIn)
 {
-	OnReceivedElectromagneticEmissionsPDU.Broadcast(ElectromagneticEmissionsPDUIn);
+	BroadcastEvent(OnReceivedElectromagneticEmissionsPDUNative, OnReceivedElectromagneticEmissionsPDU, ElectromagneticEmissionsPDUIn);
 }
 
 void UDISReceiveComponent::DoDeadReckoning(float DeltaTime)
@@ -189,21 +389,24 @@ void UDISReceiveComponent::DoDeadReckoning(float DeltaTime)
 				if (distanceToUser > DISCullingDistance)
 				{
 					//In case users are relying on Dead Reckoning for their entity movement, just send them the most recent Dead Reckoned PDU again
-					OnDeadReckoningUpdate.Broadcast(MostRecentDeadReckonedEntityStatePDU);
+					BroadcastEvent(OnDeadReckoningUpdateNative, OnDeadReckoningUpdate, MostRecentDeadReckonedEntityStatePDU);
 					return;
 				}
 			}
 		}
 
-		if (UDeadReckoning_BPFL::DeadReckoning(MostRecentEntityStatePDU, DeltaTimeSinceLastPDU, MostRecentDeadReckonedEntityStatePDU))
+		if (DeadReckoningKernel.Evaluate(DeltaTimeSinceLastPDU, MostRecentDeadReckonedEntityState))
 		{
 			//If more than one PDU has been received and we're still in the smoothing period, then smooth
 			if (PerformDeadReckoningSmoothing && NumberEntityStatePDUsReceived > 1 && DeltaTimeSinceLastPDU <= DeadReckoningSmoothingPeriodSeconds)
 			{
-				MostRecentDeadReckonedEntityStatePDU = SmoothDeadReckoning(MostRecentDeadReckonedEntityStatePDU);
+				SmoothDeadReckoning(MostRecentDeadReckonedEntityState);
 			}
 
-			OnDeadReckoningUpdate.Broadcast(MostRecentDeadReckonedEntityStatePDU);
+			//Only the kinematic fields change while dead reckoning, so avoid copying the whole PDU
+			MostRecentDeadReckonedEntityState.CopyKinematicsToEntityStatePDU(MostRecentDeadReckonedEntityStatePDU);
+
+			BroadcastEvent(OnDeadReckoningUpdateNative, OnDeadReckoningUpdate, MostRecentDeadReckonedEntityStatePDU);
 		}
 
 		//Perform ground clamping last -- If ground clamping not enabled, check if we should apply to owner
@@ -214,90 +417,243 @@ void UDISReceiveComponent::DoDeadReckoning(float DeltaTime)
 	}
 }
 
-bool UDISReceiveComponent::GroundClamping_Implementation()
+void UDISReceiveComponent::WriteDeadReckoningState(FDISEntityState& OutReceivedEntityState, FDISEntityState& OutDeadReckonedEntityState, FDISDeadReckoningParameters& OutParameters) const
 {
-	//Verify that ground clamping is enabled, the entity is owned by another sim, is of the ground domain, and that it is not a munition
-	if (SpawnedFromNetwork && (PerformGroundClamping == EGroundClampingMode::AlwaysGroundClamp || (PerformGroundClamping == EGroundClampingMode::GroundClampWithDISOptions && EntityType.Domain == 1 && EntityType.EntityKind != 2)))
-	{
-		SCOPE_CYCLE_COUNTER(STAT_GroundClamping);
+	OutReceivedEntityState = MostRecentEntityState;
+	OutDeadReckonedEntityState = MostRecentDeadReckonedEntityState;
+
+	OutParameters.TimeSinceLastUpdate = DeltaTimeSinceLastPDU;
+	OutParameters.SmoothingPeriodSeconds = DeadReckoningSmoothingPeriodSeconds;
+	OutParameters.CullingDistance = DISCullingDistance;
+	OutParameters.SmoothingLocationOffset[0] = EntityECEFLocationDifference[0];
+	OutParameters.SmoothingLocationOffset[1] = EntityECEFLocationDifference[1];
+	OutParameters.SmoothingLocationOffset[2] = EntityECEFLocationDifference[2];
+	OutParameters.SmoothingRotationOffset = EntityRotationDifference;
+	OutParameters.bPerformDeadReckoning = PerformDeadReckoning && SpawnedFromNetwork;
+	OutParameters.bPerformSmoothing = PerformDeadReckoningSmoothing && NumberEntityStatePDUsReceived > 1;
+	OutParameters.bCullDeadReckoning = DISCullingMode == EDISCullingMode::CullDeadReckoning || DISCullingMode == EDISCullingMode::CullAll;
+}
 
-		//Set clamp direction using the North East Down down vector
-		FVector clampDirection = FVector::DownVector;
+void UDISReceiveComponent::ApplyDeadReckoningUpdate(const FDISEntityState& DeadReckonedEntityState, const FDISDeadReckoningParameters& Parameters)
+{
+	DeltaTimeSinceLastPDU = Parameters.TimeSinceLastUpdate;
 
-		FVector eastVector = FVector::RightVector;
-		FVector northVector = FVector::ForwardVector;
-		FCartesianCoordinates ecefCartCoords = FCartesianCoordinates(MostRecentDeadReckonedEntityStatePDU.EntityLocationDouble[0],
-			MostRecentDeadReckonedEntityStatePDU.EntityLocationDouble[1], MostRecentDeadReckonedEntityStatePDU.EntityLocationDouble[2]);
+	if (!Parameters.bPerformDeadReckoning)
+	{
+		return;
+	}
 
-		if (IsValid(GeoReferencingSystem))
+	if (Parameters.bCulled)
+	{
+		//In case users are relying on Dead Reckoning for their entity movement, just send them the most recent Dead Reckoned PDU again
+		if (HasDeadReckoningUpdateListeners())
 		{
-			GeoReferencingSystem->GetENUVectorsAtECEFLocation(ecefCartCoords, eastVector, northVector, clampDirection);
+			BroadcastEvent(OnDeadReckoningUpdateNative, OnDeadReckoningUpdate, MostRecentDeadReckonedEntityStatePDU);
 		}
-		else
+		return;
+	}
+
+	//Entities in a level of detail tier that was not due for an update keep their current transform and ground clamp
+	if (Parameters.bSkippedByLOD)
+	{
+		return;
+	}
+
+	if (Parameters.bUpdated)
+	{
+		MostRecentDeadReckonedEntityState.CopyKinematicsFrom(DeadReckonedEntityState);
+		MostRecentDeadReckonedEntityState.CopyKinematicsToEntityStatePDU(MostRecentDeadReckonedEntityStatePDU);
+
+		if (HasDeadReckoningUpdateListeners())
 		{
-			UE_LOG(LogDISReceiveComponent, Warning, TEXT("Invalid GeoReferencing variable in DISComponent. Error in calculating East, North, Down vectors for Ground Clamp location. Utilizing default East, North, Down vectors for calculation."));
+			BroadcastEvent(OnDeadReckoningUpdateNative, OnDeadReckoningUpdate, MostRecentDeadReckonedEntityStatePDU);
 		}
+	}
 
-		clampDirection *= -1;
+	//Perform ground clamping last -- If ground clamping not enabled, check if we should apply to owner
+	if (!GroundClamping() && ApplyToOwner)
+	{
+		ApplyToOwnerIfActivated(MostRecentDeadReckonedEntityStatePDU);
+	}
+}
+
+bool UDISReceiveComponent::GroundClamping_Implementation()
+{
+	//Verify that ground clamping is enabled, the entity is owned by another sim, is of the ground domain, and that it is not a munition
+	if (SpawnedFromNetwork && (PerformGroundClamping == EGroundClampingMode::AlwaysGroundClamp || (PerformGroundClamping == EGroundClampingMode::GroundClampWithDISOptions && EntityType.Domain == 1 && EntityType.EntityKind != 2)))
+	{
+		SCOPE_CYCLE_COUNTER(STAT_GroundClamping);
 
 		//Get the location the object is supposed to be at according to the most recent dead reckoning update.
 		FVector actorLocation;
 		UDIS_BPFL::GetUnrealLocationFromEntityStatePdu(MostRecentDeadReckonedEntityStatePDU, GeoReferencingSystem, actorLocation);
 
+		//Static terrain is looked up in the baked height field, only the ground it has no data for is traced
+		const UDISTerrainHeightField* terrainHeightField = OwningDISGameManager.IsValid() ? OwningDISGameManager->TerrainHeightField : nullptr;
+		float groundHeight;
+		FVector groundNormal;
+		if (terrainHeightField != nullptr && terrainHeightField->SampleGround(actorLocation, groundHeight, groundNormal))
+		{
+			//A trace requested while the entity was over ground without data is no longer needed
+			ResetGroundClamp();
+			ApplyGroundClamp(FVector(actorLocation.X, actorLocation.Y, groundHeight), groundNormal);
+			return true;
+		}
+
+		//Asynchronous results are picked up by the next update, which only comes every frame for dead reckoned entities.
+		//Until the first result arrives the entity is placed where it would be without ground clamping.
+		if (AsyncGroundClamping && PerformDeadReckoning)
+		{
+			if (!UpdateAsyncGroundClamp(actorLocation) && ApplyToOwner)
+			{
+				ApplyToOwnerIfActivated(MostRecentDeadReckonedEntityStatePDU);
+			}
+			return true;
+		}
+
+		const FVector upVector = GetGroundClampingUpVector();
+
 		FHitResult lineTraceHitResult;
-		FVector endLocation = (clampDirection * 100000) + actorLocation;
-		FVector aboveActorStartLocation = (clampDirection * -100000) + actorLocation;
+		FVector endLocation = (upVector * -GroundClampingTraceDistance) + actorLocation;
+		FVector aboveActorStartLocation = (upVector * GroundClampingTraceDistance) + actorLocation;
 
 		FCollisionQueryParams queryParams = FCollisionQueryParams(FName("Ground Clamping"), false, GetOwner());
 		//Find colliding point above/below the actor
 		if (GetWorld()->LineTraceSingleByChannel(lineTraceHitResult, aboveActorStartLocation, endLocation, UEngineTypes::ConvertToCollisionChannel(GoundClampingCollisionChannel), queryParams))
 		{
-			FVector clampLocation = lineTraceHitResult.Location;
-			//Calculate what the new forward and right vectors should be based on the impact normal
-			FVector newForward = FVector::CrossProduct(GetOwner()->GetActorRightVector(), lineTraceHitResult.ImpactNormal);
-			FVector newRight = FVector::CrossProduct(lineTraceHitResult.ImpactNormal, newForward);
+			ApplyGroundClamp(lineTraceHitResult.Location, lineTraceHitResult.ImpactNormal);
+		}
+		else if (ApplyToOwner)
+		{
+			//Without ground to clamp to, place the entity where it would be without ground clamping
+			ApplyToOwnerIfActivated(MostRecentDeadReckonedEntityStatePDU);
+		}
 
-			FRotator clampRotation = UKismetMathLibrary::MakeRotationFromAxes(newForward, newRight, lineTraceHitResult.ImpactNormal);
+		return true;
+	}
+	else
+	{
+		return false;
+	}
+}
+
+FVector UDISReceiveComponent::GetGroundClampingUpVector() const
+{
+	//Set clamp direction using the North East Down down vector
+	FVector clampDirection = FVector::DownVector;
 
-			//Create clamp transform and broadcast
-			FTransform clampTransform = FTransform(clampRotation, clampLocation);
-			TArray<FTransform> allClampTransforms;
-			allClampTransforms.Add(clampTransform);
+	FVector eastVector = FVector::RightVector;
+	FVector northVector = FVector::ForwardVector;
+	FCartesianCoordinates ecefCartCoords = FCartesianCoordinates(MostRecentDeadReckonedEntityStatePDU.EntityLocationDouble[0],
+		MostRecentDeadReckonedEntityStatePDU.EntityLocationDouble[1], MostRecentDeadReckonedEntityStatePDU.EntityLocationDouble[2]);
 
-			if (ApplyToOwner)
+	if (IsValid(GeoReferencingSystem))
+	{
+		GeoReferencingSystem->GetENUVectorsAtECEFLocation(ecefCartCoords, eastVector, northVector, clampDirection);
+	}
+	else
+	{
+		UE_LOG(LogDISReceiveComponent, Warning, TEXT("Invalid GeoReferencing variable in DISComponent. Error in calculating East, North, Down vectors for Ground Clamp location. Utilizing default East, North, Down vectors for calculation."));
+	}
+
+	return clampDirection * -1;
+}
+
+bool UDISReceiveComponent::UpdateAsyncGroundClamp(const FVector& ActorLocation)
+{
+	UWorld* world = GetWorld();
+
+	//Pick up the result of the trace requested on an earlier frame
+	if (GroundClampTraceHandle.IsValid())
+	{
+		FTraceDatum traceDatum;
+		if (world->QueryTraceData(GroundClampTraceHandle, traceDatum))
+		{
+			GroundClampTraceHandle = FTraceHandle();
+
+			const FHitResult* groundHit = traceDatum.OutHits.FindByPredicate([](const FHitResult& HitResult) { return HitResult.bBlockingHit; });
+			bHasGroundClamp = groundHit != nullptr;
+			if (bHasGroundClamp)
 			{
-				GetOwner()->SetActorLocationAndRotation(clampLocation, clampRotation);
+				GroundClampHitLocation = groundHit->Location;
+				GroundClampNormal = groundHit->ImpactNormal;
 			}
-
-			OnGroundClampingUpdate.Broadcast(allClampTransforms);
 		}
+		else if (!world->IsTraceHandleValid(GroundClampTraceHandle, false))
+		{
+			//Results are only kept for a frame, so one missed while the entity was culled is requested again
+			GroundClampTraceHandle = FTraceHandle();
+			bGroundClampTraced = false;
+		}
+	}
 
-		return true;
+	//Trace again once the entity has moved too far from where the ground was last traced
+	if (!GroundClampTraceHandle.IsValid() && (!bGroundClampTraced || FVector::DistSquared(ActorLocation, GroundClampTraceLocation) > FMath::Square(GroundClampingReuseDistance)))
+	{
+		GroundClampUpVector = GetGroundClampingUpVector();
+		GroundClampTraceLocation = ActorLocation;
+		bGroundClampTraced = true;
+
+		const FCollisionQueryParams queryParams = FCollisionQueryParams(FName("Ground Clamping"), false, GetOwner());
+		GroundClampTraceHandle = world->AsyncLineTraceByChannel(EAsyncTraceType::Single, ActorLocation + (GroundClampUpVector * GroundClampingTraceDistance),
+			ActorLocation - (GroundClampUpVector * GroundClampingTraceDistance), UEngineTypes::ConvertToCollisionChannel(GoundClampingCollisionChannel), queryParams);
 	}
-	else
+
+	if (!bHasGroundClamp)
 	{
 		return false;
 	}
+
+	//Follow the plane of the last ground found straight down from the entity's current location
+	const FVector offsetFromGround = ActorLocation - GroundClampHitLocation;
+	const float normalAlongUp = FVector::DotProduct(GroundClampNormal, GroundClampUpVector);
+	const float heightAboveGround = normalAlongUp > KINDA_SMALL_NUMBER ? FVector::DotProduct(offsetFromGround, GroundClampNormal) / normalAlongUp : FVector::DotProduct(offsetFromGround, GroundClampUpVector);
+
+	ApplyGroundClamp(ActorLocation - (GroundClampUpVector * heightAboveGround), GroundClampNormal);
+	return true;
+}
+
+void UDISReceiveComponent::ApplyGroundClamp(const FVector& ClampLocation, const FVector& GroundNormal)
+{
+	//Calculate what the new forward and right vectors should be based on the impact normal
+	FVector newForward = FVector::CrossProduct(GetOwner()->GetActorRightVector(), GroundNormal);
+	FVector newRight = FVector::CrossProduct(GroundNormal, newForward);
+
+	FRotator clampRotation = UKismetMathLibrary::MakeRotationFromAxes(newForward, newRight, GroundNormal);
+
+	if (ApplyToOwner)
+	{
+		SetOwnerLocationAndRotation(ClampLocation, clampRotation);
+	}
+
+	//Create clamp transform and broadcast
+	if (OnGroundClampingUpdateNative.IsBound() || OnGroundClampingUpdate.IsBound())
+	{
+		FTransform clampTransform = FTransform(clampRotation, ClampLocation);
+		TArray<FTransform> allClampTransforms;
+		allClampTransforms.Add(clampTransform);
+
+		BroadcastEvent(OnGroundClampingUpdateNative, OnGroundClampingUpdate, allClampTransforms);
+	}
 }
 
-FEntityStatePDU UDISReceiveComponent::SmoothDeadReckoning(FEntityStatePDU DeadReckonPDUToSmooth)
+void UDISReceiveComponent::ResetGroundClamp()
 {
-	FEntityStatePDU SmoothedDeadReckonPDU = DeadReckonPDUToSmooth;
+	GroundClampTraceHandle = FTraceHandle();
+	bGroundClampTraced = false;
+	bHasGroundClamp = false;
+}
 
+void UDISReceiveComponent::SmoothDeadReckoning(FDISEntityState& DeadReckonedStateToSmooth)
+{
 	float alpha = UKismetMathLibrary::MapRangeClamped(DeltaTimeSinceLastPDU, 0.0f, DeadReckoningSmoothingPeriodSeconds, 0.0f, 1.0f);
 
 	//Lerp location for smoothing
-	SmoothedDeadReckonPDU.EntityLocationDouble[0] -= FMath::Lerp(EntityECEFLocationDifference[0], 0., alpha);
-	SmoothedDeadReckonPDU.EntityLocationDouble[1] -= FMath::Lerp(EntityECEFLocationDifference[1], 0., alpha);
-	SmoothedDeadReckonPDU.EntityLocationDouble[2] -= FMath::Lerp(EntityECEFLocationDifference[2], 0., alpha);
-
-	SmoothedDeadReckonPDU.EntityLocation.X = SmoothedDeadReckonPDU.EntityLocationDouble[0];
-	SmoothedDeadReckonPDU.EntityLocation.Y = SmoothedDeadReckonPDU.EntityLocationDouble[1];
-	SmoothedDeadReckonPDU.EntityLocation.Z = SmoothedDeadReckonPDU.EntityLocationDouble[2];
+	DeadReckonedStateToSmooth.EntityLocation[0] -= FMath::Lerp(EntityECEFLocationDifference[0], 0., alpha);
+	DeadReckonedStateToSmooth.EntityLocation[1] -= FMath::Lerp(EntityECEFLocationDifference[1], 0., alpha);
+	DeadReckonedStateToSmooth.EntityLocation[2] -= FMath::Lerp(EntityECEFLocationDifference[2], 0., alpha);
 
-	SmoothedDeadReckonPDU.EntityOrientation -= FMath::Lerp(EntityRotationDifference, FRotator(0, 0, 0), alpha);
-
-	return SmoothedDeadReckonPDU;
+	DeadReckonedStateToSmooth.EntityOrientation -= FMath::Lerp(EntityRotationDifference, FRotator(0, 0, 0), alpha);
 }
 
 void UDISReceiveComponent::ApplyToOwnerIfActivated(FEntityStatePDU const& StatePDU)
@@ -309,5 +665,17 @@ void UDISReceiveComponent::ApplyToOwnerIfActivated(FEntityStatePDU const& StateP
 	FVector newLocation;
 	FRotator newRotation;
 	UDIS_BPFL::GetUnrealLocationAndOrientationFromEntityStatePdu(StatePDU, GeoReferencingSystem, newLocation, newRotation);
-	GetOwner()->SetActorLocationAndRotation(newLocation, newRotation);
+	SetOwnerLocationAndRotation(newLocation, newRotation);
+}
+
+void UDISReceiveComponent::SetOwnerLocationAndRotation(const FVector& NewLocation, const FRotator& NewRotation)
+{
+	//Entities registered with a DIS Game Manager are moved along with every other entity once all of them have been updated
+	if (OwningDISGameManager.IsValid() && OwningDISGameManager->BatchEntityTransforms)
+	{
+		OwningDISGameManager->QueueEntityTransform(this, NewLocation, NewRotation);
+		return;
+	}
+
+	GetOwner()->SetActorLocationAndRotation(NewLocation, NewRotation);
 }
\ No newline at end of file
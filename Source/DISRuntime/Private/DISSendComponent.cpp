@@ -5,6 +5,7 @@
 
 #include "DISGameManager.h"
 #include "DeadReckoning_BPFL.h"
+#include "DISTimestampClock.h"
 #include "PDUConversions_BPFL.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
@@ -171,6 +172,8 @@ FEntityStatePDU UDISSendComponent::FormEntityStatePDU()
 	newEntityStatePDU.EntityAppearance = EntityAppearance;
 
 	newEntityStatePDU.DeadReckoningParameters.DeadReckoningAlgorithm = DeadReckoningAlgorithm;
+	//Stamp the time the state is valid at so that receivers can dead reckon it from then
+	newEntityStatePDU.Timestamp = FDISTimestampClock::MakeAbsoluteTimestamp(FDateTime::UtcNow());
 
 	if (IsValid(DISGameManager))
 	{
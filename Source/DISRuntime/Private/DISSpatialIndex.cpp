@@ -0,0 +1,325 @@
+// Copyright 2022 Gaming Research Integration for Learning Lab. All Rights Reserved.
+
+#include "DISSpatialIndex.h"
+#include "Algo/BinarySearch.h"
+#include "glm/geometric.hpp"
+
+FDISSpatialIndex::FDISSpatialIndex(double CellSizeMetersIn)
+	: CellSizeMeters(FMath::Max(CellSizeMetersIn, 1.0))
+	, NumIndexed(0)
+{
+}
+
+void FDISSpatialIndex::SetCellSize(double CellSizeMetersIn)
+{
+	CellSizeMeters = FMath::Max(CellSizeMetersIn, 1.0);
+
+	Cells.Reset();
+	for (int32 entryIndex = 0; entryIndex < Entries.Num(); entryIndex++)
+	{
+		if (Entries[entryIndex].bIndexed)
+		{
+			Entries[entryIndex].Cell = GetCell(Entries[entryIndex].Location);
+			AddToCell(entryIndex);
+		}
+	}
+}
+
+void FDISSpatialIndex::Update(FDISEntityHandle Handle, const glm::dvec3& ECEFLocation)
+{
+	if (!Handle.IsSet())
+	{
+		return;
+	}
+
+	if (Handle.Index >= Entries.Num())
+	{
+		Entries.SetNum(Handle.Index + 1);
+	}
+
+	FEntry& entry = Entries[Handle.Index];
+	const FIntVector cell = GetCell(ECEFLocation);
+
+	//Staying within the same cell is the common case and only needs the new location
+	if (entry.bIndexed && entry.Generation == Handle.Generation && entry.Cell == cell)
+	{
+		entry.Location = ECEFLocation;
+		return;
+	}
+
+	if (entry.bIndexed)
+	{
+		RemoveFromCell(Handle.Index);
+	}
+	else
+	{
+		NumIndexed++;
+	}
+
+	entry.Location = ECEFLocation;
+	entry.Cell = cell;
+	entry.Generation = Handle.Generation;
+	entry.bIndexed = true;
+	AddToCell(Handle.Index);
+}
+
+void FDISSpatialIndex::Remove(FDISEntityHandle Handle)
+{
+	if (!Entries.IsValidIndex(Handle.Index))
+	{
+		return;
+	}
+
+	FEntry& entry = Entries[Handle.Index];
+	if (entry.bIndexed && entry.Generation == Handle.Generation)
+	{
+		RemoveFromCell(Handle.Index);
+		entry.bIndexed = false;
+		NumIndexed--;
+	}
+}
+
+void FDISSpatialIndex::Reset()
+{
+	Entries.Reset();
+	Cells.Reset();
+	NumIndexed = 0;
+}
+
+template<typename FunctionType>
+void FDISSpatialIndex::ForEachEntryInCells(const FIntVector& MinCell, const FIntVector& MaxCell, FunctionType Function) const
+{
+	const int64 width = int64(MaxCell.X) - MinCell.X + 1;
+	const int64 height = int64(MaxCell.Y) - MinCell.Y + 1;
+	const int64 depth = int64(MaxCell.Z) - MinCell.Z + 1;
+	if (width <= 0 || height <= 0 || depth <= 0)
+	{
+		return;
+	}
+
+	//Large ranges would alias packed cell keys and visit more empty cells than there are occupied ones
+	constexpr int64 maxRangeWidth = int64(1) << CELL_COORDINATE_BITS;
+	if (width >= maxRangeWidth || height >= maxRangeWidth || depth >= maxRangeWidth || width * height * depth > Cells.Num())
+	{
+		for (const TPair<uint64, TArray<int32>>& cell : Cells)
+		{
+			for (const int32 entryIndex : cell.Value)
+			{
+				Function(entryIndex);
+			}
+		}
+		return;
+	}
+
+	for (int32 x = MinCell.X; x <= MaxCell.X; x++)
+	{
+		for (int32 y = MinCell.Y; y <= MaxCell.Y; y++)
+		{
+			for (int32 z = MinCell.Z; z <= MaxCell.Z; z++)
+			{
+				const TArray<int32>* cell = Cells.Find(GetCellKey(FIntVector(x, y, z)));
+				if (cell != nullptr)
+				{
+					for (const int32 entryIndex : *cell)
+					{
+						Function(entryIndex);
+					}
+				}
+			}
+		}
+	}
+}
+
+bool FDISSpatialIndex::GetLocation(FDISEntityHandle Handle, glm::dvec3& OutECEFLocation) const
+{
+	if (!Entries.IsValidIndex(Handle.Index) || !Entries[Handle.Index].bIndexed || Entries[Handle.Index].Generation != Handle.Generation)
+	{
+		return false;
+	}
+
+	OutECEFLocation = Entries[Handle.Index].Location;
+	return true;
+}
+
+void FDISSpatialIndex::QueryRadius(const glm::dvec3& ECEFCenter, double RadiusMeters, TArray<FDISEntityHandle>& OutHandles) const
+{
+	if (NumIndexed == 0 || RadiusMeters < 0)
+	{
+		return;
+	}
+
+	const double radiusSquared = RadiusMeters * RadiusMeters;
+	const glm::dvec3 extent(RadiusMeters);
+
+	ForEachEntryInCells(GetCell(ECEFCenter - extent), GetCell(ECEFCenter + extent), [this, &ECEFCenter, radiusSquared, &OutHandles](int32 EntryIndex)
+	{
+		const glm::dvec3 offset = Entries[EntryIndex].Location - ECEFCenter;
+		if (glm::dot(offset, offset) <= radiusSquared)
+		{
+			OutHandles.Add(GetHandle(EntryIndex));
+		}
+	});
+}
+
+void FDISSpatialIndex::QueryBox(const glm::dvec3& ECEFMin, const glm::dvec3& ECEFMax, TArray<FDISEntityHandle>& OutHandles) const
+{
+	if (NumIndexed == 0)
+	{
+		return;
+	}
+
+	ForEachEntryInCells(GetCell(ECEFMin), GetCell(ECEFMax), [this, &ECEFMin, &ECEFMax, &OutHandles](int32 EntryIndex)
+	{
+		const glm::dvec3& location = Entries[EntryIndex].Location;
+		if (location.x >= ECEFMin.x && location.y >= ECEFMin.y && location.z >= ECEFMin.z
+			&& location.x <= ECEFMax.x && location.y <= ECEFMax.y && location.z <= ECEFMax.z)
+		{
+			OutHandles.Add(GetHandle(EntryIndex));
+		}
+	});
+}
+
+void FDISSpatialIndex::QueryNearest(const glm::dvec3& ECEFCenter, int32 Count, double MaxDistanceMeters, TArray<FDISEntityHandle>& OutHandles) const
+{
+	QueryNearest(ECEFCenter, Count, MaxDistanceMeters, [](FDISEntityHandle) { return true; }, OutHandles);
+}
+
+void FDISSpatialIndex::QueryNearest(const glm::dvec3& ECEFCenter, int32 Count, double MaxDistanceMeters, TFunctionRef<bool(FDISEntityHandle)> Filter, TArray<FDISEntityHandle>& OutHandles) const
+{
+	if (NumIndexed == 0 || Count <= 0)
+	{
+		return;
+	}
+
+	const double maxDistanceSquared = MaxDistanceMeters > 0 ? MaxDistanceMeters * MaxDistanceMeters : TNumericLimits<double>::Max();
+	const FIntVector centerCell = GetCell(ECEFCenter);
+
+	//Closest entities found so far as pairs of squared distance and entry index, sorted closest first
+	TArray<TPair<double, int32>, TInlineAllocator<16>> closest;
+	auto considerEntry = [this, &ECEFCenter, Count, maxDistanceSquared, &Filter, &closest](int32 EntryIndex)
+	{
+		const glm::dvec3 offset = Entries[EntryIndex].Location - ECEFCenter;
+		const double distanceSquared = glm::dot(offset, offset);
+		if (distanceSquared > maxDistanceSquared || (closest.Num() == Count && distanceSquared >= closest.Last().Key) || !Filter(GetHandle(EntryIndex)))
+		{
+			return;
+		}
+
+		const int32 insertIndex = Algo::UpperBoundBy(closest, distanceSquared, [](const TPair<double, int32>& ClosestEntry) { return ClosestEntry.Key; });
+		closest.Insert(TPair<double, int32>(distanceSquared, EntryIndex), insertIndex);
+		if (closest.Num() > Count)
+		{
+			closest.Pop(false);
+		}
+	};
+
+	//Search outwards one shell of cells at a time. Every entity in shell N is at least N - 1 cells away from the center.
+	for (int32 shell = 0; ; shell++)
+	{
+		const double shellDistance = FMath::Max(shell - 1, 0) * CellSizeMeters;
+		if (shellDistance * shellDistance > maxDistanceSquared || (closest.Num() == Count && shellDistance * shellDistance >= closest.Last().Key))
+		{
+			break;
+		}
+
+		//Once the shell holds more cells than are occupied, finish by testing every entity outside the shells searched so far
+		const int64 shellWidth = 2 * int64(shell) + 1;
+		const int64 cellsInShell = shellWidth * shellWidth * shellWidth - FMath::Square(FMath::Max(shellWidth - 2, int64(0))) * FMath::Max(shellWidth - 2, int64(0));
+		if (cellsInShell > Cells.Num())
+		{
+			for (const TPair<uint64, TArray<int32>>& cell : Cells)
+			{
+				for (const int32 entryIndex : cell.Value)
+				{
+					const FIntVector cellOffset = Entries[entryIndex].Cell - centerCell;
+					if (FMath::Max3(FMath::Abs(cellOffset.X), FMath::Abs(cellOffset.Y), FMath::Abs(cellOffset.Z)) >= shell)
+					{
+						considerEntry(entryIndex);
+					}
+				}
+			}
+			break;
+		}
+
+		for (int32 x = -shell; x <= shell; x++)
+		{
+			for (int32 y = -shell; y <= shell; y++)
+			{
+				//Only the two faces of the shell are visited unless x or y already lies on the shell
+				const bool bOnShell = FMath::Abs(x) == shell || FMath::Abs(y) == shell;
+				const int32 zStep = bOnShell ? 1 : FMath::Max(2 * shell, 1);
+				for (int32 z = -shell; z <= shell; z += zStep)
+				{
+					const FIntVector shellCell = centerCell + FIntVector(x, y, z);
+					const TArray<int32>* cell = Cells.Find(GetCellKey(shellCell));
+					if (cell != nullptr)
+					{
+						for (const int32 entryIndex : *cell)
+						{
+							//Skip entities of distant cells that share the packed key, they are reached by their own shell
+							if (Entries[entryIndex].Cell == shellCell)
+							{
+								considerEntry(entryIndex);
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+
+	OutHandles.Reserve(OutHandles.Num() + closest.Num());
+	for (const TPair<double, int32>& closestEntry : closest)
+	{
+		OutHandles.Add(GetHandle(closestEntry.Value));
+	}
+}
+
+FIntVector FDISSpatialIndex::GetCell(const glm::dvec3& Location) const
+{
+	//Clamp so that locations far outside the Earth cannot overflow the cell coordinates
+	constexpr double maxCell = 1 << 28;
+	return FIntVector(
+		static_cast<int32>(FMath::Clamp(FMath::FloorToDouble(Location.x / CellSizeMeters), -maxCell, maxCell)),
+		static_cast<int32>(FMath::Clamp(FMath::FloorToDouble(Location.y / CellSizeMeters), -maxCell, maxCell)),
+		static_cast<int32>(FMath::Clamp(FMath::FloorToDouble(Location.z / CellSizeMeters), -maxCell, maxCell)));
+}
+
+uint64 FDISSpatialIndex::GetCellKey(const FIntVector& Cell)
+{
+	constexpr uint64 coordinateMask = (uint64(1) << CELL_COORDINATE_BITS) - 1;
+	return ((uint64(Cell.X) & coordinateMask) << (2 * CELL_COORDINATE_BITS))
+		| ((uint64(Cell.Y) & coordinateMask) << CELL_COORDINATE_BITS)
+		| (uint64(Cell.Z) & coordinateMask);
+}
+
+void FDISSpatialIndex::AddToCell(int32 EntryIndex)
+{
+	TArray<int32>& cell = Cells.FindOrAdd(GetCellKey(Entries[EntryIndex].Cell));
+	Entries[EntryIndex].IndexInCell = cell.Add(EntryIndex);
+}
+
+void FDISSpatialIndex::RemoveFromCell(int32 EntryIndex)
+{
+	const uint64 cellKey = GetCellKey(Entries[EntryIndex].Cell);
+	TArray<int32>* cell = Cells.Find(cellKey);
+	if (cell == nullptr)
+	{
+		return;
+	}
+
+	//Swap the last entry of the cell into the removed entry's place
+	const int32 indexInCell = Entries[EntryIndex].IndexInCell;
+	const int32 lastIndexInCell = cell->Num() - 1;
+	if (indexInCell != lastIndexInCell)
+	{
+		Entries[(*cell)[lastIndexInCell]].IndexInCell = indexInCell;
+	}
+	cell->RemoveAtSwap(indexInCell, 1, false);
+	Entries[EntryIndex].IndexInCell = INDEX_NONE;
+
+	if (cell->Num() == 0)
+	{
+		Cells.Remove(cellKey);
+	}
+}
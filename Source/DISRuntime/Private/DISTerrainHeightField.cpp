@@ -0,0 +1,69 @@
+// Copyright 2022 Gaming Research Integration for Learning Lab. All Rights Reserved.
+
+#include "DISTerrainHeightField.h"
+
+bool UDISTerrainHeightField::SampleGround(const FVector& Location, float& OutHeight, FVector& OutNormal) const
+{
+	if (!HasData())
+	{
+		return false;
+	}
+
+	const float gridX = (Location.X - Origin.X) / SampleSpacing;
+	const float gridY = (Location.Y - Origin.Y) / SampleSpacing;
+	if (gridX < 0 || gridY < 0)
+	{
+		return false;
+	}
+
+	const int32 cellX = FMath::FloorToInt(gridX);
+	const int32 cellY = FMath::FloorToInt(gridY);
+	const int32 tileX = cellX / TileSamples;
+	const int32 tileY = cellY / TileSamples;
+	if (tileX >= NumTiles.X || tileY >= NumTiles.Y)
+	{
+		return false;
+	}
+
+	const FDISTerrainHeightFieldTile& tile = Tiles[tileY * NumTiles.X + tileX];
+	if (tile.Heights.Num() == 0)
+	{
+		return false;
+	}
+
+	//Tiles share their edge samples, so the four corners of the cell are always in the same tile
+	const int32 stride = TileSamples + 1;
+	const int32 index00 = (cellY - tileY * TileSamples) * stride + (cellX - tileX * TileSamples);
+	const int32 index10 = index00 + 1;
+	const int32 index01 = index00 + stride;
+	const int32 index11 = index01 + 1;
+
+	if ((tile.SampleFlags[index00] | tile.SampleFlags[index10] | tile.SampleFlags[index01] | tile.SampleFlags[index11]) != 0)
+	{
+		return false;
+	}
+
+	const float alphaX = gridX - cellX;
+	const float alphaY = gridY - cellY;
+
+	OutHeight = FMath::BiLerp(tile.Heights[index00], tile.Heights[index10], tile.Heights[index01], tile.Heights[index11], alphaX, alphaY);
+	OutNormal = FMath::BiLerp(UnpackNormal(tile.PackedNormals[index00]), UnpackNormal(tile.PackedNormals[index10]),
+		UnpackNormal(tile.PackedNormals[index01]), UnpackNormal(tile.PackedNormals[index11]), alphaX, alphaY).GetSafeNormal(SMALL_NUMBER, FVector::UpVector);
+
+	return true;
+}
+
+uint16 UDISTerrainHeightField::PackNormal(const FVector& Normal)
+{
+	//Ground normals always point up, so Z is recovered from X and Y
+	const uint8 packedX = static_cast<uint8>(FMath::RoundToInt(FMath::Clamp(Normal.X, -1.0f, 1.0f) * 127.0f) + 127);
+	const uint8 packedY = static_cast<uint8>(FMath::RoundToInt(FMath::Clamp(Normal.Y, -1.0f, 1.0f) * 127.0f) + 127);
+	return (uint16(packedX) << 8) | packedY;
+}
+
+FVector UDISTerrainHeightField::UnpackNormal(uint16 PackedNormal)
+{
+	const float x = (int32(PackedNormal >> 8) - 127) / 127.0f;
+	const float y = (int32(PackedNormal & 0xFF) - 127) / 127.0f;
+	return FVector(x, y, FMath::Sqrt(FMath::Max(1.0f - x * x - y * y, 0.0f)));
+}
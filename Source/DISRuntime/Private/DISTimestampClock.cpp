@@ -0,0 +1,83 @@
+// Copyright 2022 Gaming Research Integration for Learning Lab. All Rights Reserved.
+
+#include "DISTimestampClock.h"
+
+FDISTimestampClock::FDISTimestampClock()
+{
+	const FDateTime utcNow = FDateTime::UtcNow();
+	MonotonicTimeAtStart = FPlatformTime::Seconds();
+	UTCSecondsPastHourAtStart = utcNow.GetMinute() * 60.0 + utcNow.GetSecond() + utcNow.GetMillisecond() / 1000.0;
+}
+
+float FDISTimestampClock::GetTimestampAge(const FEntityID& SenderID, uint32 Timestamp)
+{
+	if (Timestamp == 0)
+	{
+		return 0;
+	}
+
+	const double monotonicTime = FPlatformTime::Seconds();
+	const double secondsPastHour = GetSecondsPastHour(Timestamp);
+
+	if (IsAbsolute(Timestamp))
+	{
+		//Absolute timestamps share the local UTC clock, so their age includes the whole network and queueing delay
+		const double age = WrapSeconds(GetUTCSecondsPastHour(monotonicTime) - secondsPastHour);
+		if (age >= 0 && age <= MaxAgeSeconds)
+		{
+			return age;
+		}
+	}
+
+	//Relative timestamps and absolute timestamps from an unsynchronized clock are related to the local clock through the sender's offset
+	return GetRelativeTimestampAge(SenderID, secondsPastHour, monotonicTime);
+}
+
+float FDISTimestampClock::GetRelativeTimestampAge(const FEntityID& SenderID, double SecondsPastHour, double MonotonicTime)
+{
+	const uint32 senderKey = (uint32(SenderID.Site) << 16) | uint32(SenderID.Application);
+	const double offset = MonotonicTime - SecondsPastHour;
+
+	FSenderClock* senderClock = SenderClocks.Find(senderKey);
+	if (senderClock == nullptr)
+	{
+		SenderClocks.Add(senderKey, FSenderClock{ offset, MonotonicTime });
+		return 0;
+	}
+
+	const double offsetDifference = WrapSeconds(offset - senderClock->Offset);
+	if (offsetDifference > MaxAgeSeconds)
+	{
+		//The sender's clock jumped, or it does not run at all, so start over from this timestamp
+		senderClock->Offset = offset;
+	}
+	else if (offsetDifference < 0)
+	{
+		//Faster than any PDU before it, so this is the new smallest delay
+		senderClock->Offset += offsetDifference;
+	}
+	else
+	{
+		senderClock->Offset += FMath::Min(offsetDifference, (MonotonicTime - senderClock->LastUpdateTime) * CLOCK_DRIFT_RATE);
+	}
+	senderClock->LastUpdateTime = MonotonicTime;
+
+	return FMath::Clamp(WrapSeconds(offset - senderClock->Offset), 0.0, double(MaxAgeSeconds));
+}
+
+uint32 FDISTimestampClock::MakeAbsoluteTimestamp(const FDateTime& UTCTime)
+{
+	const double secondsPastHour = UTCTime.GetMinute() * 60.0 + UTCTime.GetSecond() + UTCTime.GetMillisecond() / 1000.0;
+	const uint32 timeUnits = static_cast<uint32>(FMath::Min(secondsPastHour / SECONDS_PER_TIMESTAMP_UNIT, 2147483647.0));
+	return (timeUnits << 1) | 1;
+}
+
+double FDISTimestampClock::WrapSeconds(double Seconds)
+{
+	return Seconds - 3600.0 * FMath::FloorToDouble((Seconds + 1800.0) / 3600.0);
+}
+
+double FDISTimestampClock::GetUTCSecondsPastHour(double MonotonicTime) const
+{
+	return FMath::Fmod(UTCSecondsPastHourAtStart + (MonotonicTime - MonotonicTimeAtStart), 3600.0);
+}
@@ -0,0 +1,174 @@
+// Copyright 2022 Gaming Research Integration for Learning Lab. All Rights Reserved.
+
+#include "DISTimingWheel.h"
+
+FDISTimingWheel::FDISTimingWheel(double TickSecondsIn)
+	: TickSeconds(FMath::Max(TickSecondsIn, 0.001))
+	, CurrentTick(0)
+	, NumScheduled(0)
+{
+}
+
+void FDISTimingWheel::Schedule(FDISEntityHandle Handle, double CurrentTime, float TimeoutSeconds)
+{
+	if (!Handle.IsSet())
+	{
+		return;
+	}
+
+	if (Handle.Index >= Timers.Num())
+	{
+		Timers.SetNum(Handle.Index + 1);
+	}
+
+	//With nothing scheduled the wheel can jump straight to the current time instead of stepping through empty ticks
+	if (NumScheduled == 0)
+	{
+		CurrentTick = FMath::Max(CurrentTick, ToTick(CurrentTime));
+	}
+
+	FTimer& timer = Timers[Handle.Index];
+	if (!timer.bScheduled)
+	{
+		NumScheduled++;
+	}
+
+	timer.Generation = Handle.Generation;
+	timer.TimeoutSeconds = TimeoutSeconds;
+	timer.Deadline = CurrentTime + TimeoutSeconds;
+	timer.bScheduled = true;
+
+	Insert(Handle.Index);
+}
+
+bool FDISTimingWheel::Refresh(FDISEntityHandle Handle, double CurrentTime)
+{
+	if (!Timers.IsValidIndex(Handle.Index))
+	{
+		return false;
+	}
+
+	FTimer& timer = Timers[Handle.Index];
+	if (!timer.bScheduled || timer.Generation != Handle.Generation)
+	{
+		return false;
+	}
+
+	//The entry is moved to its new slot when its current slot comes around
+	timer.Deadline = CurrentTime + timer.TimeoutSeconds;
+	return true;
+}
+
+void FDISTimingWheel::Cancel(FDISEntityHandle Handle)
+{
+	if (!Timers.IsValidIndex(Handle.Index))
+	{
+		return;
+	}
+
+	FTimer& timer = Timers[Handle.Index];
+	if (timer.bScheduled && timer.Generation == Handle.Generation)
+	{
+		//Leave the entry in its slot, it is ignored once the schedule ID no longer matches
+		timer.bScheduled = false;
+		timer.ScheduleID++;
+		NumScheduled--;
+	}
+}
+
+void FDISTimingWheel::Reset()
+{
+	for (int32 level = 0; level < NUMBER_OF_LEVELS; level++)
+	{
+		for (TArray<FSlotEntry>& slot : Slots[level])
+		{
+			slot.Reset();
+		}
+	}
+
+	Timers.Reset();
+	NumScheduled = 0;
+	CurrentTick = 0;
+}
+
+void FDISTimingWheel::Advance(double CurrentTime, TArray<FDISEntityHandle>& OutExpiredHandles)
+{
+	const uint64 targetTick = ToTick(CurrentTime);
+
+	if (NumScheduled == 0)
+	{
+		CurrentTick = FMath::Max(CurrentTick, targetTick);
+		return;
+	}
+
+	while (CurrentTick < targetTick && NumScheduled > 0)
+	{
+		CurrentTick++;
+
+		//Cascade higher levels down when the lower level wraps around
+		for (int32 level = 1; level < NUMBER_OF_LEVELS; level++)
+		{
+			if ((CurrentTick & ((uint64(1) << (SLOT_BITS * level)) - 1)) != 0)
+			{
+				break;
+			}
+			ProcessSlot(Slots[level][(CurrentTick >> (SLOT_BITS * level)) & SLOT_MASK], CurrentTime, OutExpiredHandles);
+		}
+
+		ProcessSlot(Slots[0][CurrentTick & SLOT_MASK], CurrentTime, OutExpiredHandles);
+	}
+}
+
+void FDISTimingWheel::Insert(int32 TimerIndex)
+{
+	FTimer& timer = Timers[TimerIndex];
+	timer.ScheduleID++;
+
+	//Deadlines that fall in the current tick are handled on the next tick
+	const uint64 deadlineTick = FMath::Max(ToTick(timer.Deadline), CurrentTick + 1);
+	const uint64 ticksUntilDeadline = deadlineTick - CurrentTick;
+
+	int32 level = 0;
+	while (level < NUMBER_OF_LEVELS - 1 && ticksUntilDeadline >= (uint64(1) << (SLOT_BITS * (level + 1))))
+	{
+		level++;
+	}
+
+	//Deadlines beyond the span of the wheel wait in the top level and are moved again when their slot comes around
+	const uint64 slotTick = FMath::Min(deadlineTick, CurrentTick + (uint64(1) << (SLOT_BITS * NUMBER_OF_LEVELS)) - 1);
+	Slots[level][(slotTick >> (SLOT_BITS * level)) & SLOT_MASK].Add({ TimerIndex, timer.ScheduleID });
+}
+
+void FDISTimingWheel::ProcessSlot(TArray<FSlotEntry>& Slot, double CurrentTime, TArray<FDISEntityHandle>& OutExpiredHandles)
+{
+	if (Slot.Num() == 0)
+	{
+		return;
+	}
+
+	Swap(Slot, ProcessingSlot);
+
+	for (const FSlotEntry& entry : ProcessingSlot)
+	{
+		FTimer& timer = Timers[entry.TimerIndex];
+		if (!timer.bScheduled || timer.ScheduleID != entry.ScheduleID)
+		{
+			continue;
+		}
+
+		if (ToTick(timer.Deadline) <= CurrentTick)
+		{
+			timer.bScheduled = false;
+			timer.ScheduleID++;
+			NumScheduled--;
+			OutExpiredHandles.Add(FDISEntityHandle(entry.TimerIndex, timer.Generation));
+		}
+		else
+		{
+			//The timeout was refreshed since the entry was placed, so move it to the slot of its current deadline
+			Insert(entry.TimerIndex);
+		}
+	}
+
+	ProcessingSlot.Reset();
+}
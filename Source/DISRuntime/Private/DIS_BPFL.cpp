@@ -486,7 +486,7 @@ void UDIS_BPFL::GetUnrealLocationFromEcefXYZ(const FEarthCenteredEarthFixedDoubl
 	GeoReferencingSystem->ECEFToEngine(cartCoords, UnrealLocation);
 }
 
-void UDIS_BPFL::GetUnrealRotationFromEntityStatePdu(const FEntityStatePDU EntityStatePdu, AGeoReferencingSystem* GeoReferencingSystem, FRotator& UnrealRotation)
+void UDIS_BPFL::GetUnrealRotationFromEntityStatePdu(const FEntityStatePDU& EntityStatePdu, AGeoReferencingSystem* GeoReferencingSystem, FRotator& UnrealRotation)
 {
 	if (!IsValid(GeoReferencingSystem))
 	{
@@ -505,7 +505,7 @@ void UDIS_BPFL::GetUnrealRotationFromEntityStatePdu(const FEntityStatePDU Entity
 	GetUnrealRotationFromPsiThetaPhiRadiansAtLatLon(PsiThetaPhiRadians, LatLonHeightDouble.Latitude, LatLonHeightDouble.Longitude, GeoReferencingSystem, UnrealRotation);
 }
 
-void UDIS_BPFL::GetUnrealLocationFromEntityStatePdu(const FEntityStatePDU EntityStatePdu, AGeoReferencingSystem* GeoReferencingSystem, FVector& UnrealLocation)
+void UDIS_BPFL::GetUnrealLocationFromEntityStatePdu(const FEntityStatePDU& EntityStatePdu, AGeoReferencingSystem* GeoReferencingSystem, FVector& UnrealLocation)
 {
 	if (!IsValid(GeoReferencingSystem))
 	{
@@ -521,7 +521,7 @@ void UDIS_BPFL::GetUnrealLocationFromEntityStatePdu(const FEntityStatePDU Entity
 	GeoReferencingSystem->ECEFToEngine(cartCoords, UnrealLocation);
 }
 
-void UDIS_BPFL::GetUnrealLocationAndOrientationFromEntityStatePdu(const FEntityStatePDU EntityStatePdu, AGeoReferencingSystem* GeoReferencingSystem, FVector& UnrealLocation, FRotator& UnrealRotation)
+void UDIS_BPFL::GetUnrealLocationAndOrientationFromEntityStatePdu(const FEntityStatePDU& EntityStatePdu, AGeoReferencingSystem* GeoReferencingSystem, FVector& UnrealLocation, FRotator& UnrealRotation)
 {
 	if (!IsValid(GeoReferencingSystem))
 	{
@@ -3,6 +3,7 @@
 
 #include "DeadReckoning_BPFL.h"
 #include "Algo/Reverse.h"
+#include "DISDeadReckoningKernel.h"
 
 const double UDeadReckoning_BPFL::MIN_ROTATION_RATE = 0.2 * glm::pi<double>() / 180;  // minimum significant rate = 1deg/5sec
 
@@ -15,18 +16,14 @@ bool UDeadReckoning_BPFL::IsMachineLittleEndian()
 	return (e == (char)1);
 }
 
-FRotator UDeadReckoning_BPFL::CalculateDeadReckonedEulerAnglesFromQuaternion(glm::dvec3 AngularVelocityVector, FQuat EntityRotationQuaternion, float DeltaTime)
+FRotator UDeadReckoning_BPFL::ConvertQuaternionToPsiThetaPhiRadians(const FQuat& EntityRotationQuaternion)
 {
-	//Calculate dead reckoning orienation quaternion
-	FQuat deadReckonedQuaternion = CreateDeadReckoningQuaternion(AngularVelocityVector, DeltaTime);
-	FQuat finalDeadReckonedQuat = EntityRotationQuaternion * deadReckonedQuaternion;
-
 	//Convert quaternion to Psi, Thet, Phi
-	float psi = FMath::Atan2(2 * (finalDeadReckonedQuat.X * finalDeadReckonedQuat.Y + finalDeadReckonedQuat.W * finalDeadReckonedQuat.Z),
-		(FMath::Square(finalDeadReckonedQuat.W) + FMath::Square(finalDeadReckonedQuat.X) - FMath::Square(finalDeadReckonedQuat.Y) - FMath::Square(finalDeadReckonedQuat.Z)));
-	float theta = FMath::Asin(-2 * (finalDeadReckonedQuat.X * finalDeadReckonedQuat.Z - finalDeadReckonedQuat.W * finalDeadReckonedQuat.Y));
-	float phi = FMath::Atan2(2 * (finalDeadReckonedQuat.Y * finalDeadReckonedQuat.Z + finalDeadReckonedQuat.W * finalDeadReckonedQuat.X),
-		(FMath::Square(finalDeadReckonedQuat.W) - FMath::Square(finalDeadReckonedQuat.X) - FMath::Square(finalDeadReckonedQuat.Y) + FMath::Square(finalDeadReckonedQuat.Z)));
+	float psi = FMath::Atan2(2 * (EntityRotationQuaternion.X * EntityRotationQuaternion.Y + EntityRotationQuaternion.W * EntityRotationQuaternion.Z),
+		(FMath::Square(EntityRotationQuaternion.W) + FMath::Square(EntityRotationQuaternion.X) - FMath::Square(EntityRotationQuaternion.Y) - FMath::Square(EntityRotationQuaternion.Z)));
+	float theta = FMath::Asin(-2 * (EntityRotationQuaternion.X * EntityRotationQuaternion.Z - EntityRotationQuaternion.W * EntityRotationQuaternion.Y));
+	float phi = FMath::Atan2(2 * (EntityRotationQuaternion.Y * EntityRotationQuaternion.Z + EntityRotationQuaternion.W * EntityRotationQuaternion.X),
+		(FMath::Square(EntityRotationQuaternion.W) - FMath::Square(EntityRotationQuaternion.X) - FMath::Square(EntityRotationQuaternion.Y) + FMath::Square(EntityRotationQuaternion.Z)));
 
 	if (theta == glm::pi<float>() / 2)
 	{
@@ -138,7 +135,7 @@ TArray<uint8> UDeadReckoning_BPFL::FormOtherParameters(EDeadReckoningAlgorithm D
 	return otherParameters;
 }
 
-bool UDeadReckoning_BPFL::GetLocalEulerAngles(TArray<uint8> OtherDeadReckoningParameters, FRotator& LocalRotator)
+bool UDeadReckoning_BPFL::GetLocalEulerAngles(TArrayView<const uint8> OtherDeadReckoningParameters, FRotator& LocalRotator)
 {
 	// Ensure the Array is at least 15 bytes long
 	if (OtherDeadReckoningParameters.Num() < 15) return false;
@@ -173,10 +170,10 @@ bool UDeadReckoning_BPFL::GetLocalEulerAngles(TArray<uint8> OtherDeadReckoningPa
 	return true;
 }
 
-void UDeadReckoning_BPFL::ConvertLocalRotatorToPsiThetaPhiRadians(FEntityStatePDU EntityPDUToDeadReckon, FRotator LocalRotatorRadians, FPsiThetaPhi& PsiThetaPhiRadians)
+void UDeadReckoning_BPFL::ConvertLocalRotatorToPsiThetaPhiRadians(const double EntityECEFLocation[3], FRotator LocalRotatorRadians, FPsiThetaPhi& PsiThetaPhiRadians)
 {
 	//Convert Local Rotator from Heading, Pitch, Roll to Psi, Theta, Phi
-	FEarthCenteredEarthFixedDouble ecef = FEarthCenteredEarthFixedDouble(EntityPDUToDeadReckon.EntityLocationDouble[0], EntityPDUToDeadReckon.EntityLocationDouble[1], EntityPDUToDeadReckon.EntityLocationDouble[2]);
+	FEarthCenteredEarthFixedDouble ecef = FEarthCenteredEarthFixedDouble(EntityECEFLocation[0], EntityECEFLocation[1], EntityECEFLocation[2]);
 	FLatLonHeightDouble llh;
 	UDIS_BPFL::CalculateLatLonHeightFromEcefXYZ(ecef, llh);
 
@@ -184,7 +181,7 @@ void UDeadReckoning_BPFL::ConvertLocalRotatorToPsiThetaPhiRadians(FEntityStatePD
 	UDIS_BPFL::CalculatePsiThetaPhiRadiansFromHeadingPitchRollRadiansAtLatLon(hprRadians, llh.Latitude, llh.Longitude, PsiThetaPhiRadians);
 }
 
-bool UDeadReckoning_BPFL::GetLocalQuaternionAngles(TArray<uint8> OtherDeadReckoningParameters, FQuat& EntityOrientation)
+bool UDeadReckoning_BPFL::GetLocalQuaternionAngles(TArrayView<const uint8> OtherDeadReckoningParameters, FQuat& EntityOrientation)
 {
 	// Ensure the array is at least 15 bytes long
 	if (OtherDeadReckoningParameters.Num() < 15) return false;
@@ -224,12 +221,6 @@ bool UDeadReckoning_BPFL::GetLocalQuaternionAngles(TArray<uint8> OtherDeadReckon
 	return true;
 }
 
-glm::dvec3 UDeadReckoning_BPFL::CalculateDeadReckonedPosition(const glm::dvec3 PositionVector, const glm::dvec3 VelocityVector,
-	const glm::dvec3 AccelerationVector, const double DeltaTime)
-{
-	return PositionVector + (VelocityVector * DeltaTime) + (0.5 * AccelerationVector * FMath::Square(DeltaTime));
-}
-
 glm::dmat3 UDeadReckoning_BPFL::CreateDeadReckoningMatrix(glm::dvec3 AngularVelocityVector, double DeltaTime)
 {
 	double AngularVelocityMagnitude = glm::length(AngularVelocityVector);
@@ -310,397 +301,43 @@ FQuat UDeadReckoning_BPFL::GetEntityOrientationQuaternion(double PsiRadians, dou
 	return entityQuaternion;
 }
 
-void UDeadReckoning_BPFL::CalculateDeadReckonedOrientation(const double PsiRadians, const double ThetaRadians, const double PhiRadians,
-	const glm::dvec3 AngularVelocityVector, const float DeltaTime, double& OutPsiRadians, double& OutThetaRadians, double& OutPhiRadians)
+FRotator UDeadReckoning_BPFL::ConvertOrientationMatrixToPsiThetaPhiRadians(const glm::dmat3& OrientationMatrix)
 {
-	// Get the entity's current orientation matrix
-	auto OrientationMatrix = GetEntityOrientationMatrix(PsiRadians, ThetaRadians, PhiRadians);
-
-	// Get the change in rotation for this time step
-	const auto DeadReckoningMatrix = CreateDeadReckoningMatrix(AngularVelocityVector, DeltaTime);
-
-	// Calculate the new orientation matrix
-	OrientationMatrix = DeadReckoningMatrix * OrientationMatrix;
-
 	// Extract Euler angles from orientation matrix
-	OutThetaRadians = glm::asin(-OrientationMatrix[2][0]);
+	double thetaRadians = glm::asin(-OrientationMatrix[2][0]);
 
 	// Special case for |Theta| = pi/2
-	double CosThetaRadians = 1e-5;
-	if (abs(OutThetaRadians) != glm::pi<double>() / 2)
+	double cosThetaRadians = 1e-5;
+	if (abs(thetaRadians) != glm::pi<double>() / 2)
 	{
-		CosThetaRadians = glm::cos(OutThetaRadians);
+		cosThetaRadians = glm::cos(thetaRadians);
 	}
-	OutPsiRadians = glm::acos(FMath::Clamp(OrientationMatrix[0][0] / CosThetaRadians, -1.0, 1.0)) * (abs(OrientationMatrix[1][0]) / OrientationMatrix[1][0]);
-	OutPhiRadians = glm::acos(FMath::Clamp(OrientationMatrix[2][2] / CosThetaRadians, -1.0, 1.0)) * (abs(OrientationMatrix[2][1]) / OrientationMatrix[2][1]);
+	double psiRadians = glm::acos(FMath::Clamp(OrientationMatrix[0][0] / cosThetaRadians, -1.0, 1.0)) * (abs(OrientationMatrix[1][0]) / OrientationMatrix[1][0]);
+	double phiRadians = glm::acos(FMath::Clamp(OrientationMatrix[2][2] / cosThetaRadians, -1.0, 1.0)) * (abs(OrientationMatrix[2][1]) / OrientationMatrix[2][1]);
+
+	//NOTE: Roll=Phi, Pitch=Theta, Yaw=Psi
+	return FRotator(thetaRadians, psiRadians, phiRadians);
 }
 
-glm::dvec3 UDeadReckoning_BPFL::GetEntityBodyDeadReckonedPosition(const glm::dvec3 InitialPositionVector, const glm::dvec3 BodyVelocityVector, const glm::dvec3 BodyLinearAccelerationVector, const glm::dvec3 BodyAngularVelocityVector, const glm::dvec3 EntityOrientation, const double DeltaTime)
+bool UDeadReckoning_BPFL::DeadReckoning(const FEntityStatePDU& EntityPDUToDeadReckon, float DeltaTime, FEntityStatePDU& DeadReckonedEntityPDU)
 {
-	const auto SkewMatrix = UDIS_BPFL::CreateNCrossXMatrix(BodyAngularVelocityVector);
-	const auto BodyAccelerationVector = BodyLinearAccelerationVector - (SkewMatrix * BodyVelocityVector);
-
-	// Get the entity's current orientation matrix
-	const auto OrientationMatrix = GetEntityOrientationMatrix(EntityOrientation.x, EntityOrientation.y, EntityOrientation.z);
-	const auto InverseInitialOrientationMatrix = glm::transpose(OrientationMatrix);
+	const FDISEntityState entityState(EntityPDUToDeadReckon);
+	FDISEntityState deadReckonedEntityState;
+	const bool bSupported = DeadReckonEntityState(entityState, DeltaTime, deadReckonedEntityState);
 
-	// Calculate R1
-	const auto OmegaMatrix = glm::dmat3x3(BodyAngularVelocityVector, glm::dvec3(0), glm::dvec3(0)) * glm::transpose(glm::dmat3x3(BodyAngularVelocityVector, glm::dvec3(0), glm::dvec3(0)));
-	double AngularVelocityMagnitude = glm::length(BodyAngularVelocityVector);
-
-	glm::dmat3 R1 = glm::dmat3();
-	glm::dmat3 R2 = glm::dmat3();
-
-	if (AngularVelocityMagnitude < MIN_ROTATION_RATE)
-	{
-		R1 = glm::dmat3(1) * DeltaTime;
-		R2 = glm::dmat3(1) * (glm::pow(DeltaTime, 2) / 2);
-	}
-	else
-	{
-		R1 = (((AngularVelocityMagnitude * DeltaTime - glm::sin(AngularVelocityMagnitude * DeltaTime)) / glm::pow(AngularVelocityMagnitude, 3)) * OmegaMatrix) +
-			(glm::sin(AngularVelocityMagnitude * DeltaTime) / AngularVelocityMagnitude * glm::dmat3(1)) +
-			(((1 - glm::cos(AngularVelocityMagnitude * DeltaTime)) / glm::pow(AngularVelocityMagnitude, 2)) * SkewMatrix);
-
-		R2 = ((((0.5 * glm::pow(AngularVelocityMagnitude, 2) * glm::pow(DeltaTime, 2)) - (glm::cos(AngularVelocityMagnitude * DeltaTime)) - (AngularVelocityMagnitude * DeltaTime * glm::sin(AngularVelocityMagnitude * DeltaTime)) + (1)) / glm::pow(AngularVelocityMagnitude, 4)) * OmegaMatrix) +
-			(((glm::cos(AngularVelocityMagnitude * DeltaTime)) + (AngularVelocityMagnitude * DeltaTime * glm::sin(AngularVelocityMagnitude * DeltaTime)) - (1)) / (glm::pow(AngularVelocityMagnitude, 2)) * glm::dmat3(1)) +
-			((((glm::sin(AngularVelocityMagnitude * DeltaTime)) - (AngularVelocityMagnitude * DeltaTime * glm::cos(AngularVelocityMagnitude * DeltaTime))) / (glm::pow(AngularVelocityMagnitude, 3))) * SkewMatrix);
-	}
+	//Dead reckoning only changes the kinematic fields of the PDU
+	DeadReckonedEntityPDU = EntityPDUToDeadReckon;
+	deadReckonedEntityState.CopyKinematicsToEntityStatePDU(DeadReckonedEntityPDU);
 
-	return InitialPositionVector + InverseInitialOrientationMatrix * ((R1 * BodyVelocityVector) + (R2 * BodyAccelerationVector));
+	return bSupported;
 }
 
-bool UDeadReckoning_BPFL::DeadReckoning(FEntityStatePDU EntityPDUToDeadReckon, float DeltaTime, FEntityStatePDU& DeadReckonedEntityPDU)
+bool UDeadReckoning_BPFL::DeadReckonEntityState(const FDISEntityState& EntityStateToDeadReckon, float DeltaTime, FDISEntityState& DeadReckonedEntityState)
 {
-	DeadReckonedEntityPDU = EntityPDUToDeadReckon;
-	bool bSupported = true;
-
-	//If the entity is frozen, don't update dead reckoning
-	if (EntityPDUToDeadReckon.EntityAppearance.IsFrozen)
-	{
-		return false;
-	}
-
-	switch (EntityPDUToDeadReckon.DeadReckoningParameters.DeadReckoningAlgorithm)
-	{
-	case EDeadReckoningAlgorithm::Static: // Static
-	{
-		FRotator LocalRotator;
-		bool bUseOtherParams = GetLocalEulerAngles(EntityPDUToDeadReckon.DeadReckoningParameters.OtherParameters, LocalRotator);
-
-		if (bUseOtherParams)
-		{
-			FPsiThetaPhi psiThetaPhiRadians;
-			ConvertLocalRotatorToPsiThetaPhiRadians(EntityPDUToDeadReckon, LocalRotator, psiThetaPhiRadians);
-			DeadReckonedEntityPDU.EntityOrientation = FRotator(psiThetaPhiRadians.Theta, psiThetaPhiRadians.Psi, psiThetaPhiRadians.Phi);
-		}
-
-		break;
-	}
-
-	case EDeadReckoningAlgorithm::FPW: // Fixed Position World (FPW)
-	{
-		// Set entity orientation
-		FRotator LocalRotator;
-		bool bUseOtherParams = GetLocalEulerAngles(EntityPDUToDeadReckon.DeadReckoningParameters.OtherParameters, LocalRotator);
-
-		// Calculate and set entity location
-		glm::dvec3 PositionVector = glm::dvec3(EntityPDUToDeadReckon.EntityLocationDouble[0], EntityPDUToDeadReckon.EntityLocationDouble[1], EntityPDUToDeadReckon.EntityLocationDouble[2]);
-		glm::dvec3 VelocityVector = glm::dvec3(EntityPDUToDeadReckon.EntityLinearVelocity.X, EntityPDUToDeadReckon.EntityLinearVelocity.Y, EntityPDUToDeadReckon.EntityLinearVelocity.Z);
-
-		auto CalculatedPositionVector = CalculateDeadReckonedPosition(PositionVector, VelocityVector, glm::dvec3(0), DeltaTime);
-
-		DeadReckonedEntityPDU.EntityLocationDouble[0] = CalculatedPositionVector[0];
-		DeadReckonedEntityPDU.EntityLocationDouble[1] = CalculatedPositionVector[1];
-		DeadReckonedEntityPDU.EntityLocationDouble[2] = CalculatedPositionVector[2];
-
-		DeadReckonedEntityPDU.EntityLocation.X = CalculatedPositionVector[0];
-		DeadReckonedEntityPDU.EntityLocation.Y = CalculatedPositionVector[1];
-		DeadReckonedEntityPDU.EntityLocation.Z = CalculatedPositionVector[2];
-
-		if (bUseOtherParams)
-		{
-			FPsiThetaPhi psiThetaPhiRadians;
-			ConvertLocalRotatorToPsiThetaPhiRadians(EntityPDUToDeadReckon, LocalRotator, psiThetaPhiRadians);
-			DeadReckonedEntityPDU.EntityOrientation = FRotator(psiThetaPhiRadians.Theta, psiThetaPhiRadians.Psi, psiThetaPhiRadians.Phi);
-		}
-		break;
-	}
-
-	case EDeadReckoningAlgorithm::RPW: // Rotation Position World (RPW)
-	{
-		FQuat EntityRotationQuaternion;
-		bool bUseOtherParams = GetLocalQuaternionAngles(DeadReckonedEntityPDU.DeadReckoningParameters.OtherParameters, EntityRotationQuaternion);
-
-		// Calculate and set entity location
-		glm::dvec3 PositionVector = glm::dvec3(EntityPDUToDeadReckon.EntityLocationDouble[0], EntityPDUToDeadReckon.EntityLocationDouble[1], EntityPDUToDeadReckon.EntityLocationDouble[2]);
-		glm::dvec3 VelocityVector = glm::dvec3(EntityPDUToDeadReckon.EntityLinearVelocity.X, EntityPDUToDeadReckon.EntityLinearVelocity.Y, EntityPDUToDeadReckon.EntityLinearVelocity.Z);
-
-		auto CalculatedPositionVector = CalculateDeadReckonedPosition(PositionVector, VelocityVector, glm::dvec3(0), DeltaTime);
-
-		DeadReckonedEntityPDU.EntityLocationDouble[0] = CalculatedPositionVector[0];
-		DeadReckonedEntityPDU.EntityLocationDouble[1] = CalculatedPositionVector[1];
-		DeadReckonedEntityPDU.EntityLocationDouble[2] = CalculatedPositionVector[2];
-
-		DeadReckonedEntityPDU.EntityLocation.X = CalculatedPositionVector[0];
-		DeadReckonedEntityPDU.EntityLocation.Y = CalculatedPositionVector[1];
-		DeadReckonedEntityPDU.EntityLocation.Z = CalculatedPositionVector[2];
-
-		if (bUseOtherParams)
-		{
-			auto AngularVelocityVector = glm::dvec3(EntityPDUToDeadReckon.DeadReckoningParameters.EntityAngularVelocity.X,
-				EntityPDUToDeadReckon.DeadReckoningParameters.EntityAngularVelocity.Y, EntityPDUToDeadReckon.DeadReckoningParameters.EntityAngularVelocity.Z);
-
-			DeadReckonedEntityPDU.EntityOrientation = CalculateDeadReckonedEulerAnglesFromQuaternion(AngularVelocityVector, EntityRotationQuaternion, DeltaTime);
-		}
-		else
-		{
-			glm::dvec3 AngularVelocityVector = glm::dvec3(EntityPDUToDeadReckon.DeadReckoningParameters.EntityAngularVelocity.X,
-				EntityPDUToDeadReckon.DeadReckoningParameters.EntityAngularVelocity.Y, EntityPDUToDeadReckon.DeadReckoningParameters.EntityAngularVelocity.Z);
-			//NOTE: Roll=Phi, Pitch=Theta, Yaw=Psi
-			double PsiRadians, ThetaRadians, PhiRadians;
-			CalculateDeadReckonedOrientation(EntityPDUToDeadReckon.EntityOrientation.Yaw,
-				EntityPDUToDeadReckon.EntityOrientation.Pitch, EntityPDUToDeadReckon.EntityOrientation.Roll, AngularVelocityVector, DeltaTime, PsiRadians, ThetaRadians, PhiRadians);
-
-			DeadReckonedEntityPDU.EntityOrientation = FRotator(ThetaRadians, PsiRadians, PhiRadians);
-		}
-		break;
-	}
-
-	case EDeadReckoningAlgorithm::RVW: // Rotation Velocity World (RVW)
-	{
-		FQuat EntityRotationQuaternion;
-		bool bUseOtherParams = GetLocalQuaternionAngles(DeadReckonedEntityPDU.DeadReckoningParameters.OtherParameters, EntityRotationQuaternion);
-
-		// Calculate and set entity location
-		glm::dvec3 PositionVector = glm::dvec3(EntityPDUToDeadReckon.EntityLocationDouble[0], EntityPDUToDeadReckon.EntityLocationDouble[1], EntityPDUToDeadReckon.EntityLocationDouble[2]);
-		glm::dvec3 VelocityVector = glm::dvec3(EntityPDUToDeadReckon.EntityLinearVelocity.X, EntityPDUToDeadReckon.EntityLinearVelocity.Y, EntityPDUToDeadReckon.EntityLinearVelocity.Z);
-		glm::dvec3 AccelerationVector = glm::dvec3(EntityPDUToDeadReckon.DeadReckoningParameters.EntityLinearAcceleration.X,
-			EntityPDUToDeadReckon.DeadReckoningParameters.EntityLinearAcceleration.Y, EntityPDUToDeadReckon.DeadReckoningParameters.EntityLinearAcceleration.Z);
-
-		auto CalculatedPositionVector = CalculateDeadReckonedPosition(PositionVector, VelocityVector, AccelerationVector, DeltaTime);
-
-		DeadReckonedEntityPDU.EntityLocationDouble[0] = CalculatedPositionVector[0];
-		DeadReckonedEntityPDU.EntityLocationDouble[1] = CalculatedPositionVector[1];
-		DeadReckonedEntityPDU.EntityLocationDouble[2] = CalculatedPositionVector[2];
-
-		DeadReckonedEntityPDU.EntityLocation.X = CalculatedPositionVector[0];
-		DeadReckonedEntityPDU.EntityLocation.Y = CalculatedPositionVector[1];
-		DeadReckonedEntityPDU.EntityLocation.Z = CalculatedPositionVector[2];
-
-		if (bUseOtherParams)
-		{
-			auto AngularVelocityVector = glm::dvec3(EntityPDUToDeadReckon.DeadReckoningParameters.EntityAngularVelocity.X,
-				EntityPDUToDeadReckon.DeadReckoningParameters.EntityAngularVelocity.Y, EntityPDUToDeadReckon.DeadReckoningParameters.EntityAngularVelocity.Z);
-
-			DeadReckonedEntityPDU.EntityOrientation = CalculateDeadReckonedEulerAnglesFromQuaternion(AngularVelocityVector, EntityRotationQuaternion, DeltaTime);
-		}
-		else
-		{
-			glm::dvec3 AngularVelocityVector = glm::dvec3(EntityPDUToDeadReckon.DeadReckoningParameters.EntityAngularVelocity.X,
-				EntityPDUToDeadReckon.DeadReckoningParameters.EntityAngularVelocity.Y, EntityPDUToDeadReckon.DeadReckoningParameters.EntityAngularVelocity.Z);
-			//NOTE: Roll=Phi, Pitch=Theta, Yaw=Psi
-			double PsiRadians, ThetaRadians, PhiRadians;
-			CalculateDeadReckonedOrientation(EntityPDUToDeadReckon.EntityOrientation.Yaw, EntityPDUToDeadReckon.EntityOrientation.Pitch,
-				EntityPDUToDeadReckon.EntityOrientation.Roll, AngularVelocityVector, DeltaTime, PsiRadians, ThetaRadians, PhiRadians);
-
-			DeadReckonedEntityPDU.EntityOrientation = FRotator(ThetaRadians, PsiRadians, PhiRadians);
-		}
-		break;
-	}
-
-	case EDeadReckoningAlgorithm::FVW: // Fixed Velocity World (FVW)
-	{
-		FRotator LocalRotator;
-		bool bUseOtherParams = GetLocalEulerAngles(EntityPDUToDeadReckon.DeadReckoningParameters.OtherParameters, LocalRotator);
-
-		// Calculate and set entity location
-		glm::dvec3 PositionVector = glm::dvec3(EntityPDUToDeadReckon.EntityLocationDouble[0], EntityPDUToDeadReckon.EntityLocationDouble[1], EntityPDUToDeadReckon.EntityLocationDouble[2]);
-		glm::dvec3 VelocityVector = glm::dvec3(EntityPDUToDeadReckon.EntityLinearVelocity.X, EntityPDUToDeadReckon.EntityLinearVelocity.Y, EntityPDUToDeadReckon.EntityLinearVelocity.Z);
-		glm::dvec3 AccelerationVector = glm::dvec3(EntityPDUToDeadReckon.DeadReckoningParameters.EntityLinearAcceleration.X,
-			EntityPDUToDeadReckon.DeadReckoningParameters.EntityLinearAcceleration.Y, EntityPDUToDeadReckon.DeadReckoningParameters.EntityLinearAcceleration.Z);
-
-		auto CalculatedPositionVector = CalculateDeadReckonedPosition(PositionVector, VelocityVector, AccelerationVector, DeltaTime);
-
-		DeadReckonedEntityPDU.EntityLocationDouble[0] = CalculatedPositionVector[0];
-		DeadReckonedEntityPDU.EntityLocationDouble[1] = CalculatedPositionVector[1];
-		DeadReckonedEntityPDU.EntityLocationDouble[2] = CalculatedPositionVector[2];
-
-		DeadReckonedEntityPDU.EntityLocation.X = CalculatedPositionVector[0];
-		DeadReckonedEntityPDU.EntityLocation.Y = CalculatedPositionVector[1];
-		DeadReckonedEntityPDU.EntityLocation.Z = CalculatedPositionVector[2];
-
-		if (bUseOtherParams)
-		{
-			FPsiThetaPhi psiThetaPhiRadians;
-			ConvertLocalRotatorToPsiThetaPhiRadians(EntityPDUToDeadReckon, LocalRotator, psiThetaPhiRadians);
-			DeadReckonedEntityPDU.EntityOrientation = FRotator(psiThetaPhiRadians.Theta, psiThetaPhiRadians.Psi, psiThetaPhiRadians.Phi);
-		}
-		break;
-	}
-
-	case EDeadReckoningAlgorithm::FPB: // Fixed Position Body (FPB)
-	{
-		FRotator LocalRotator;
-		bool bUseOtherParams = GetLocalEulerAngles(EntityPDUToDeadReckon.DeadReckoningParameters.OtherParameters, LocalRotator);
-
-		auto InitialPosition = glm::dvec3(EntityPDUToDeadReckon.EntityLocationDouble[0], EntityPDUToDeadReckon.EntityLocationDouble[1], EntityPDUToDeadReckon.EntityLocationDouble[2]);
-		auto BodyVelocityVector = glm::dvec3(EntityPDUToDeadReckon.EntityLinearVelocity.X, EntityPDUToDeadReckon.EntityLinearVelocity.Y, EntityPDUToDeadReckon.EntityLinearVelocity.Z);
-		auto BodyLinearAccelerationVector = glm::dvec3(EntityPDUToDeadReckon.DeadReckoningParameters.EntityLinearAcceleration.X,
-			EntityPDUToDeadReckon.DeadReckoningParameters.EntityLinearAcceleration.Y, EntityPDUToDeadReckon.DeadReckoningParameters.EntityLinearAcceleration.Z);
-		auto BodyAngularVelocityVector = glm::dvec3(0);
-		auto EntityOrientation = glm::dvec3(EntityPDUToDeadReckon.EntityOrientation.Yaw, EntityPDUToDeadReckon.EntityOrientation.Pitch, EntityPDUToDeadReckon.EntityOrientation.Roll);
-
-		glm::dvec3 CalculatedPositionVector = GetEntityBodyDeadReckonedPosition(InitialPosition, BodyVelocityVector, BodyLinearAccelerationVector,
-			BodyAngularVelocityVector, EntityOrientation, DeltaTime);
-
-		DeadReckonedEntityPDU.EntityLocationDouble[0] = CalculatedPositionVector[0];
-		DeadReckonedEntityPDU.EntityLocationDouble[1] = CalculatedPositionVector[1];
-		DeadReckonedEntityPDU.EntityLocationDouble[2] = CalculatedPositionVector[2];
-
-		DeadReckonedEntityPDU.EntityLocation.X = CalculatedPositionVector[0];
-		DeadReckonedEntityPDU.EntityLocation.Y = CalculatedPositionVector[1];
-		DeadReckonedEntityPDU.EntityLocation.Z = CalculatedPositionVector[2];
-
-		if (bUseOtherParams)
-		{
-			FPsiThetaPhi psiThetaPhiRadians;
-			ConvertLocalRotatorToPsiThetaPhiRadians(EntityPDUToDeadReckon, LocalRotator, psiThetaPhiRadians);
-			DeadReckonedEntityPDU.EntityOrientation = FRotator(psiThetaPhiRadians.Theta, psiThetaPhiRadians.Psi, psiThetaPhiRadians.Phi);
-		}
-
-		break;
-	}
-
-	case EDeadReckoningAlgorithm::RPB: // Rotation Position Body (RPB)
-	{
-		FQuat EntityRotationQuaternion;
-		bool bUseOtherParams = GetLocalQuaternionAngles(DeadReckonedEntityPDU.DeadReckoningParameters.OtherParameters, EntityRotationQuaternion);
-
-		auto InitialPosition = glm::dvec3(EntityPDUToDeadReckon.EntityLocationDouble[0], EntityPDUToDeadReckon.EntityLocationDouble[1], EntityPDUToDeadReckon.EntityLocationDouble[2]);
-		auto BodyVelocityVector = glm::dvec3(EntityPDUToDeadReckon.EntityLinearVelocity.X, EntityPDUToDeadReckon.EntityLinearVelocity.Y, EntityPDUToDeadReckon.EntityLinearVelocity.Z);
-		auto BodyLinearAccelerationVector = glm::dvec3(EntityPDUToDeadReckon.DeadReckoningParameters.EntityLinearAcceleration.X,
-			EntityPDUToDeadReckon.DeadReckoningParameters.EntityLinearAcceleration.Y, EntityPDUToDeadReckon.DeadReckoningParameters.EntityLinearAcceleration.Z);
-		auto BodyAngularVelocityVector = glm::dvec3(0);
-		auto EntityOrientation = glm::dvec3(EntityPDUToDeadReckon.EntityOrientation.Yaw, EntityPDUToDeadReckon.EntityOrientation.Pitch, EntityPDUToDeadReckon.EntityOrientation.Roll);
-
-		glm::dvec3 CalculatedPositionVector = GetEntityBodyDeadReckonedPosition(InitialPosition, BodyVelocityVector, BodyLinearAccelerationVector,
-			BodyAngularVelocityVector, EntityOrientation, DeltaTime);
-
-		DeadReckonedEntityPDU.EntityLocationDouble[0] = CalculatedPositionVector[0];
-		DeadReckonedEntityPDU.EntityLocationDouble[1] = CalculatedPositionVector[1];
-		DeadReckonedEntityPDU.EntityLocationDouble[2] = CalculatedPositionVector[2];
-
-		DeadReckonedEntityPDU.EntityLocation.X = CalculatedPositionVector[0];
-		DeadReckonedEntityPDU.EntityLocation.Y = CalculatedPositionVector[1];
-		DeadReckonedEntityPDU.EntityLocation.Z = CalculatedPositionVector[2];
-
-		if (bUseOtherParams)
-		{
-			auto AngularVelocityVector = glm::dvec3(EntityPDUToDeadReckon.DeadReckoningParameters.EntityAngularVelocity.X,
-				EntityPDUToDeadReckon.DeadReckoningParameters.EntityAngularVelocity.Y, EntityPDUToDeadReckon.DeadReckoningParameters.EntityAngularVelocity.Z);
-
-			DeadReckonedEntityPDU.EntityOrientation = CalculateDeadReckonedEulerAnglesFromQuaternion(AngularVelocityVector, EntityRotationQuaternion, DeltaTime);
-		}
-		else
-		{
-			//NOTE: Roll=Phi, Pitch=Theta, Yaw=Psi
-			double PsiRadians, ThetaRadians, PhiRadians;
-			CalculateDeadReckonedOrientation(EntityPDUToDeadReckon.EntityOrientation.Yaw, EntityPDUToDeadReckon.EntityOrientation.Pitch,
-				EntityPDUToDeadReckon.EntityOrientation.Roll, BodyAngularVelocityVector, DeltaTime, PsiRadians, ThetaRadians, PhiRadians);
-
-			DeadReckonedEntityPDU.EntityOrientation = FRotator(ThetaRadians, PsiRadians, PhiRadians);
-		}
-
-		break;
-	}
-
-	case EDeadReckoningAlgorithm::RVB: // Rotation Velocity Body (RVB)
-	{
-		FQuat EntityRotationQuaternion;
-		bool bUseOtherParams = GetLocalQuaternionAngles(DeadReckonedEntityPDU.DeadReckoningParameters.OtherParameters, EntityRotationQuaternion);
-
-		auto InitialPosition = glm::dvec3(EntityPDUToDeadReckon.EntityLocationDouble[0], EntityPDUToDeadReckon.EntityLocationDouble[1], EntityPDUToDeadReckon.EntityLocationDouble[2]);
-		auto BodyVelocityVector = glm::dvec3(EntityPDUToDeadReckon.EntityLinearVelocity.X, EntityPDUToDeadReckon.EntityLinearVelocity.Y, EntityPDUToDeadReckon.EntityLinearVelocity.Z);
-		auto BodyLinearAccelerationVector = glm::dvec3(EntityPDUToDeadReckon.DeadReckoningParameters.EntityLinearAcceleration.X,
-			EntityPDUToDeadReckon.DeadReckoningParameters.EntityLinearAcceleration.Y, EntityPDUToDeadReckon.DeadReckoningParameters.EntityLinearAcceleration.Z);
-		auto BodyAngularVelocityVector = glm::dvec3(EntityPDUToDeadReckon.DeadReckoningParameters.EntityAngularVelocity.X,
-			EntityPDUToDeadReckon.DeadReckoningParameters.EntityAngularVelocity.Y, EntityPDUToDeadReckon.DeadReckoningParameters.EntityAngularVelocity.Z);
-		auto EntityOrientation = glm::dvec3(EntityPDUToDeadReckon.EntityOrientation.Yaw, EntityPDUToDeadReckon.EntityOrientation.Pitch, EntityPDUToDeadReckon.EntityOrientation.Roll);
-
-		glm::dvec3 CalculatedPositionVector = GetEntityBodyDeadReckonedPosition(InitialPosition, BodyVelocityVector, BodyLinearAccelerationVector,
-			BodyAngularVelocityVector, EntityOrientation, DeltaTime);
-
-		DeadReckonedEntityPDU.EntityLocationDouble[0] = CalculatedPositionVector[0];
-		DeadReckonedEntityPDU.EntityLocationDouble[1] = CalculatedPositionVector[1];
-		DeadReckonedEntityPDU.EntityLocationDouble[2] = CalculatedPositionVector[2];
-
-		DeadReckonedEntityPDU.EntityLocation.X = CalculatedPositionVector[0];
-		DeadReckonedEntityPDU.EntityLocation.Y = CalculatedPositionVector[1];
-		DeadReckonedEntityPDU.EntityLocation.Z = CalculatedPositionVector[2];
-
-		if (bUseOtherParams)
-		{
-			DeadReckonedEntityPDU.EntityOrientation = CalculateDeadReckonedEulerAnglesFromQuaternion(BodyAngularVelocityVector, EntityRotationQuaternion, DeltaTime);
-		}
-		else
-		{
-			//NOTE: Roll=Phi, Pitch=Theta, Yaw=Psi
-			double PsiRadians, ThetaRadians, PhiRadians;
-			CalculateDeadReckonedOrientation(EntityPDUToDeadReckon.EntityOrientation.Yaw, EntityPDUToDeadReckon.EntityOrientation.Pitch,
-				EntityPDUToDeadReckon.EntityOrientation.Roll, BodyAngularVelocityVector, DeltaTime, PsiRadians, ThetaRadians, PhiRadians);
-
-			DeadReckonedEntityPDU.EntityOrientation = FRotator(ThetaRadians, PsiRadians, PhiRadians);
-		}
-
-		break;
-	}
-
-	case EDeadReckoningAlgorithm::FVB: // Fixed Velocity Body (FVB)
-	{
-		FRotator LocalRotator;
-		bool bUseOtherParams = GetLocalEulerAngles(EntityPDUToDeadReckon.DeadReckoningParameters.OtherParameters, LocalRotator);
+	DeadReckonedEntityState = EntityStateToDeadReckon;
 
-		auto InitialPosition = glm::dvec3(EntityPDUToDeadReckon.EntityLocationDouble[0], EntityPDUToDeadReckon.EntityLocationDouble[1], EntityPDUToDeadReckon.EntityLocationDouble[2]);
-		auto BodyVelocityVector = glm::dvec3(EntityPDUToDeadReckon.EntityLinearVelocity.X, EntityPDUToDeadReckon.EntityLinearVelocity.Y, EntityPDUToDeadReckon.EntityLinearVelocity.Z);
-		auto BodyLinearAccelerationVector = glm::dvec3(EntityPDUToDeadReckon.DeadReckoningParameters.EntityLinearAcceleration.X,
-			EntityPDUToDeadReckon.DeadReckoningParameters.EntityLinearAcceleration.Y, EntityPDUToDeadReckon.DeadReckoningParameters.EntityLinearAcceleration.Z);
-		auto BodyAngularVelocityVector = glm::dvec3(EntityPDUToDeadReckon.DeadReckoningParameters.EntityAngularVelocity.X,
-			EntityPDUToDeadReckon.DeadReckoningParameters.EntityAngularVelocity.Y, EntityPDUToDeadReckon.DeadReckoningParameters.EntityAngularVelocity.Z);
-		auto EntityOrientation = glm::dvec3(EntityPDUToDeadReckon.EntityOrientation.Yaw, EntityPDUToDeadReckon.EntityOrientation.Pitch, EntityPDUToDeadReckon.EntityOrientation.Roll);
-
-		glm::dvec3 CalculatedPositionVector = GetEntityBodyDeadReckonedPosition(InitialPosition, BodyVelocityVector, BodyLinearAccelerationVector,
-			BodyAngularVelocityVector, EntityOrientation, DeltaTime);
-
-		DeadReckonedEntityPDU.EntityLocationDouble[0] = CalculatedPositionVector[0];
-		DeadReckonedEntityPDU.EntityLocationDouble[1] = CalculatedPositionVector[1];
-		DeadReckonedEntityPDU.EntityLocationDouble[2] = CalculatedPositionVector[2];
-
-		DeadReckonedEntityPDU.EntityLocation.X = CalculatedPositionVector[0];
-		DeadReckonedEntityPDU.EntityLocation.Y = CalculatedPositionVector[1];
-		DeadReckonedEntityPDU.EntityLocation.Z = CalculatedPositionVector[2];
-
-		if (bUseOtherParams)
-		{
-			FPsiThetaPhi psiThetaPhiRadians;
-			ConvertLocalRotatorToPsiThetaPhiRadians(EntityPDUToDeadReckon, LocalRotator, psiThetaPhiRadians);
-			DeadReckonedEntityPDU.EntityOrientation = FRotator(psiThetaPhiRadians.Theta, psiThetaPhiRadians.Psi, psiThetaPhiRadians.Phi);
-		}
-
-		break;
-	}
-
-	default: // Unknown
-	{
-		bSupported = false;
-		break;
-	}
-	}
-
-	if (bSupported)
-	{
-		DeadReckonedEntityPDU.EntityLinearVelocity += EntityPDUToDeadReckon.DeadReckoningParameters.EntityLinearAcceleration * DeltaTime;
-	}
-
-	return bSupported;
+	//Callers that dead reckon the same state every frame should keep the kernel around instead, see FDISDeadReckoningKernel
+	FDISDeadReckoningKernel deadReckoningKernel;
+	deadReckoningKernel.Precompute(EntityStateToDeadReckon);
+	return deadReckoningKernel.Evaluate(DeltaTime, DeadReckonedEntityState);
 }
@@ -10,15 +10,62 @@ void UPDUProcessor::Initialize(FSubsystemCollectionBase& Collection)
 	Collection.InitializeDependency(UUDPSubsystem::StaticClass());
 	Super::Initialize(Collection);
 
+	InitializePDUDecoders();
+
 	//Get the UDP Subsystem and bind to receiving UDP Bytes
 	GetGameInstance()->GetSubsystem<UUDPSubsystem>()->OnReceivedBytes.AddDynamic(this, &UPDUProcessor::HandleOnReceivedUDPBytes);
 }
 
 void UPDUProcessor::Deinitialize()
 {
+	{
+		FScopeLock lock(&PDUTypeStatisticsCriticalSection);
+		PDUDecoders.Empty();
+		PDUPacketFilters.Empty();
+	}
+
 	Super::Deinitialize();
 }
 
+void UPDUProcessor::InitializePDUDecoders()
+{
+	{
+		FScopeLock lock(&PDUTypeStatisticsCriticalSection);
+		PDUDecoders.SetNum(NUMBER_OF_PDU_TYPES);
+		PDUTypeStatistics.SetNum(NUMBER_OF_PDU_TYPES);
+		PDUPacketFilters.SetNum(NUMBER_OF_PDU_TYPES);
+	}
+	RegisterDefaultPDUDecoders();
+}
+
+void UPDUProcessor::RegisterDefaultPDUDecoders()
+{
+	//For list of enums for PDU type refer to SISO-REF-010-2015, ANNEX A
+	RegisterDefaultPDUDecoder<DIS::EntityStatePdu, FEntityStatePDU>(EPDUType::EntityState, TEXT("Entity State"), OnEntityStatePDUProcessed, OnEntityStatePDUProcessedNative,
+		[this](const TArray<uint8>& InData) { return CheckPDUProperLengthWithArticulationParams(InData.Num(), ENTITY_STATE_PDU_BYTES); });
+
+	RegisterDefaultPDUDecoder<DIS::FirePdu, FFirePDU>(EPDUType::Fire, TEXT("Fire"), OnFirePDUProcessed, OnFirePDUProcessedNative,
+		[this](const TArray<uint8>& InData) { return InData.Num() == FIRE_PDU_BYTES; });
+
+	RegisterDefaultPDUDecoder<DIS::DetonationPdu, FDetonationPDU>(EPDUType::Detonation, TEXT("Detonation"), OnDetonationPDUProcessed, OnDetonationPDUProcessedNative,
+		[this](const TArray<uint8>& InData) { return CheckPDUProperLengthWithArticulationParams(InData.Num(), DETONATION_PDU_BYTES); });
+
+	RegisterDefaultPDUDecoder<DIS::RemoveEntityPdu, FRemoveEntityPDU>(EPDUType::RemoveEntity, TEXT("Remove Entity"), OnRemoveEntityPDUProcessed, OnRemoveEntityPDUProcessedNative,
+		[this](const TArray<uint8>& InData) { return InData.Num() == REMOVE_ENTITY_PDU_BYTES; });
+
+	RegisterDefaultPDUDecoder<DIS::StartResumePdu, FStartResumePDU>(EPDUType::Start_Resume, TEXT("Start Resume"), OnStartResumePDUProcessed, OnStartResumePDUProcessedNative,
+		[this](const TArray<uint8>& InData) { return InData.Num() == START_RESUME_PDU_BYTES; });
+
+	RegisterDefaultPDUDecoder<DIS::StopFreezePdu, FStopFreezePDU>(EPDUType::Stop_Freeze, TEXT("Stop Freeze"), OnStopFreezePDUProcessed, OnStopFreezePDUProcessedNative,
+		[this](const TArray<uint8>& InData) { return InData.Num() == STOP_FREEZE_PDU_BYTES; });
+
+	RegisterDefaultPDUDecoder<DIS::EntityStateUpdatePdu, FEntityStateUpdatePDU>(EPDUType::EntityStateUpdate, TEXT("Entity State Update"), OnEntityStateUpdatePDUProcessed, OnEntityStateUpdatePDUProcessedNative,
+		[this](const TArray<uint8>& InData) { return CheckPDUProperLengthWithArticulationParams(InData.Num(), ENTITY_STATE_UPDATE_PDU_BYTES); });
+
+	RegisterDefaultPDUDecoder<DIS::ElectromagneticEmissionsPdu, FElectromagneticEmissionsPDU>(EPDUType::ElectromagneticEmission, TEXT("Electromagnetic Emission"), OnElectromagneticEmissionsPDUProcessed, OnElectromagneticEmissionsPDUProcessedNative,
+		[this](const TArray<uint8>& InData) { return CheckElectromagneticEmissionPDUProperLength(InData); });
+}
+
 void UPDUProcessor::HandleOnReceivedUDPBytes(const TArray<uint8>& Bytes, const FString& IPAddress)
 {
 	ProcessDISPacket(Bytes);
@@ -29,185 +76,249 @@ void UPDUProcessor::ProcessDISPacket(const TArray<uint8>& InData)
 	SCOPE_CYCLE_COUNTER(STAT_ProcessDISPacket);
 	int bytesArrayLength = InData.Num();
 
-	if (bytesArrayLength < 1)
+	//Need the full PDU header before the PDU type can be trusted
+	if (bytesArrayLength < PDU_HEADER_BYTES)
 	{
 		return;
 	}
 
-	const EPDUType receivedPDUType = static_cast<EPDUType>(InData[PDU_TYPE_POSITION]);
-
-	DIS::DataStream ds((char*)&InData[0], bytesArrayLength, BigEndian);
+	const uint8 receivedPDUType = InData[PDU_TYPE_POSITION];
+	TSharedPtr<const FPDUDecoder, ESPMode::ThreadSafe> decoder;
+	TSharedPtr<FPDUPacketFilter, ESPMode::ThreadSafe> packetFilter;
 
-	//For list of enums for PDU type refer to SISO-REF-010-2015, ANNEX A
-	switch (receivedPDUType)
-	{
-	case EPDUType::EntityState:
 	{
-		if (!CheckPDUProperLengthWithArticulationParams(bytesArrayLength, ENTITY_STATE_PDU_BYTES))
+		//Hold on to the decoder and filter so that they stay alive if they are replaced while the packet is decoded
+		FScopeLock lock(&PDUTypeStatisticsCriticalSection);
+		if (PDUDecoders.Num() != NUMBER_OF_PDU_TYPES)
 		{
-			UE_LOG(LogPDUProcessor, Error, TEXT("Received Entity State PDU packet with an invalid length! Ignoring the PDU."));
 			return;
 		}
+		decoder = PDUDecoders[receivedPDUType];
+		packetFilter = PDUPacketFilters[receivedPDUType];
+	}
 
-		DIS::EntityStatePdu receivedESPDU;
-		receivedESPDU.unmarshal(ds);
-
-		FEntityStatePDU entityStatePDU;
-		entityStatePDU.SetupFromOpenDIS(receivedESPDU);
-
-		OnEntityStatePDUProcessed.Broadcast(entityStatePDU);
-
+	if (!decoder.IsValid() || !decoder->Decode)
+	{
+		RecordPacketStatistics(receivedPDUType, EPacketOutcome::DroppedUnsupported);
 		return;
 	}
-	case EPDUType::Fire:
+	if (!decoder->bEnabled)
 	{
-		if (bytesArrayLength != FIRE_PDU_BYTES)
-		{
-			UE_LOG(LogPDUProcessor, Error, TEXT("Received Fire PDU packet with an invalid length! Ignoring the PDU."));
-			return;
-		}
-
-		DIS::FirePdu receivedFirePDU;
-		receivedFirePDU.unmarshal(ds);
-
-		FFirePDU firePDU;
-		firePDU.SetupFromOpenDIS(receivedFirePDU);
-
-		OnFirePDUProcessed.Broadcast(firePDU);
+		RecordPacketStatistics(receivedPDUType, EPacketOutcome::DroppedDisabled);
+		return;
+	}
+	if (decoder->HasListeners && !decoder->HasListeners())
+	{
+		RecordPacketStatistics(receivedPDUType, EPacketOutcome::DroppedNoListeners);
+		return;
+	}
 
+	if (decoder->Validate && !decoder->Validate(InData))
+	{
+		UE_LOG(LogPDUProcessor, Error, TEXT("Received %s PDU packet with an invalid length! Ignoring the PDU."), *decoder->Name);
+		RecordPacketStatistics(receivedPDUType, EPacketOutcome::Invalid);
 		return;
 	}
-	case EPDUType::Detonation:
+
+	if (packetFilter.IsValid() && !(*packetFilter)(InData))
 	{
-		if (!CheckPDUProperLengthWithArticulationParams(bytesArrayLength, DETONATION_PDU_BYTES))
-		{
-			UE_LOG(LogPDUProcessor, Error, TEXT("Received Detonation PDU packet with an invalid length! Ignoring the PDU."));
-			return;
-		}
+		RecordPacketStatistics(receivedPDUType, EPacketOutcome::DroppedFiltered);
+		return;
+	}
 
-		DIS::DetonationPdu receivedDetonationPDU;
-		receivedDetonationPDU.unmarshal(ds);
+	const uint64 decodeStartCycles = FPlatformTime::Cycles64();
 
-		FDetonationPDU detonationPDU;
-		detonationPDU.SetupFromOpenDIS(receivedDetonationPDU);
+	//Packets may arrive on multiple receive threads, so each thread reuses its own stream rather than allocating a new buffer per packet
+	static thread_local DIS::DataStream ds(DIS::BIG);
+	ds.SetStream(reinterpret_cast<const char*>(InData.GetData()), bytesArrayLength, BigEndian);
+	decoder->Decode(InData, ds);
 
-		OnDetonationPDUProcessed.Broadcast(detonationPDU);
+	RecordPacketStatistics(receivedPDUType, EPacketOutcome::Decoded, FPlatformTime::ToSeconds64(FPlatformTime::Cycles64() - decodeStartCycles));
+}
 
+void UPDUProcessor::RecordPacketStatistics(uint8 PDUType, EPacketOutcome Outcome, double DecodeSeconds)
+{
+	FScopeLock lock(&PDUTypeStatisticsCriticalSection);
+	if (!PDUTypeStatistics.IsValidIndex(PDUType))
+	{
 		return;
 	}
-	case EPDUType::RemoveEntity:
-	{
-		if (bytesArrayLength != REMOVE_ENTITY_PDU_BYTES)
-		{
-			UE_LOG(LogPDUProcessor, Error, TEXT("Received Remove Entity PDU packet with an invalid length! Ignoring the PDU."));
-			return;
-		}
 
-		DIS::RemoveEntityPdu receivedRemoveEntityPDU;
-		receivedRemoveEntityPDU.unmarshal(ds);
+	FPDUTypeStatistics& statistics = PDUTypeStatistics[PDUType];
+	statistics.ReceivedCount++;
 
-		FRemoveEntityPDU removeEntityPDU;
-		removeEntityPDU.SetupFromOpenDIS(receivedRemoveEntityPDU);
+	switch (Outcome)
+	{
+	case EPacketOutcome::Decoded:
+		statistics.DecodedCount++;
+		statistics.TotalDecodeSeconds += DecodeSeconds;
+		statistics.AverageDecodeMicroseconds = static_cast<float>(statistics.TotalDecodeSeconds / statistics.DecodedCount * 1000000.0);
+		break;
+	case EPacketOutcome::DroppedUnsupported:
+		statistics.DroppedUnsupportedCount++;
+		break;
+	case EPacketOutcome::DroppedDisabled:
+		statistics.DroppedDisabledCount++;
+		break;
+	case EPacketOutcome::DroppedNoListeners:
+		statistics.DroppedNoListenersCount++;
+		break;
+	case EPacketOutcome::Invalid:
+		statistics.InvalidCount++;
+		break;
+	case EPacketOutcome::DroppedFiltered:
+		statistics.DroppedFilteredCount++;
+		break;
+	}
+}
 
-		OnRemoveEntityPDUProcessed.Broadcast(removeEntityPDU);
+TSharedPtr<const FPDUDecoder, ESPMode::ThreadSafe> UPDUProcessor::GetPDUDecoder(EPDUType PDUType) const
+{
+	FScopeLock lock(&PDUTypeStatisticsCriticalSection);
+	return PDUDecoders.IsValidIndex(static_cast<uint8>(PDUType)) ? PDUDecoders[static_cast<uint8>(PDUType)] : nullptr;
+}
 
+void UPDUProcessor::RegisterPDUDecoder(EPDUType PDUType, FPDUDecoder Decoder)
+{
+	FScopeLock lock(&PDUTypeStatisticsCriticalSection);
+	if (PDUDecoders.Num() != NUMBER_OF_PDU_TYPES)
+	{
+		UE_LOG(LogPDUProcessor, Warning, TEXT("Attempted to register a decoder for %s PDUs before the PDU Processor was initialized! Ignoring the decoder."), *Decoder.Name);
 		return;
 	}
-	case EPDUType::Start_Resume:
+
+	const TSharedPtr<const FPDUDecoder, ESPMode::ThreadSafe>& previousDecoder = PDUDecoders[static_cast<uint8>(PDUType)];
+	if (previousDecoder.IsValid() && previousDecoder->Decode)
 	{
-		if (bytesArrayLength != START_RESUME_PDU_BYTES)
-		{
-			UE_LOG(LogPDUProcessor, Error, TEXT("Received Start Resume PDU packet with an invalid length! Ignoring the PDU."));
-			return;
-		}
+		UE_LOG(LogPDUProcessor, Log, TEXT("Replacing the decoder for %s PDUs with the decoder for %s PDUs."), *previousDecoder->Name, *Decoder.Name);
+	}
 
-		DIS::StartResumePdu receivedStartResumePDU;
-		receivedStartResumePDU.unmarshal(ds);
+	PDUDecoders[static_cast<uint8>(PDUType)] = MakeShared<const FPDUDecoder, ESPMode::ThreadSafe>(MoveTemp(Decoder));
+}
 
-		FStartResumePDU StartResumePDU;
-		StartResumePDU.SetupFromOpenDIS(receivedStartResumePDU);
+bool UPDUProcessor::UnregisterPDUDecoder(EPDUType PDUType)
+{
+	FScopeLock lock(&PDUTypeStatisticsCriticalSection);
+	if (!PDUDecoders.IsValidIndex(static_cast<uint8>(PDUType)) || !PDUDecoders[static_cast<uint8>(PDUType)].IsValid())
+	{
+		return false;
+	}
 
-		OnStartResumePDUProcessed.Broadcast(StartResumePDU);
+	PDUDecoders[static_cast<uint8>(PDUType)].Reset();
+	return true;
+}
 
+void UPDUProcessor::SetPDUPacketFilter(EPDUType PDUType, FPDUPacketFilter Filter)
+{
+	FScopeLock lock(&PDUTypeStatisticsCriticalSection);
+	if (PDUPacketFilters.Num() != NUMBER_OF_PDU_TYPES)
+	{
 		return;
 	}
-	case EPDUType::Stop_Freeze:
-	{
-		if (bytesArrayLength != STOP_FREEZE_PDU_BYTES)
-		{
-			UE_LOG(LogPDUProcessor, Error, TEXT("Received Stop Freeze PDU packet with an invalid length! Ignoring the PDU."));
-			return;
-		}
-
-		DIS::StopFreezePdu receivedStopFreezePDU;
-		receivedStopFreezePDU.unmarshal(ds);
-
-		FStopFreezePDU StopFreezePDU;
-		StopFreezePDU.SetupFromOpenDIS(receivedStopFreezePDU);
 
-		OnStopFreezePDUProcessed.Broadcast(StopFreezePDU);
+	if (Filter)
+	{
+		PDUPacketFilters[static_cast<uint8>(PDUType)] = MakeShared<FPDUPacketFilter, ESPMode::ThreadSafe>(MoveTemp(Filter));
+	}
+	else
+	{
+		PDUPacketFilters[static_cast<uint8>(PDUType)].Reset();
+	}
+}
 
+void UPDUProcessor::SetPDUTypeEnabled(EPDUType PDUType, bool bEnabled)
+{
+	FScopeLock lock(&PDUTypeStatisticsCriticalSection);
+	if (!PDUDecoders.IsValidIndex(static_cast<uint8>(PDUType)) || !PDUDecoders[static_cast<uint8>(PDUType)].IsValid())
+	{
 		return;
 	}
-	case EPDUType::EntityStateUpdate:
+
+	//Registered decoders may be in use on another thread, so replace the decoder with an updated copy rather than modifying it
+	TSharedPtr<const FPDUDecoder, ESPMode::ThreadSafe>& decoder = PDUDecoders[static_cast<uint8>(PDUType)];
+	if (decoder->bEnabled != bEnabled)
 	{
-		if (!CheckPDUProperLengthWithArticulationParams(bytesArrayLength, ENTITY_STATE_UPDATE_PDU_BYTES))
-		{
-			UE_LOG(LogPDUProcessor, Error, TEXT("Received Entity State Update PDU packet with an invalid length! Ignoring the PDU."));
-			return;
-		}
+		FPDUDecoder updatedDecoder = *decoder;
+		updatedDecoder.bEnabled = bEnabled;
+		decoder = MakeShared<const FPDUDecoder, ESPMode::ThreadSafe>(MoveTemp(updatedDecoder));
+	}
+}
 
-		DIS::EntityStateUpdatePdu receivedESUPDU;
-		receivedESUPDU.unmarshal(ds);
+bool UPDUProcessor::IsPDUTypeEnabled(EPDUType PDUType) const
+{
+	const TSharedPtr<const FPDUDecoder, ESPMode::ThreadSafe> decoder = GetPDUDecoder(PDUType);
+	return decoder.IsValid() && decoder->Decode && decoder->bEnabled;
+}
 
-		FEntityStateUpdatePDU entityStateUpdatePDU;
-		entityStateUpdatePDU.SetupFromOpenDIS(receivedESUPDU);
+bool UPDUProcessor::HasPDUDecoder(EPDUType PDUType) const
+{
+	const TSharedPtr<const FPDUDecoder, ESPMode::ThreadSafe> decoder = GetPDUDecoder(PDUType);
+	return decoder.IsValid() && static_cast<bool>(decoder->Decode);
+}
 
-		OnEntityStateUpdatePDUProcessed.Broadcast(entityStateUpdatePDU);
+FPDUTypeStatistics UPDUProcessor::GetPDUTypeStatistics(EPDUType PDUType) const
+{
+	FScopeLock lock(&PDUTypeStatisticsCriticalSection);
+	return PDUTypeStatistics.IsValidIndex(static_cast<uint8>(PDUType)) ? PDUTypeStatistics[static_cast<uint8>(PDUType)] : FPDUTypeStatistics();
+}
 
-		return;
+void UPDUProcessor::ResetPDUTypeStatistics()
+{
+	FScopeLock lock(&PDUTypeStatisticsCriticalSection);
+	for (FPDUTypeStatistics& statistics : PDUTypeStatistics)
+	{
+		statistics = FPDUTypeStatistics();
 	}
-	case EPDUType::ElectromagneticEmission:
+}
+
+void UPDUProcessor::LogPDUTypeStatistics() const
+{
+	FScopeLock lock(&PDUTypeStatisticsCriticalSection);
+	for (int i = 0; i < PDUTypeStatistics.Num(); i++)
 	{
-		if (!CheckElectromagneticEmissionPDUProperLength(InData))
+		const FPDUTypeStatistics& statistics = PDUTypeStatistics[i];
+		if (statistics.ReceivedCount == 0)
 		{
-			UE_LOG(LogPDUProcessor, Error, TEXT("Received Electromagnetic Emission PDU packet with an invalid length! Ignoring the PDU."));
-			return;
+			continue;
 		}
 
-		DIS::ElectromagneticEmissionsPdu receivedPDU;
-		receivedPDU.unmarshal(ds);
-
-		FElectromagneticEmissionsPDU pdu;
-		pdu.SetupFromOpenDIS(receivedPDU);
-
-		OnElectromagneticEmissionsPDUProcessed.Broadcast(pdu);
-
-		return;
-	}
+		const FString name = PDUDecoders.IsValidIndex(i) && PDUDecoders[i].IsValid() && PDUDecoders[i]->Decode ? PDUDecoders[i]->Name : FString::Printf(TEXT("Unsupported (%d)"), i);
+		UE_LOG(LogPDUProcessor, Log, TEXT("%s PDU: Received %lld, Decoded %lld, No Listeners %lld, Disabled %lld, Unsupported %lld, Invalid %lld, Filtered %lld, Average Decode %.2f us"),
+			*name, statistics.ReceivedCount, statistics.DecodedCount, statistics.DroppedNoListenersCount, statistics.DroppedDisabledCount,
+			statistics.DroppedUnsupportedCount, statistics.InvalidCount, statistics.DroppedFilteredCount, statistics.AverageDecodeMicroseconds);
 	}
 }
 
 bool UPDUProcessor::CheckPDUProperLengthWithArticulationParams(int BytesArrayLength, int PDULengthWithoutArticulationParams)
 {
-	//Verify that any extra byte length on a PDU is due to articulation parameters
+	//Verify that the PDU is at least its minimum length and that any extra byte length on a PDU is due to articulation parameters
 	int extraBytes = BytesArrayLength - PDULengthWithoutArticulationParams;
-	int articulationParamAmount = extraBytes / ARTICULATION_PARAMETER_BYTES;
-	return (articulationParamAmount * ARTICULATION_PARAMETER_BYTES) == extraBytes;
+	return extraBytes >= 0 && (extraBytes % ARTICULATION_PARAMETER_BYTES) == 0;
 }
 
 bool UPDUProcessor::CheckElectromagneticEmissionPDUProperLength(const TArray<uint8>& InData)
 {
 	int bytesArrayLength = InData.Num();
+	const int lastIndexIfNoEmitterData = 27;
+
+	//Make sure the fixed portion of the PDU is present before reading the number of systems
+	if (bytesArrayLength <= lastIndexIfNoEmitterData)
+	{
+		return false;
+	}
+
 	//Get the number of systems in the PDU
 	const int numberOfSystems = static_cast<int>(InData[25]);
-	const int lastIndexIfNoEmitterData = 27;
 	int currentIndex = lastIndexIfNoEmitterData;
 
 	for (int i = 0; i < numberOfSystems; i++)
 	{
 		//Increment to get the number of beams in the current system
 		currentIndex += 2;
+		if (currentIndex >= bytesArrayLength)
+		{
+			return false;
+		}
 		int numberOfBeams = static_cast<int>(InData[currentIndex]);
 
 		//Increment to get to the end of the emitter system data
@@ -217,6 +328,10 @@ bool UPDUProcessor::CheckElectromagneticEmissionPDUProperLength(const TArray<uin
 		{
 			//Increment to get the number of targets
 			currentIndex += 46;
+			if (currentIndex >= bytesArrayLength)
+			{
+				return false;
+			}
 			int numberOfTargets = static_cast<int>(InData[currentIndex]);
 
 			//Increment to get to the end of the beam data
@@ -228,4 +343,4 @@ bool UPDUProcessor::CheckElectromagneticEmissionPDUProperLength(const TArray<uin
 
 	//Doing currentIndex + 1 to convert from an array index
 	return (currentIndex + 1) == bytesArrayLength;
-}
\ No newline at end of file
+}
@@ -0,0 +1,44 @@
+// Copyright 2022 Gaming Research Integration for Learning Lab. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "DISAreaOfInterest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDISAreaOfInterestViewpointTest, "GRILL DIS.Area of Interest.Viewpoint Spheres",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FDISAreaOfInterestViewpointTest::RunTest(const FString& Parameters)
+{
+	//Points on the equator at the prime meridian, one close to the viewpoint and one far from it
+	const FVector viewpoint(6378137, 0, 0);
+	const double nearLocation[3] = { 6378137, 500, 0 };
+	const double farLocation[3] = { 6378137, 50000, 0 };
+
+	FDISAreaOfInterest areaOfInterest;
+	areaOfInterest.SetVolumes(TArray<FDISAreaOfInterestPolygon>(), TArray<FDISAreaOfInterestAltitudeBand>(), 1000);
+
+	//Nothing can be ruled out before the viewpoints are known
+	TestTrue(TEXT("Every location is relevant before the viewpoints are set"), areaOfInterest.IsRelevant(nearLocation) && areaOfInterest.IsRelevant(farLocation));
+
+	areaOfInterest.SetViewpoints(MakeArrayView(&viewpoint, 1));
+	TestTrue(TEXT("A location inside a viewpoint sphere is relevant"), areaOfInterest.IsRelevant(nearLocation));
+	TestFalse(TEXT("A location outside every viewpoint sphere is not relevant"), areaOfInterest.IsRelevant(farLocation));
+
+	//With an altitude band the band still applies while the viewpoints are unknown
+	TArray<FDISAreaOfInterestAltitudeBand> altitudeBands;
+	FDISAreaOfInterestAltitudeBand& altitudeBand = altitudeBands.AddDefaulted_GetRef();
+	altitudeBand.MinAltitude = 10000;
+	altitudeBand.MaxAltitude = 20000;
+	areaOfInterest.SetVolumes(TArray<FDISAreaOfInterestPolygon>(), altitudeBands, 1000);
+	areaOfInterest.SetViewpoints(TArrayView<const FVector>());
+	TestFalse(TEXT("Other volumes still filter while the viewpoints are unknown"), areaOfInterest.IsRelevant(farLocation));
+
+	//Without any volumes nothing is relevant
+	areaOfInterest.SetVolumes(TArray<FDISAreaOfInterestPolygon>(), TArray<FDISAreaOfInterestAltitudeBand>(), 0);
+	TestFalse(TEXT("An empty area of interest has no relevant locations"), areaOfInterest.IsRelevant(nearLocation));
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
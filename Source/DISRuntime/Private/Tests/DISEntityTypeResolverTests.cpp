@@ -0,0 +1,117 @@
+// Copyright 2022 Gaming Research Integration for Learning Lab. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "DISEntityTypeResolver.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/** Makes an Entity Type from the given fields. Fields set to -1 are wildcards. */
+	FEntityType MakeEntityType(int32 EntityKind, int32 Domain, int32 Country, int32 Category, int32 Subcategory, int32 Specific, int32 Extra)
+	{
+		FEntityType entityType;
+		entityType.EntityKind = EntityKind;
+		entityType.Domain = Domain;
+		entityType.Country = Country;
+		entityType.Category = Category;
+		entityType.Subcategory = Subcategory;
+		entityType.Specific = Specific;
+		entityType.Extra = Extra;
+		return entityType;
+	}
+
+	/** Makes a soft class reference to a placeholder asset path. The class does not need to exist to be mapped and resolved. */
+	TSoftClassPtr<AActor> MakeActorClass(const TCHAR* Name)
+	{
+		return TSoftClassPtr<AActor>(FSoftObjectPath(FString::Printf(TEXT("/Game/Tests/%s.%s_C"), Name, Name)));
+	}
+
+	/** Returns whether the given resolution points at the expected actor class. */
+	bool IsResolvedTo(const TSoftClassPtr<AActor>* Resolved, const TSoftClassPtr<AActor>& Expected)
+	{
+		return Resolved && *Resolved == Expected;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDISEntityTypeResolverPrecedenceTest, "GRILL DIS.Entity Type Resolver.Precedence",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FDISEntityTypeResolverPrecedenceTest::RunTest(const FString& Parameters)
+{
+	const TSoftClassPtr<AActor> exactClass = MakeActorClass(TEXT("Exact"));
+	const TSoftClassPtr<AActor> anyExtraClass = MakeActorClass(TEXT("AnyExtra"));
+	const TSoftClassPtr<AActor> anyCountryClass = MakeActorClass(TEXT("AnyCountry"));
+	const TSoftClassPtr<AActor> anyKindClass = MakeActorClass(TEXT("AnyKind"));
+	const TSoftClassPtr<AActor> anyKindAndCountryClass = MakeActorClass(TEXT("AnyKindAndCountry"));
+
+	FDISEntityTypeResolver resolver;
+
+	//Mappings are added from least to most specific so precedence cannot come from insertion order
+	resolver.AddMapping(MakeEntityType(-1, 2, 225, 1, 1, 3, 0), anyKindClass);
+	resolver.AddMapping(MakeEntityType(1, 2, -1, 1, 1, 3, 0), anyCountryClass);
+	resolver.AddMapping(MakeEntityType(1, 2, 225, 1, 1, 3, -1), anyExtraClass);
+	resolver.AddMapping(MakeEntityType(1, 2, 225, 1, 1, 3, 0), exactClass);
+
+	//An exact mapping beats every wildcard mapping that also matches
+	TestTrue(TEXT("An exact mapping beats wildcard mappings"), IsResolvedTo(resolver.Resolve(MakeEntityType(1, 2, 225, 1, 1, 3, 0)), exactClass));
+
+	//Fields are compared from kind to extra, so a wildcard late in the type beats a wildcard earlier in the type
+	TestTrue(TEXT("A wildcard extra beats a wildcard country"), IsResolvedTo(resolver.Resolve(MakeEntityType(1, 2, 225, 1, 1, 3, 7)), anyExtraClass));
+	TestTrue(TEXT("A wildcard country beats a wildcard kind"), IsResolvedTo(resolver.Resolve(MakeEntityType(1, 2, 222, 1, 1, 3, 0)), anyCountryClass));
+	TestTrue(TEXT("A wildcard kind matches when nothing more specific does"), IsResolvedTo(resolver.Resolve(MakeEntityType(3, 2, 225, 1, 1, 3, 0)), anyKindClass));
+
+	//An exact field whose subtree has no match falls back to the wildcard at that field
+	resolver.AddMapping(MakeEntityType(-1, 2, -1, 1, 1, 3, 5), anyKindAndCountryClass);
+	TestTrue(TEXT("A dead end under an exact field falls back to the wildcard"), IsResolvedTo(resolver.Resolve(MakeEntityType(1, 2, 222, 1, 1, 3, 5)), anyKindAndCountryClass));
+
+	TestNull(TEXT("An Entity Type no mapping matches resolves to null"), resolver.Resolve(MakeEntityType(1, 1, 225, 1, 1, 3, 0)));
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDISEntityTypeResolverCacheTest, "GRILL DIS.Entity Type Resolver.Cache",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FDISEntityTypeResolverCacheTest::RunTest(const FString& Parameters)
+{
+	//Replacing a mapping logs a warning
+	AddExpectedError(TEXT("A DIS Enumeration mapping already exists"), EAutomationExpectedErrorFlags::Contains, 1);
+
+	const TSoftClassPtr<AActor> wildcardClass = MakeActorClass(TEXT("Wildcard"));
+	const TSoftClassPtr<AActor> exactClass = MakeActorClass(TEXT("Exact"));
+	const TSoftClassPtr<AActor> replacementClass = MakeActorClass(TEXT("Replacement"));
+	const FEntityType entityType = MakeEntityType(1, 2, 225, 1, 1, 3, 0);
+
+	FDISEntityTypeResolver resolver;
+	resolver.AddMapping(MakeEntityType(1, 2, 225, 1, 1, 3, -1), wildcardClass);
+
+	bool bWasCached;
+	TestTrue(TEXT("The first resolution walks the trie"), IsResolvedTo(resolver.Resolve(entityType, bWasCached), wildcardClass) && !bWasCached);
+	TestTrue(TEXT("A repeated resolution is served from the cache"), IsResolvedTo(resolver.Resolve(entityType, bWasCached), wildcardClass) && bWasCached);
+
+	//Failed resolutions are cached too
+	const FEntityType unmappedEntityType = MakeEntityType(3, 1, 225, 1, 0, 0, 0);
+	resolver.Resolve(unmappedEntityType, bWasCached);
+	TestNull(TEXT("A repeated failed resolution is served from the cache"), resolver.Resolve(unmappedEntityType, bWasCached));
+	TestTrue(TEXT("A repeated failed resolution is served from the cache"), bWasCached);
+
+	//Adding a more specific mapping invalidates the cached wildcard resolution
+	resolver.AddMapping(entityType, exactClass);
+	TestTrue(TEXT("Adding a mapping invalidates the cache"), IsResolvedTo(resolver.Resolve(entityType, bWasCached), exactClass) && !bWasCached);
+
+	//Replacing a mapping invalidates the cached resolution of it
+	TestTrue(TEXT("Replacing a mapping reports the replacement"), resolver.AddMapping(entityType, replacementClass));
+	TestTrue(TEXT("Replacing a mapping invalidates the cache"), IsResolvedTo(resolver.Resolve(entityType, bWasCached), replacementClass) && !bWasCached);
+	TestEqual(TEXT("Replacing a mapping does not add another"), resolver.GetNumMappings(), 2);
+
+	//Resetting drops every mapping along with the cache
+	resolver.Reset();
+	TestNull(TEXT("Resetting removes all mappings"), resolver.Resolve(entityType, bWasCached));
+	TestFalse(TEXT("Resetting clears the cache"), bWasCached);
+	TestEqual(TEXT("Resetting clears the cache statistics"), resolver.GetCacheHits(), int64(0));
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,161 @@
+// Copyright 2022 Gaming Research Integration for Learning Lab. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "DISSpatialIndex.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/** Returns whether the given handles hold exactly the expected handles, in any order. */
+	bool HasExactly(const TArray<FDISEntityHandle>& Handles, std::initializer_list<FDISEntityHandle> ExpectedHandles)
+	{
+		if (Handles.Num() != static_cast<int32>(ExpectedHandles.size()))
+		{
+			return false;
+		}
+
+		for (const FDISEntityHandle& expectedHandle : ExpectedHandles)
+		{
+			if (!Handles.Contains(expectedHandle))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDISSpatialIndexCellKeyTest, "GRILL DIS.Spatial Index.Cell Keys",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FDISSpatialIndexCellKeyTest::RunTest(const FString& Parameters)
+{
+	//With one meter cells, cell coordinates 2^21 apart share a packed cell key, and locations beyond 2^28 meters are clamped to the same cell
+	FDISSpatialIndex spatialIndex(1);
+
+	const FDISEntityHandle originHandle(0, 1);
+	const FDISEntityHandle aliasedHandle(1, 1);
+	const FDISEntityHandle clampedHandle(2, 1);
+	const FDISEntityHandle negativeClampedHandle(3, 1);
+	spatialIndex.Update(originHandle, glm::dvec3(0.5, 0.5, 0.5));
+	spatialIndex.Update(aliasedHandle, glm::dvec3((1 << 21) + 0.5, 0.5, 0.5));
+	spatialIndex.Update(clampedHandle, glm::dvec3(1e12, 0.5, 0.5));
+	spatialIndex.Update(negativeClampedHandle, glm::dvec3(-1e12, 0.5, 0.5));
+	TestEqual(TEXT("Every entity is indexed"), spatialIndex.Num(), 4);
+
+	glm::dvec3 location;
+	TestTrue(TEXT("Clamping the cell does not change the indexed location"), spatialIndex.GetLocation(clampedHandle, location) && location.x == 1e12);
+
+	//Entities that share a packed cell key are told apart by their exact locations
+	TArray<FDISEntityHandle> handles;
+	spatialIndex.QueryRadius(glm::dvec3(0.5, 0.5, 0.5), 2, handles);
+	TestTrue(TEXT("A radius query does not return entities of aliased cells"), HasExactly(handles, { originHandle }));
+
+	handles.Reset();
+	spatialIndex.QueryBox(glm::dvec3((1 << 21) - 1, 0, 0), glm::dvec3((1 << 21) + 1, 1, 1), handles);
+	TestTrue(TEXT("A box query does not return entities of aliased cells"), HasExactly(handles, { aliasedHandle }));
+
+	handles.Reset();
+	spatialIndex.QueryRadius(glm::dvec3(1e12, 0.5, 0.5), 1, handles);
+	TestTrue(TEXT("A radius query far outside the Earth finds the clamped entity"), HasExactly(handles, { clampedHandle }));
+
+	handles.Reset();
+	spatialIndex.QueryNearest(glm::dvec3(0.5, 0.5, 0.5), 2, 0, handles);
+	TestTrue(TEXT("The nearest query skips aliased cells until their own shell"), handles.Num() == 2 && handles[0] == originHandle && handles[1] == aliasedHandle);
+
+	handles.Reset();
+	spatialIndex.QueryNearest(glm::dvec3(-1e12, 0.5, 0.5), 1, 0, handles);
+	TestTrue(TEXT("The nearest query from a clamped cell finds the clamped entity"), handles.Num() == 1 && handles[0] == negativeClampedHandle);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDISSpatialIndexRegionQueryTest, "GRILL DIS.Spatial Index.Region Queries",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FDISSpatialIndexRegionQueryTest::RunTest(const FString& Parameters)
+{
+	FDISSpatialIndex spatialIndex(100);
+
+	//Entities on both sides of the cell boundaries at 0 and 100 meters
+	const FDISEntityHandle belowZeroHandle(0, 1);
+	const FDISEntityHandle belowBoundaryHandle(1, 1);
+	const FDISEntityHandle aboveBoundaryHandle(2, 1);
+	const FDISEntityHandle farHandle(3, 1);
+	spatialIndex.Update(belowZeroHandle, glm::dvec3(-5, 0, 0));
+	spatialIndex.Update(belowBoundaryHandle, glm::dvec3(95, 0, 0));
+	spatialIndex.Update(aboveBoundaryHandle, glm::dvec3(105, 0, 0));
+	spatialIndex.Update(farHandle, glm::dvec3(250, 0, 0));
+
+	TArray<FDISEntityHandle> handles;
+	spatialIndex.QueryRadius(glm::dvec3(100, 0, 0), 10, handles);
+	TestTrue(TEXT("A radius query finds entities in every cell it overlaps"), HasExactly(handles, { belowBoundaryHandle, aboveBoundaryHandle }));
+
+	handles.Reset();
+	spatialIndex.QueryRadius(glm::dvec3(0, 0, 0), 5, handles);
+	TestTrue(TEXT("A radius query includes entities exactly at its radius"), HasExactly(handles, { belowZeroHandle }));
+
+	handles.Reset();
+	spatialIndex.QueryBox(glm::dvec3(-10, -1, -1), glm::dvec3(100, 1, 1), handles);
+	TestTrue(TEXT("A box query finds entities in every cell it overlaps and tests their exact locations"), HasExactly(handles, { belowZeroHandle, belowBoundaryHandle }));
+
+	//Moving an entity across cells takes it out of its old cell
+	spatialIndex.Update(belowBoundaryHandle, glm::dvec3(245, 0, 0));
+	handles.Reset();
+	spatialIndex.QueryRadius(glm::dvec3(100, 0, 0), 10, handles);
+	TestTrue(TEXT("A moved entity is not found at its old location"), HasExactly(handles, { aboveBoundaryHandle }));
+	handles.Reset();
+	spatialIndex.QueryBox(glm::dvec3(200, -1, -1), glm::dvec3(300, 1, 1), handles);
+	TestTrue(TEXT("A moved entity is found at its new location"), HasExactly(handles, { belowBoundaryHandle, farHandle }));
+
+	//Removing with a stale handle must not remove the entity that reused its slot
+	spatialIndex.Remove(FDISEntityHandle(3, 0));
+	spatialIndex.Remove(aboveBoundaryHandle);
+	handles.Reset();
+	spatialIndex.QueryRadius(glm::dvec3(150, 0, 0), 200, handles);
+	TestTrue(TEXT("Removed entities are not found"), HasExactly(handles, { belowZeroHandle, belowBoundaryHandle, farHandle }));
+	TestEqual(TEXT("Removed entities are no longer counted"), spatialIndex.Num(), 3);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDISSpatialIndexNearestFilterTest, "GRILL DIS.Spatial Index.Nearest Filter",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FDISSpatialIndexNearestFilterTest::RunTest(const FString& Parameters)
+{
+	FDISSpatialIndex spatialIndex(15);
+
+	//Entities every 10 meters along the x axis, spread across several cells
+	TArray<FDISEntityHandle> entityHandles;
+	for (int32 entityIndex = 0; entityIndex < 6; entityIndex++)
+	{
+		entityHandles.Add(FDISEntityHandle(entityIndex, 1));
+		spatialIndex.Update(entityHandles.Last(), glm::dvec3(10 * (entityIndex + 1), 0, 0));
+	}
+
+	//Only even entities pass the filter
+	auto isEven = [](FDISEntityHandle Handle) { return Handle.Index % 2 == 0; };
+
+	TArray<FDISEntityHandle> handles;
+	spatialIndex.QueryNearest(glm::dvec3(0, 0, 0), 2, 0, isEven, handles);
+	TestTrue(TEXT("Rejected entities do not count towards the number of entities to get"), handles.Num() == 2 && handles[0] == entityHandles[0] && handles[1] == entityHandles[2]);
+
+	handles.Reset();
+	spatialIndex.QueryNearest(glm::dvec3(0, 0, 0), 10, 45, isEven, handles);
+	TestTrue(TEXT("The filtered nearest query respects the maximum distance"), handles.Num() == 2 && handles[0] == entityHandles[0] && handles[1] == entityHandles[2]);
+
+	handles.Reset();
+	spatialIndex.QueryNearest(glm::dvec3(0, 0, 0), 2, 0, [](FDISEntityHandle) { return false; }, handles);
+	TestEqual(TEXT("A filter that rejects every entity finds nothing"), handles.Num(), 0);
+
+	//The unfiltered overload returns the closest entities regardless of the filter above
+	handles.Reset();
+	spatialIndex.QueryNearest(glm::dvec3(35, 0, 0), 2, 0, handles);
+	TestTrue(TEXT("The unfiltered nearest query returns the closest entities first"), handles.Num() == 2 && HasExactly(handles, { entityHandles[2], entityHandles[3] }));
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,121 @@
+// Copyright 2022 Gaming Research Integration for Learning Lab. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "DISTimingWheel.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	/** Advances the wheel to the given time and returns the handles that timed out. */
+	TArray<FDISEntityHandle> AdvanceTo(FDISTimingWheel& TimingWheel, double CurrentTime)
+	{
+		TArray<FDISEntityHandle> expiredHandles;
+		TimingWheel.Advance(CurrentTime, expiredHandles);
+		return expiredHandles;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDISTimingWheelExpiryTest, "GRILL DIS.Timing Wheel.Expiry",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FDISTimingWheelExpiryTest::RunTest(const FString& Parameters)
+{
+	//With 0.1 second ticks the first level spans 6.4 seconds and the second 409.6 seconds
+	FDISTimingWheel timingWheel(0.1);
+
+	const FDISEntityHandle shortHandle(0, 1);
+	const FDISEntityHandle secondLevelHandle(1, 1);
+	const FDISEntityHandle thirdLevelHandle(2, 1);
+	timingWheel.Schedule(shortHandle, 0, 2);
+	timingWheel.Schedule(secondLevelHandle, 0, 10);
+	timingWheel.Schedule(thirdLevelHandle, 0, 500);
+	TestEqual(TEXT("Scheduled timeouts are counted"), timingWheel.Num(), 3);
+
+	TestEqual(TEXT("Nothing expires before its deadline"), AdvanceTo(timingWheel, 1.95).Num(), 0);
+
+	TArray<FDISEntityHandle> expiredHandles = AdvanceTo(timingWheel, 2.15);
+	TestTrue(TEXT("A first level timeout expires at its deadline"), expiredHandles.Num() == 1 && expiredHandles[0] == shortHandle);
+
+	//The second level slot is cascaded into the first level when the first level wraps around
+	TestEqual(TEXT("A second level timeout does not expire when its slot is cascaded"), AdvanceTo(timingWheel, 9.85).Num(), 0);
+	expiredHandles = AdvanceTo(timingWheel, 10.15);
+	TestTrue(TEXT("A second level timeout expires at its deadline"), expiredHandles.Num() == 1 && expiredHandles[0] == secondLevelHandle);
+
+	//Advancing in a single large step still cascades through every level boundary crossed
+	TestEqual(TEXT("A third level timeout does not expire early"), AdvanceTo(timingWheel, 499.85).Num(), 0);
+	expiredHandles = AdvanceTo(timingWheel, 500.15);
+	TestTrue(TEXT("A third level timeout expires at its deadline"), expiredHandles.Num() == 1 && expiredHandles[0] == thirdLevelHandle);
+	TestEqual(TEXT("Expired timeouts are no longer counted"), timingWheel.Num(), 0);
+
+	TestEqual(TEXT("Expired timeouts do not expire again"), AdvanceTo(timingWheel, 1000).Num(), 0);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDISTimingWheelRescheduleTest, "GRILL DIS.Timing Wheel.Reschedule",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FDISTimingWheelRescheduleTest::RunTest(const FString& Parameters)
+{
+	FDISTimingWheel timingWheel(0.1);
+
+	//Rescheduling leaves the earlier entry behind in the wheel, where it must be ignored
+	const FDISEntityHandle rescheduledHandle(0, 1);
+	timingWheel.Schedule(rescheduledHandle, 0, 1);
+	timingWheel.Schedule(rescheduledHandle, 0.5, 5);
+	TestEqual(TEXT("Rescheduling does not count the timeout twice"), timingWheel.Num(), 1);
+	TestEqual(TEXT("The earlier deadline of a rescheduled timeout is ignored"), AdvanceTo(timingWheel, 1.5).Num(), 0);
+
+	//Refreshing a timeout only stores its deadline, so the entry is moved when its original slot comes around, cascading through the second level here
+	const FDISEntityHandle refreshedHandle(1, 1);
+	timingWheel.Schedule(refreshedHandle, 1.5, 10);
+	TestTrue(TEXT("Refreshing a scheduled timeout succeeds"), timingWheel.Refresh(refreshedHandle, 6.5));
+	TestFalse(TEXT("Refreshing with a stale handle fails"), timingWheel.Refresh(FDISEntityHandle(1, 0), 6.5));
+
+	TArray<FDISEntityHandle> expiredHandles = AdvanceTo(timingWheel, 5.65);
+	TestTrue(TEXT("A rescheduled timeout expires at its new deadline"), expiredHandles.Num() == 1 && expiredHandles[0] == rescheduledHandle);
+
+	TestEqual(TEXT("A refreshed timeout does not expire at its original deadline"), AdvanceTo(timingWheel, 16.35).Num(), 0);
+	expiredHandles = AdvanceTo(timingWheel, 16.65);
+	TestTrue(TEXT("A refreshed timeout expires at its refreshed deadline"), expiredHandles.Num() == 1 && expiredHandles[0] == refreshedHandle);
+
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FDISTimingWheelCancelTest, "GRILL DIS.Timing Wheel.Cancel",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FDISTimingWheelCancelTest::RunTest(const FString& Parameters)
+{
+	FDISTimingWheel timingWheel(0.1);
+
+	const FDISEntityHandle cancelledHandle(0, 1);
+	timingWheel.Schedule(cancelledHandle, 0, 1);
+	timingWheel.Cancel(cancelledHandle);
+	TestEqual(TEXT("Cancelled timeouts are no longer counted"), timingWheel.Num(), 0);
+	TestEqual(TEXT("Cancelled timeouts do not expire"), AdvanceTo(timingWheel, 1.5).Num(), 0);
+
+	//The entry of a cancelled schedule is still in the wheel with a stale schedule ID when the slot is scheduled again
+	timingWheel.Schedule(cancelledHandle, 1.5, 1);
+	timingWheel.Cancel(cancelledHandle);
+	timingWheel.Schedule(cancelledHandle, 1.5, 3);
+	TestEqual(TEXT("The stale entry of a cancelled schedule does not expire the new schedule"), AdvanceTo(timingWheel, 2.65).Num(), 0);
+	TArray<FDISEntityHandle> expiredHandles = AdvanceTo(timingWheel, 4.65);
+	TestTrue(TEXT("A timeout scheduled after a cancel expires at its own deadline"), expiredHandles.Num() == 1 && expiredHandles[0] == cancelledHandle);
+
+	//A handle to a removed entity must not cancel the timeout of the entity that reused its slot
+	const FDISEntityHandle removedHandle(1, 1);
+	const FDISEntityHandle reusedHandle(1, 2);
+	timingWheel.Schedule(removedHandle, 4.65, 1);
+	timingWheel.Cancel(removedHandle);
+	timingWheel.Schedule(reusedHandle, 4.65, 1);
+	timingWheel.Cancel(removedHandle);
+	TestEqual(TEXT("Cancelling with a stale handle does nothing"), timingWheel.Num(), 1);
+	expiredHandles = AdvanceTo(timingWheel, 5.85);
+	TestTrue(TEXT("The timeout of a reused slot expires with the new handle"), expiredHandles.Num() == 1 && expiredHandles[0] == reusedHandle);
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
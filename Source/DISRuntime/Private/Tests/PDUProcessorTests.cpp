@@ -0,0 +1,81 @@
+// Copyright 2022 Gaming Research Integration for Learning Lab. All Rights Reserved.
+
+#include "Misc/AutomationTest.h"
+#include "PDUProcessor.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	const int32 PDU_TYPE_POSITION = 2;
+
+	/** Makes a zeroed packet of the given length with the PDU type set in its header. */
+	TArray<uint8> MakePacket(EPDUType PDUType, int32 Length)
+	{
+		TArray<uint8> packet;
+		packet.SetNumZeroed(Length);
+		if (Length > PDU_TYPE_POSITION)
+		{
+			packet[PDU_TYPE_POSITION] = static_cast<uint8>(PDUType);
+		}
+		return packet;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPDUProcessorMalformedPacketTest, "GRILL DIS.PDU Processor.Malformed Packets",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FPDUProcessorMalformedPacketTest::RunTest(const FString& Parameters)
+{
+	//Every rejected packet logs an invalid length error
+	AddExpectedError(TEXT("invalid length"), EAutomationExpectedErrorFlags::Contains, 0);
+
+	UPDUProcessor* pduProcessor = NewObject<UPDUProcessor>();
+	pduProcessor->InitializePDUDecoders();
+
+	int32 numEntityStatePDUs = 0;
+	int32 numEntityStateUpdatePDUs = 0;
+	int32 numElectromagneticEmissionsPDUs = 0;
+	pduProcessor->OnEntityStatePDUProcessedNative.AddLambda([&numEntityStatePDUs](const FEntityStatePDU&) { numEntityStatePDUs++; });
+	pduProcessor->OnEntityStateUpdatePDUProcessedNative.AddLambda([&numEntityStateUpdatePDUs](const FEntityStateUpdatePDU&) { numEntityStateUpdatePDUs++; });
+	pduProcessor->OnElectromagneticEmissionsPDUProcessedNative.AddLambda([&numElectromagneticEmissionsPDUs](const FElectromagneticEmissionsPDU&) { numElectromagneticEmissionsPDUs++; });
+
+	//Packets shorter than the PDU header are ignored before their type is read
+	pduProcessor->ProcessDISPacket(TArray<uint8>());
+	pduProcessor->ProcessDISPacket(MakePacket(EPDUType::EntityState, 11));
+	TestEqual(TEXT("Packets shorter than the header are not counted"), pduProcessor->GetPDUTypeStatistics(EPDUType::EntityState).ReceivedCount, int64(0));
+
+	//Entity State PDUs must be 144 bytes plus a whole number of 16 byte articulation parameters
+	pduProcessor->ProcessDISPacket(MakePacket(EPDUType::EntityState, 12));
+	pduProcessor->ProcessDISPacket(MakePacket(EPDUType::EntityState, 143));
+	pduProcessor->ProcessDISPacket(MakePacket(EPDUType::EntityState, 144 - 16));
+	pduProcessor->ProcessDISPacket(MakePacket(EPDUType::EntityState, 144 + 8));
+	pduProcessor->ProcessDISPacket(MakePacket(EPDUType::EntityState, 4096 + 1));
+	TestEqual(TEXT("Truncated and oversized Entity State PDUs are not decoded"), numEntityStatePDUs, 0);
+	TestEqual(TEXT("Truncated and oversized Entity State PDUs are counted as invalid"), pduProcessor->GetPDUTypeStatistics(EPDUType::EntityState).InvalidCount, int64(5));
+
+	pduProcessor->ProcessDISPacket(MakePacket(EPDUType::EntityState, 144));
+	TestEqual(TEXT("A minimum length Entity State PDU is decoded"), numEntityStatePDUs, 1);
+
+	//Entity State Update PDUs must be 72 bytes plus a whole number of articulation parameters
+	pduProcessor->ProcessDISPacket(MakePacket(EPDUType::EntityStateUpdate, 71));
+	pduProcessor->ProcessDISPacket(MakePacket(EPDUType::EntityStateUpdate, 72 + 15));
+	TestEqual(TEXT("Truncated and oversized Entity State Update PDUs are not decoded"), numEntityStateUpdatePDUs, 0);
+
+	//Electromagnetic Emission PDUs are validated by walking their systems and beams, which must never read past the end of the packet
+	pduProcessor->ProcessDISPacket(MakePacket(EPDUType::ElectromagneticEmission, 20));
+	TArray<uint8> systemsPastEnd = MakePacket(EPDUType::ElectromagneticEmission, 28);
+	systemsPastEnd[25] = 255;
+	pduProcessor->ProcessDISPacket(systemsPastEnd);
+	TArray<uint8> beamsPastEnd = MakePacket(EPDUType::ElectromagneticEmission, 48);
+	beamsPastEnd[25] = 1;
+	beamsPastEnd[29] = 255;
+	pduProcessor->ProcessDISPacket(beamsPastEnd);
+	pduProcessor->ProcessDISPacket(MakePacket(EPDUType::ElectromagneticEmission, 1024));
+	TestEqual(TEXT("Malformed Electromagnetic Emission PDUs are not decoded"), numElectromagneticEmissionsPDUs, 0);
+	TestEqual(TEXT("Malformed Electromagnetic Emission PDUs are counted as invalid"), pduProcessor->GetPDUTypeStatistics(EPDUType::ElectromagneticEmission).InvalidCount, int64(4));
+
+	return true;
+}
+
+#endif //WITH_DEV_AUTOMATION_TESTS
@@ -0,0 +1,179 @@
+// Copyright 2022 Gaming Research Integration for Learning Lab. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DISEnumsAndStructs.h"
+#include "Misc/ScopeRWLock.h"
+#include "DISAreaOfInterest.generated.h"
+
+USTRUCT(BlueprintType)
+struct FDISAreaOfInterestPolygon
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Area of Interest|Structs",
+		Meta = (Tooltip = "The vertices of the polygon in order, as latitude (X) and longitude (Y) in degrees. The polygon must not cross the antimeridian."))
+		TArray<FVector2D> LatLonVertices;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Area of Interest|Structs",
+		Meta = (Tooltip = "The minimum height in meters above the WGS84 ellipsoid of entities inside the polygon."))
+		float MinAltitude = -1000.0f;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Area of Interest|Structs",
+		Meta = (Tooltip = "The maximum height in meters above the WGS84 ellipsoid of entities inside the polygon."))
+		float MaxAltitude = 100000.0f;
+};
+
+USTRUCT(BlueprintType)
+struct FDISAreaOfInterestAltitudeBand
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Area of Interest|Structs",
+		Meta = (Tooltip = "The minimum height in meters above the WGS84 ellipsoid of entities inside the band."))
+		float MinAltitude = 0;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Area of Interest|Structs",
+		Meta = (Tooltip = "The maximum height in meters above the WGS84 ellipsoid of entities inside the band."))
+		float MaxAltitude = 0;
+};
+
+/**
+ * Lightweight record of an entity outside every area of interest.
+ */
+USTRUCT(BlueprintType)
+struct FDISOutOfAreaEntity
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadOnly, Category = "GRILL DIS|Area of Interest|Structs")
+		FEntityID EntityID;
+	UPROPERTY(BlueprintReadOnly, Category = "GRILL DIS|Area of Interest|Structs")
+		FEntityType EntityType;
+	/** The most recently received location of the entity in ECEF meters. */
+	UPROPERTY(BlueprintReadOnly, Category = "GRILL DIS|Area of Interest|Structs")
+		FVector ECEFLocation = FVector::ZeroVector;
+	/** Seconds since a PDU was last received for the entity. */
+	UPROPERTY(BlueprintReadOnly, Category = "GRILL DIS|Area of Interest|Structs")
+		float SecondsSinceLastUpdate = 0;
+};
+
+/**
+ * Geographic area of interest made of latitude/longitude polygons, altitude bands, and spheres around viewpoints. An entity is relevant if it is inside any of them.
+ * Entity State and Entity State Update packets are tested against the raw ECEF location in the packet on the thread they are received on, before they are decoded.
+ * Packets of registered entities always pass so that the owner can tell when they leave the area of interest.
+ * Packets of other entities outside the area of interest are dropped, and optionally kept as lightweight records.
+ * Every function is thread safe.
+ */
+class DISRUNTIME_API FDISAreaOfInterest
+{
+public:
+	/**
+	 * Replaces the volumes making up the area of interest.
+	 * @param Polygons - Latitude/longitude polygons with altitude limits.
+	 * @param AltitudeBands - Altitude bands covering the whole globe.
+	 * @param ViewpointRadiusMetersIn - The radius in meters of the spheres around each viewpoint. Set to 0 for none.
+	 */
+	void SetVolumes(const TArray<FDISAreaOfInterestPolygon>& Polygons, const TArray<FDISAreaOfInterestAltitudeBand>& AltitudeBands, float ViewpointRadiusMetersIn);
+	/**
+	 * Sets the viewpoints the viewpoint spheres are centered on.
+	 * @param ViewpointECEFLocations - The locations of the viewpoints in ECEF meters.
+	 */
+	void SetViewpoints(TArrayView<const FVector> ViewpointECEFLocations);
+	/**
+	 * Sets the exercise whose packets are filtered. Packets of other exercises are passed through.
+	 * @param ExerciseIDIn - The exercise ID.
+	 */
+	void SetExerciseID(int32 ExerciseIDIn)
+	{
+		ExerciseID = ExerciseIDIn;
+	}
+	/**
+	 * Sets whether or not entities outside the area of interest are kept as lightweight records.
+	 * @param bTrack - Whether or not to keep records.
+	 */
+	void SetTrackOutOfAreaEntities(bool bTrack);
+
+	/**
+	 * Returns whether or not the given location is inside the area of interest.
+	 * If the area of interest is made only of viewpoint spheres and no viewpoints have been set, every location is inside it.
+	 * @param ECEFLocation - The location in ECEF meters.
+	 */
+	bool IsRelevant(const double ECEFLocation[3]) const;
+
+	/** Returns whether or not the given Entity State packet should be decoded. Records the entity if it is outside the area of interest. */
+	bool FilterEntityStatePacket(const TArray<uint8>& InData);
+	/** Returns whether or not the given Entity State Update packet should be decoded. Updates the entity's record if it is outside the area of interest. */
+	bool FilterEntityStateUpdatePacket(const TArray<uint8>& InData);
+
+	/**
+	 * Lets packets of the given entity through regardless of its location.
+	 * @param EntityID - The entity that was registered.
+	 */
+	void AddRegisteredEntity(const FEntityID& EntityID);
+	/**
+	 * Stops letting packets of the given entity through regardless of its location.
+	 * @param EntityID - The entity that was unregistered.
+	 */
+	void RemoveRegisteredEntity(const FEntityID& EntityID);
+
+	/**
+	 * Records an entity outside the area of interest, or updates its record.
+	 * @param EntityID - The entity.
+	 * @param EntityType - The type of the entity. Null keeps the type already recorded.
+	 * @param ECEFLocation - The location of the entity in ECEF meters.
+	 */
+	void UpdateOutOfAreaEntity(const FEntityID& EntityID, const FEntityType* EntityType, const double ECEFLocation[3]);
+	/** Removes the record of the given entity. Returns whether or not a record was removed. */
+	bool RemoveOutOfAreaEntity(const FEntityID& EntityID);
+	/**
+	 * Removes the records of entities that have not been updated recently. Returns the number of records removed.
+	 * @param MaxSecondsSinceLastUpdate - The maximum age in seconds of the records to keep.
+	 */
+	int32 PruneOutOfAreaEntities(double MaxSecondsSinceLastUpdate);
+	/** Appends every out of area entity record to the given array. */
+	void GetOutOfAreaEntities(TArray<FDISOutOfAreaEntity>& OutEntities) const;
+	int32 GetNumOutOfAreaEntities() const;
+
+	/** Removes every volume, registered entity, and record. */
+	void Reset();
+
+private:
+	struct FPolygon
+	{
+		TArray<FVector2D> Vertices;
+		FBox2D Bounds;
+		float MinAltitude;
+		float MaxAltitude;
+	};
+
+	struct FOutOfAreaRecord
+	{
+		FEntityType EntityType;
+		double ECEFLocation[3];
+		double LastUpdateSeconds;
+	};
+
+	/** Shared by both packet filters once the entity ID, location, and type offsets of the packet are known. */
+	bool FilterEntityPacket(const TArray<uint8>& InData, int32 LocationOffset, int32 EntityTypeOffset);
+	static bool IsInsidePolygon(const FPolygon& Polygon, const FVector2D& LatLon);
+
+	//Guards the volumes and viewpoints
+	mutable FRWLock VolumesLock;
+	TArray<FPolygon> Polygons;
+	TArray<FFloatRange> AltitudeBands;
+	double ViewpointRadiusMeters = 0;
+	TArray<FVector, TInlineAllocator<4>> Viewpoints;
+
+	//Guards the registered entities
+	mutable FRWLock RegisteredEntitiesLock;
+	TSet<uint64> RegisteredEntities;
+
+	//Guards the out of area records
+	mutable FCriticalSection OutOfAreaEntitiesCriticalSection;
+	TMap<uint64, FOutOfAreaRecord> OutOfAreaEntities;
+	TAtomic<bool> bTrackOutOfAreaEntities { false };
+
+	TAtomic<int32> ExerciseID { 0 };
+};
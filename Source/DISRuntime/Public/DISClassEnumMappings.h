@@ -8,6 +8,9 @@
 #include "DISInterface.h"
 #include "DISClassEnumMappings.generated.h"
 
+//Forward declarations
+class UStaticMesh;
+
 USTRUCT()
 struct FDISClassEnumStruct
 {
@@ -21,6 +24,10 @@ struct FDISClassEnumStruct
 
 	UPROPERTY(EditAnywhere, Category = "GRILL DIS|Structs")
 		TArray<FEntityType> AssociatedDISEnumerations;
+
+	UPROPERTY(EditAnywhere, Category = "GRILL DIS|Structs",
+		Meta = (Tooltip = "Optional static mesh drawn as an instance in place of the entity actor while the entity is beyond the DIS Game Manager's proxy distance."))
+		TSoftObjectPtr<UStaticMesh> ProxyMesh;
 };
 
 /**
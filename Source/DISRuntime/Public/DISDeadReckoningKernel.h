@@ -0,0 +1,99 @@
+// Copyright 2022 Gaming Research Integration for Learning Lab. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DISEntityState.h"
+#include "glm/gtx/quaternion.hpp"
+
+/**
+ * Dead reckoning of a single entity, precomputed from its most recently received entity state.
+ * Everything that stays constant between PDUs (orientation matrices, angular velocity magnitude and axis, the body to world rotation,
+ * and the orientation held in the dead reckoning other parameters) is calculated once when the kernel is precomputed.
+ * Evaluating the kernel for a time since the PDU is then a few multiply-adds and, for rotating algorithms, a single rotation.
+ * The evaluation function is selected when the kernel is precomputed and is specialized at compile time for each dead reckoning algorithm.
+ */
+struct DISRUNTIME_API FDISDeadReckoningKernel
+{
+	FDISDeadReckoningKernel();
+
+	/**
+	 * Precomputes the kernel from the given entity state.
+	 * @param EntityState - The most recently received state of the entity.
+	 */
+	void Precompute(const FDISEntityState& EntityState);
+
+	/**
+	 * Writes the dead reckoned location, orientation, and linear velocity of the entity into the given state. Other fields of the state are left untouched.
+	 * Returns whether or not the entity was dead reckoned. Frozen entities and unsupported algorithms are reset to the received kinematics and return false.
+	 * @param DeltaTime - The time in seconds since the entity state the kernel was precomputed from.
+	 * @param DeadReckonedEntityState - The state to write the dead reckoned kinematics into.
+	 */
+	bool Evaluate(double DeltaTime, FDISEntityState& DeadReckonedEntityState) const
+	{
+		return EvaluateFunction(*this, DeltaTime, DeadReckonedEntityState);
+	}
+
+	/**
+	 * Returns whether or not evaluating the kernel gives the same pose for every time since the entity state, as for static, frozen, and motionless entities.
+	 */
+	bool IsStationary() const
+	{
+		return bStationary;
+	}
+
+private:
+	/** How the orientation of the entity changes over time. */
+	enum class EOrientationMode : uint8
+	{
+		/** The orientation does not change, either because the algorithm does not rotate or because the other parameters give a fixed orientation. */
+		Constant,
+		/** The orientation from the other parameters quaternion is rotated by a quaternion about the angular velocity axis. */
+		Quaternion,
+		/** The orientation matrix is rotated by a rotation matrix about the angular velocity axis. */
+		Matrix
+	};
+
+	using FEvaluateFunction = bool(*)(const FDISDeadReckoningKernel&, double, FDISEntityState&);
+
+	template<EDeadReckoningAlgorithm Algorithm>
+	static bool EvaluateAlgorithm(const FDISDeadReckoningKernel& Kernel, double DeltaTime, FDISEntityState& DeadReckonedEntityState);
+	static bool EvaluateNotDeadReckoned(const FDISDeadReckoningKernel& Kernel, double DeltaTime, FDISEntityState& DeadReckonedEntityState);
+
+	void PrecomputeBodyMotion(const glm::dvec3& AngularVelocity);
+	/**
+	 * Precomputes how the orientation changes over time. Rotating algorithms use the quaternion angular velocity when the other parameters hold an orientation quaternion, and the matrix angular velocity otherwise.
+	 */
+	void PrecomputeOrientation(const FDISEntityState& EntityState, bool bRotates, const glm::dvec3& QuaternionAngularVelocity, const glm::dvec3& MatrixAngularVelocity);
+
+	glm::dvec3 EvaluateBodyPosition(double DeltaTime) const;
+	FRotator EvaluateOrientation(double DeltaTime) const;
+
+	FEvaluateFunction EvaluateFunction;
+	bool bStationary;
+
+	//Received kinematics
+	glm::dvec3 Location;
+	FRotator Orientation;
+	FVector LinearVelocity;
+	FVector LinearAcceleration;
+
+	//World coordinate motion
+	glm::dvec3 WorldVelocity;
+	glm::dvec3 WorldAcceleration;
+
+	//Body coordinate motion, rotated into world coordinates. Position is Location + R1 terms * the velocity vectors + R2 terms * the acceleration vectors.
+	bool bBodyRotating;
+	double BodyAngularSpeed;
+	glm::dvec3 BodyVelocityTerms[3];
+	glm::dvec3 BodyAccelerationTerms[3];
+
+	//Orientation
+	EOrientationMode OrientationMode;
+	double RotationRate;
+	FQuat InitialQuaternion;
+	glm::dvec3 RotationAxis;
+	glm::dmat3 InitialOrientationMatrix;
+	glm::dmat3 RotationAxisOuterProduct;
+	glm::dmat3 RotationAxisCrossMatrix;
+};
@@ -0,0 +1,451 @@
+// Copyright 2022 Gaming Research Integration for Learning Lab. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DISEnumsAndStructs.h"
+#include "DISEntityState.h"
+#include "DISDeadReckoningKernel.h"
+
+//Forward declarations
+class AActor;
+class UDISReceiveComponent;
+class FReferenceCollector;
+
+/**
+ * Stable handle to an entity in an FDISEntityRegistry.
+ * Remains valid until the entity is removed, even when other entities are added or removed. A handle to a removed entity never resolves to a different entity.
+ */
+struct DISRUNTIME_API FDISEntityHandle
+{
+	/** Index of the slot the entity occupies. */
+	int32 Index = INDEX_NONE;
+	/** Generation of the slot at the time the handle was created. */
+	uint32 Generation = 0;
+
+	FDISEntityHandle() {}
+	FDISEntityHandle(int32 IndexIn, uint32 GenerationIn) : Index(IndexIn), Generation(GenerationIn) {}
+
+	bool IsSet() const
+	{
+		return Index != INDEX_NONE;
+	}
+
+	void Reset()
+	{
+		Index = INDEX_NONE;
+		Generation = 0;
+	}
+
+	bool operator== (const FDISEntityHandle& Other) const
+	{
+		return Index == Other.Index && Generation == Other.Generation;
+	}
+
+	bool operator!= (const FDISEntityHandle& Other) const
+	{
+		return !(operator==(Other));
+	}
+
+	friend uint32 GetTypeHash(const FDISEntityHandle& Handle)
+	{
+		return HashCombine(::GetTypeHash(Handle.Index), ::GetTypeHash(Handle.Generation));
+	}
+};
+
+/**
+ * Per entity dead reckoning settings and smoothing state. Stored contiguously in an FDISEntityRegistry alongside the entity's received and dead reckoned states.
+ */
+struct DISRUNTIME_API FDISDeadReckoningParameters
+{
+	/** Seconds since the entity's most recent Entity State or Entity State Update PDU. */
+	float TimeSinceLastUpdate = 0;
+	/** Seconds over which the dead reckoned state is smoothed from the previous dead reckoned state to the newly received one. */
+	float SmoothingPeriodSeconds = 0;
+	/** Distance in Unreal units from the closest viewpoint beyond which dead reckoning is skipped. Only used if bCullDeadReckoning is set. */
+	float CullingDistance = 0;
+	/** Difference between the received location and the dead reckoned location at the time the PDU was received, in ECEF meters. */
+	double SmoothingLocationOffset[3] = { 0, 0, 0 };
+	/** Difference between the received orientation and the dead reckoned orientation at the time the PDU was received, in radians. */
+	FRotator SmoothingRotationOffset = FRotator::ZeroRotator;
+	bool bPerformDeadReckoning = false;
+	bool bPerformSmoothing = false;
+	bool bCullDeadReckoning = false;
+	/** Whether or not dead reckoning was skipped for being too far from every viewpoint in the most recent update. */
+	bool bCulled = false;
+	/** Whether or not the dead reckoned state was updated by the most recent update. */
+	bool bUpdated = false;
+	/** Whether or not the most recent update was skipped because the entity's level of detail tier was not due for an update. */
+	bool bSkippedByLOD = false;
+	/** Whether or not the next update should dead reckon the entity regardless of its level of detail tier. Set when a new state is received. */
+	bool bForceLODUpdate = true;
+	/**
+	 * Whether or not the entity's pose cannot change until its next state is received, so updates skip it entirely. Set once a stationary state has been dead reckoned and applied.
+	 * Cleared when the dead reckoning kernel is precomputed from a new state.
+	 */
+	bool bDormant = false;
+	/** Whether or not the most recent update was skipped because the entity was dormant. */
+	bool bSkippedWhileDormant = false;
+	/** The level of detail tier of the entity in the most recent update. */
+	int32 LODTier = 0;
+	/** The level of detail tier assigned by the Significance Manager, or INDEX_NONE to pick the tier by distance to the viewpoints. */
+	int32 SignificanceLODTier = INDEX_NONE;
+	/** Seconds since the entity was last dead reckoned. */
+	float TimeSinceLODUpdate = 0;
+
+	/**
+	 * Blends the given dead reckoned state from the previous dead reckoned state towards the received state over the smoothing period.
+	 * @param DeadReckonedEntityState - The dead reckoned state to smooth.
+	 */
+	void Smooth(FDISEntityState& DeadReckonedEntityState) const;
+};
+
+/**
+ * Per entity state of the instanced mesh proxy drawn in place of an entity's actor while it is far from every viewpoint.
+ */
+struct DISRUNTIME_API FDISProxyInstance
+{
+	/** Index of the proxy mesh batch of the entity's type, or INDEX_NONE if its type has no proxy mesh. Only meaningful once bBatchResolved is set. */
+	int32 BatchIndex = INDEX_NONE;
+	/** Index of the entity's instance within its batch, or INDEX_NONE while the entity is not drawn as a proxy. */
+	int32 InstanceIndex = INDEX_NONE;
+	/** Whether or not the proxy mesh batch of the entity's type has been looked up. */
+	bool bBatchResolved = false;
+
+	bool IsProxy() const
+	{
+		return InstanceIndex != INDEX_NONE;
+	}
+};
+
+/**
+ * Fixed size ring buffer of an entity's most recently received kinematics, each stamped with the registry time it was valid at.
+ * Lets an entity be drawn by interpolating between received states at a fixed delay behind the present. Held inline so that it never allocates.
+ */
+struct DISRUNTIME_API FDISInterpolationBuffer
+{
+	/** Number of states kept. The interpolation delay should be shorter than this many PDU intervals. */
+	static constexpr int32 CAPACITY = 8;
+
+	struct FSample
+	{
+		/** Registry time in seconds the state was valid at. */
+		double Time = 0;
+		double Location[3] = { 0, 0, 0 };
+		FQuat Orientation = FQuat::Identity;
+		FVector LinearVelocity = FVector::ZeroVector;
+	};
+
+	FSample Samples[CAPACITY];
+	/** Index of the oldest sample. */
+	int32 First = 0;
+	int32 Count = 0;
+
+	/**
+	 * Adds the kinematics of the given state as the newest sample, replacing the oldest sample if the buffer is full. States older than the newest sample arrived out of order and are dropped.
+	 * @param EntityState - The received state.
+	 * @param Time - The registry time in seconds the state was valid at.
+	 */
+	void Push(const FDISEntityState& EntityState, double Time);
+	/**
+	 * Writes the location, orientation, and linear velocity of the entity at the given time into the given state by interpolating between the samples around it.
+	 * Times before the oldest sample hold the oldest sample. Returns false without writing anything if the time is after the newest sample, meaning the buffer has run dry.
+	 * @param Time - The registry time in seconds to interpolate at.
+	 * @param OutEntityState - The state to write the interpolated kinematics into.
+	 */
+	bool Interpolate(double Time, FDISEntityState& OutEntityState) const;
+
+	const FSample& GetSample(int32 Index) const
+	{
+		return Samples[(First + Index) % CAPACITY];
+	}
+	void Reset()
+	{
+		First = 0;
+		Count = 0;
+	}
+};
+
+/**
+ * Level of detail tiers used to lower the dead reckoning update rate of entities far from every viewpoint.
+ */
+struct DISRUNTIME_API FDISDeadReckoningLODSettings
+{
+	/** Squared maximum distance from the closest viewpoint of each tier, in ascending order. */
+	TArray<float, TInlineAllocator<4>> MaxDistancesSquared;
+	/** Seconds between dead reckoning updates of each tier. Zero updates every frame. */
+	TArray<float, TInlineAllocator<4>> UpdateIntervals;
+
+	int32 Num() const
+	{
+		return UpdateIntervals.Num();
+	}
+
+	void Reset()
+	{
+		MaxDistancesSquared.Reset();
+		UpdateIntervals.Reset();
+	}
+
+	/**
+	 * Returns the tier of an entity the given squared distance from its closest viewpoint. Entities further than every tier use the last tier.
+	 * @param DistanceSquared - The squared distance from the closest viewpoint.
+	 */
+	int32 GetTier(float DistanceSquared) const
+	{
+		for (int32 tier = 0; tier < MaxDistancesSquared.Num(); tier++)
+		{
+			if (DistanceSquared <= MaxDistancesSquared[tier])
+			{
+				return tier;
+			}
+		}
+		return MaxDistancesSquared.Num() - 1;
+	}
+};
+
+/**
+ * Registry of the DIS entities known to a DIS Game Manager, keyed by the packed 48 bit site:application:entity ID.
+ * Lookups use an open addressing hash table over the packed ID. Per entity data is stored in dense, contiguous arrays so that
+ * it can be iterated without chasing pointers. Removing an entity moves the last entity into its place, so dense indices are
+ * not stable across removals; hold an FDISEntityHandle to refer to an entity over time.
+ */
+class DISRUNTIME_API FDISEntityRegistry
+{
+public:
+	FDISEntityRegistry();
+
+	/**
+	 * Adds the given entity to the registry. If the entity ID is already registered, its actor and component are replaced and its handle is kept.
+	 * Returns the handle of the entity.
+	 * @param EntityID - The DIS Entity ID of the entity.
+	 * @param Actor - The actor representing the entity. Null for headless entities, which only exist as registry data.
+	 * @param Component - The DIS Receive Component of the actor. May be null.
+	 */
+	FDISEntityHandle Add(const FEntityID& EntityID, AActor* Actor, UDISReceiveComponent* Component);
+	/**
+	 * Removes the entity with the given entity ID from the registry.
+	 * Returns whether or not an entity was removed.
+	 * @param EntityID - The DIS Entity ID of the entity to remove.
+	 */
+	bool Remove(const FEntityID& EntityID);
+	/**
+	 * Removes the entity referred to by the given handle from the registry.
+	 * Returns whether or not an entity was removed.
+	 * @param Handle - The handle of the entity to remove.
+	 */
+	bool Remove(FDISEntityHandle Handle);
+	/** Removes all entities from the registry. Keeps the allocated memory. */
+	void Reset();
+
+	/**
+	 * Returns the dense index of the entity with the given entity ID, or INDEX_NONE if it is not registered.
+	 * @param EntityID - The DIS Entity ID to look up.
+	 */
+	int32 FindIndex(const FEntityID& EntityID) const
+	{
+		return FindIndexByKey(EntityID.ToUInt64());
+	}
+	/**
+	 * Returns the dense index of the entity referred to by the given handle, or INDEX_NONE if the handle is stale.
+	 * @param Handle - The handle to resolve.
+	 */
+	int32 FindIndex(FDISEntityHandle Handle) const
+	{
+		if (!SlotGenerations.IsValidIndex(Handle.Index) || SlotGenerations[Handle.Index] != Handle.Generation)
+		{
+			return INDEX_NONE;
+		}
+		return SlotToDense[Handle.Index];
+	}
+	/**
+	 * Returns the handle of the entity with the given entity ID, or an unset handle if it is not registered.
+	 * @param EntityID - The DIS Entity ID to look up.
+	 */
+	FDISEntityHandle FindHandle(const FEntityID& EntityID) const
+	{
+		const int32 denseIndex = FindIndex(EntityID);
+		return denseIndex == INDEX_NONE ? FDISEntityHandle() : GetHandle(denseIndex);
+	}
+	/**
+	 * Returns whether or not the given handle refers to an entity that is still registered.
+	 * @param Handle - The handle to check.
+	 */
+	bool IsValid(FDISEntityHandle Handle) const
+	{
+		return FindIndex(Handle) != INDEX_NONE;
+	}
+	bool Contains(const FEntityID& EntityID) const
+	{
+		return FindIndex(EntityID) != INDEX_NONE;
+	}
+
+	/** Returns the actor of the entity with the given entity ID, or null if it is not registered. */
+	AActor* FindActor(const FEntityID& EntityID) const
+	{
+		const int32 denseIndex = FindIndex(EntityID);
+		return denseIndex == INDEX_NONE ? nullptr : Actors[denseIndex];
+	}
+	/** Returns the DIS Receive Component of the entity with the given entity ID, or null if it is not registered. */
+	UDISReceiveComponent* FindComponent(const FEntityID& EntityID) const
+	{
+		const int32 denseIndex = FindIndex(EntityID);
+		return denseIndex == INDEX_NONE ? nullptr : Components[denseIndex];
+	}
+
+	/** Returns the number of registered entities. Dense indices range from 0 to Num() - 1. */
+	int32 Num() const
+	{
+		return EntityIDs.Num();
+	}
+	const FEntityID& GetEntityID(int32 DenseIndex) const
+	{
+		return EntityIDs[DenseIndex];
+	}
+	AActor* GetActor(int32 DenseIndex) const
+	{
+		return Actors[DenseIndex];
+	}
+	UDISReceiveComponent* GetComponent(int32 DenseIndex) const
+	{
+		return Components[DenseIndex];
+	}
+	/** Returns whether or not the entity at the given dense index is headless, meaning it has no actor and its state is only kept in the registry. */
+	bool IsHeadless(int32 DenseIndex) const
+	{
+		return Actors[DenseIndex] == nullptr;
+	}
+	FDISEntityHandle GetHandle(int32 DenseIndex) const
+	{
+		const int32 slotIndex = DenseToSlot[DenseIndex];
+		return FDISEntityHandle(slotIndex, SlotGenerations[slotIndex]);
+	}
+	/** Returns the actors of all registered entities, indexed by dense index. */
+	const TArray<AActor*>& GetActors() const
+	{
+		return Actors;
+	}
+
+	FDISEntityState& GetReceivedEntityState(int32 DenseIndex)
+	{
+		return ReceivedEntityStates[DenseIndex];
+	}
+	FDISEntityState& GetDeadReckonedEntityState(int32 DenseIndex)
+	{
+		return DeadReckonedEntityStates[DenseIndex];
+	}
+	FDISDeadReckoningParameters& GetDeadReckoningParameters(int32 DenseIndex)
+	{
+		return DeadReckoningParameters[DenseIndex];
+	}
+	FDISProxyInstance& GetProxyInstance(int32 DenseIndex)
+	{
+		return ProxyInstances[DenseIndex];
+	}
+	const FDISProxyInstance& GetProxyInstance(int32 DenseIndex) const
+	{
+		return ProxyInstances[DenseIndex];
+	}
+	/**
+	 * Precomputes the dead reckoning kernel of the entity at the given dense index from its received state. Must be called whenever the received state changes.
+	 * @param DenseIndex - The dense index of the entity.
+	 */
+	void PrecomputeDeadReckoningKernel(int32 DenseIndex)
+	{
+		DeadReckoningKernels[DenseIndex].Precompute(ReceivedEntityStates[DenseIndex]);
+		DeadReckoningParameters[DenseIndex].bDormant = false;
+	}
+	/**
+	 * Adds the received state of the entity at the given dense index to its interpolation buffer. The state is stamped as valid its time since last update ago.
+	 * @param DenseIndex - The dense index of the entity.
+	 */
+	void PushInterpolationSample(int32 DenseIndex)
+	{
+		InterpolationBuffers[DenseIndex].Push(ReceivedEntityStates[DenseIndex], CurrentTime - DeadReckoningParameters[DenseIndex].TimeSinceLastUpdate);
+	}
+	const FDISEntityState& GetReceivedEntityState(int32 DenseIndex) const
+	{
+		return ReceivedEntityStates[DenseIndex];
+	}
+	const FDISEntityState& GetDeadReckonedEntityState(int32 DenseIndex) const
+	{
+		return DeadReckonedEntityStates[DenseIndex];
+	}
+	const FDISDeadReckoningParameters& GetDeadReckoningParameters(int32 DenseIndex) const
+	{
+		return DeadReckoningParameters[DenseIndex];
+	}
+
+	/**
+	 * Dead reckons every registered entity by evaluating its precomputed dead reckoning kernel across worker threads, writing into its dead reckoned state and parameters.
+	 * Must be called from the game thread. Does not touch the entities' actors or components.
+	 * @param DeltaTime - The time in seconds since the previous update.
+	 * @param ViewpointECEFLocations - The ECEF locations in meters of the viewpoints used for dead reckoning culling and level of detail. Distances are measured from each entity's last dead reckoned location.
+	 * @param LODSettings - The level of detail tiers to update entities at, or null to update every entity every frame.
+	 * @param bAllowDormancy - Whether or not entities whose dead reckoning cannot change their pose become dormant after their next update.
+	 * @param InterpolationDelay - Seconds behind the present at which entities are interpolated from their interpolation buffers, falling back to dead reckoning when the buffer runs dry.
+	 * Zero dead reckons and smooths every entity instead.
+	 */
+	void UpdateDeadReckoning(float DeltaTime, TArrayView<const FVector> ViewpointECEFLocations, const FDISDeadReckoningLODSettings* LODSettings, bool bAllowDormancy, float InterpolationDelay = 0);
+
+	/**
+	 * Reports the actors and components held by the registry to the garbage collector.
+	 * @param Collector - The reference collector to report to.
+	 * @param ReferencingObject - The object that owns the registry.
+	 */
+	void AddReferencedObjects(FReferenceCollector& Collector, const UObject* ReferencingObject);
+
+private:
+	/** Minimum number of entities before dead reckoning is spread across worker threads. */
+	static constexpr int32 MIN_PARALLEL_DEAD_RECKONING_ENTITIES = 32;
+	/** Minimum number of buckets in the hash table. Must be a power of two. */
+	static constexpr int32 MIN_BUCKETS = 64;
+
+	int32 FindIndexByKey(uint64 Key) const;
+	/** Returns the bucket holding the given key, or INDEX_NONE if the key is not present. */
+	int32 FindBucket(uint64 Key) const;
+	void InsertIntoBuckets(uint64 Key, int32 DenseIndex);
+	/** Removes the given bucket from the hash table, shifting later entries of the probe sequence back to keep lookups correct without tombstones. */
+	void RemoveBucket(int32 BucketIndex);
+	void Rehash(int32 NewBucketCount);
+	/** Removes the entity at the given dense index, moving the last entity into its place. */
+	void RemoveAtDense(int32 DenseIndex);
+
+	static uint32 HashKey(uint64 Key)
+	{
+		//Finalizer from MurmurHash3 to spread the site, application, and entity bits across the hash
+		Key ^= Key >> 33;
+		Key *= 0xff51afd7ed558ccdULL;
+		Key ^= Key >> 33;
+		Key *= 0xc4ceb9fe1a85ec53ULL;
+		Key ^= Key >> 33;
+		return static_cast<uint32>(Key);
+	}
+
+	//Open addressing hash table using linear probing. A bucket is empty when its dense index is INDEX_NONE.
+	TArray<uint64> BucketKeys;
+	TArray<int32> BucketDenseIndices;
+	uint32 BucketMask;
+
+	//Dense per entity data, indexed by dense index
+	TArray<uint64> EntityKeys;
+	TArray<FEntityID> EntityIDs;
+	TArray<AActor*> Actors;
+	TArray<UDISReceiveComponent*> Components;
+	TArray<int32> DenseToSlot;
+
+	//Dense dead reckoning inputs and outputs, indexed by dense index
+	TArray<FDISEntityState> ReceivedEntityStates;
+	TArray<FDISEntityState> DeadReckonedEntityStates;
+	TArray<FDISDeadReckoningParameters> DeadReckoningParameters;
+	TArray<FDISDeadReckoningKernel> DeadReckoningKernels;
+	TArray<FDISProxyInstance> ProxyInstances;
+	TArray<FDISInterpolationBuffer> InterpolationBuffers;
+	/** Seconds the registry has been updated for, which interpolation samples are stamped with. */
+	double CurrentTime = 0;
+
+	//Handle slots, indexed by FDISEntityHandle::Index
+	TArray<int32> SlotToDense;
+	TArray<uint32> SlotGenerations;
+	TArray<int32> FreeSlots;
+};
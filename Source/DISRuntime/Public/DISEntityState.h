@@ -0,0 +1,125 @@
+// Copyright 2022 Gaming Research Integration for Learning Lab. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DISEnumsAndStructs.h"
+#include "PDUs/EntityInfoFamily/GRILL_EntityStatePDU.h"
+#include "PDUs/EntityInfoFamily/GRILL_EntityStateUpdatePDU.h"
+
+/**
+ * Compact, allocation free representation of an entity's state used on the receive and dead reckoning hot paths.
+ * Mirrors the fields of FEntityStatePDU using inline storage so it can be copied every frame without touching the heap.
+ * Convert to an FEntityStatePDU on demand when handing the state to Blueprints.
+ */
+struct DISRUNTIME_API FDISEntityState
+{
+	/** Number of articulation parameters stored inline before the articulation parameter array allocates. */
+	static constexpr int32 INLINE_ARTICULATION_PARAMETERS = 4;
+
+	/** Flags returned when applying a PDU for each section of the state that it changed. */
+	static constexpr uint8 CHANGED_APPEARANCE = 1 << 0;
+	static constexpr uint8 CHANGED_CAPABILITIES = 1 << 1;
+	static constexpr uint8 CHANGED_ARTICULATION = 1 << 2;
+	/** Either the entity type or the alternative entity type changed. */
+	static constexpr uint8 CHANGED_ENTITY_TYPE = 1 << 3;
+	static constexpr uint8 CHANGED_FORCE_ID = 1 << 4;
+	static constexpr uint8 CHANGED_MARKING = 1 << 5;
+	/** Number of bytes in the dead reckoning other parameters field. */
+	static constexpr int32 OTHER_PARAMETERS_BYTES = 15;
+	/** Maximum number of characters in an entity marking. */
+	static constexpr int32 MARKING_CHARACTERS = 11;
+
+	//PDU header
+	uint8 ProtocolVersion = 6;
+	uint8 ExerciseID = 0;
+	uint8 ProtocolFamily = 0;
+	uint32 Timestamp = 0;
+	uint8 Length = 0;
+	int32 Padding = 0;
+
+	/** The site, application, and unique identifier for this entity. */
+	FEntityID EntityID;
+	/** Enumeration to distinguish different teams or sides in a scenario. */
+	EForceID ForceID = EForceID::Other;
+	/** The type of the entity. */
+	FEntityType EntityType;
+	/** The type of the entity as it should appear to entities of other forces. */
+	FEntityType AlternativeEntityType;
+	/** The location of the entity in ECEF. */
+	double EntityLocation[3] = { 0, 0, 0 };
+	/** The orientation of the entity in Psi (Yaw), Theta (Pitch), Phi (Roll) - in radians. */
+	FRotator EntityOrientation = FRotator::ZeroRotator;
+	/** The entity's linear velocity in meters per second. */
+	FVector EntityLinearVelocity = FVector::ZeroVector;
+	/** The dead reckoning algorithm to use for the entity. */
+	EDeadReckoningAlgorithm DeadReckoningAlgorithm = EDeadReckoningAlgorithm::Static;
+	/** The dead reckoning other parameters field. */
+	uint8 OtherDeadReckoningParameters[OTHER_PARAMETERS_BYTES] = { 0 };
+	/** The entity's linear acceleration in m/s^2. */
+	FVector EntityLinearAcceleration = FVector::ZeroVector;
+	/** The entity's angular velocity in radians per second. */
+	FVector EntityAngularVelocity = FVector::ZeroVector;
+	/** The appearance of the entity. */
+	FEntityAppearance EntityAppearance;
+	/** The capabilities of the entity. */
+	int32 Capabilities = 0;
+	/** Null terminated ASCII marking of the entity. */
+	ANSICHAR Marking[MARKING_CHARACTERS + 1] = { 0 };
+	/** The articulation parameters of the entity. */
+	TArray<FArticulationParameters, TInlineAllocator<INLINE_ARTICULATION_PARAMETERS>> ArticulationParameters;
+	/** Hash of the articulation parameters, so that unchanged parameters are detected without comparing them field by field. */
+	uint32 ArticulationHash = 0;
+
+	FDISEntityState() {}
+	explicit FDISEntityState(const FEntityStatePDU& EntityStatePDUIn)
+	{
+		FromEntityStatePDU(EntityStatePDUIn);
+	}
+
+	/**
+	 * Sets up the state from the given Entity State PDU. Appearance, capabilities, articulation, type, force, and marking are only copied if they differ from the state's own.
+	 * Returns the CHANGED_ flags of the sections that changed. Appearances are compared by their raw bits.
+	 * @param EntityStatePDUIn - The Entity State PDU to copy from.
+	 */
+	uint8 FromEntityStatePDU(const FEntityStatePDU& EntityStatePDUIn);
+	/**
+	 * Applies the fields carried by the given Entity State Update PDU to the state. Returns the CHANGED_ flags of the sections that changed.
+	 * @param EntityStateUpdatePDUIn - The Entity State Update PDU to apply.
+	 */
+	uint8 ApplyEntityStateUpdatePDU(const FEntityStateUpdatePDU& EntityStateUpdatePDUIn);
+
+	/**
+	 * Writes the state into the given Entity State PDU. Reuses the memory already held by the PDU.
+	 * @param EntityStatePDUOut - The Entity State PDU to write to.
+	 */
+	void ToEntityStatePDU(FEntityStatePDU& EntityStatePDUOut) const;
+	FEntityStatePDU ToEntityStatePDU() const;
+	/**
+	 * Writes only the fields changed by dead reckoning (location, orientation, and linear velocity) into the given Entity State PDU.
+	 * @param EntityStatePDUOut - The Entity State PDU to write to.
+	 */
+	void CopyKinematicsToEntityStatePDU(FEntityStatePDU& EntityStatePDUOut) const;
+	/**
+	 * Copies only the fields changed by dead reckoning (location, orientation, and linear velocity) from the given state.
+	 * @param EntityStateIn - The state to copy from.
+	 */
+	void CopyKinematicsFrom(const FDISEntityState& EntityStateIn);
+
+	FString GetMarking() const;
+	void SetMarking(const FString& MarkingIn);
+	void SetMarking(const ANSICHAR* MarkingIn);
+
+	void SetOtherDeadReckoningParameters(const TArray<uint8>& OtherParametersIn);
+
+	/** Returns a hash of the given articulation parameters. Empty parameters hash to zero. */
+	static uint32 HashArticulationParameters(TArrayView<const FArticulationParameters> ArticulationParametersIn);
+
+private:
+	/** Returns whether or not the stored marking matches the given one once truncated to the marking length. */
+	bool IsMarkingEqual(const FString& MarkingIn) const;
+	/** Returns whether or not the stored articulation parameters match the given ones field for field. */
+	bool AreArticulationParametersEqual(TArrayView<const FArticulationParameters> ArticulationParametersIn) const;
+	/** Copies the given articulation parameters if they differ from the state's own. Returns CHANGED_ARTICULATION if they did. */
+	uint8 UpdateArticulationParameters(TArrayView<const FArticulationParameters> ArticulationParametersIn);
+};
@@ -0,0 +1,123 @@
+// Copyright 2022 Gaming Research Integration for Learning Lab. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DISEnumsAndStructs.h"
+
+//Forward declarations
+class AActor;
+class UStaticMesh;
+class UDISClassEnumMappings;
+
+DECLARE_LOG_CATEGORY_EXTERN(LogDISEntityTypeResolver, Log, All);
+
+/**
+ * Resolves DIS Entity Types to the actor classes mapped to them in a UDISClassEnumMappings asset.
+ * The mappings are compiled into a decision trie over kind, domain, country, category, subcategory, specific, and extra, where a field set to -1 is a wildcard.
+ * When several mappings match, the most specific one wins: fields are compared from kind to extra and at each field an exact match takes precedence over a wildcard.
+ * Every resolution, including a failed one, is cached by the packed Entity Type so repeated lookups for the same type do not walk the trie.
+ */
+class DISRUNTIME_API FDISEntityTypeResolver
+{
+public:
+	FDISEntityTypeResolver();
+
+	/**
+	 * Clears any existing mappings and compiles the mappings in the given asset.
+	 * Returns the number of Entity Types that were mapped.
+	 * @param ClassEnumMappings - The DIS enumeration mappings to compile.
+	 */
+	int32 Compile(const UDISClassEnumMappings* ClassEnumMappings);
+	/**
+	 * Maps the given Entity Type to the given actor class. Replaces any existing mapping for the same Entity Type and clears the resolution cache.
+	 * Returns whether or not an existing mapping was replaced.
+	 * @param EntityType - The Entity Type to map. Fields set to -1 match any value.
+	 * @param ActorClass - The actor class to map the Entity Type to.
+	 * @param ProxyMesh - The static mesh drawn in place of the actor while the entity is a proxy. May be null.
+	 */
+	bool AddMapping(const FEntityType& EntityType, const TSoftClassPtr<AActor>& ActorClass, const TSoftObjectPtr<UStaticMesh>& ProxyMesh = TSoftObjectPtr<UStaticMesh>());
+	/** Removes all mappings and cached resolutions. */
+	void Reset();
+
+	/**
+	 * Returns the actor class mapped to the given Entity Type, or null if no mapping matches it.
+	 * @param EntityType - The Entity Type to resolve. Should not contain wildcards.
+	 * @param bOutWasCached - Set to whether or not the resolution was served from the cache.
+	 */
+	const TSoftClassPtr<AActor>* Resolve(const FEntityType& EntityType, bool& bOutWasCached)
+	{
+		const int32 mappingIndex = ResolveMappingIndex(EntityType, bOutWasCached);
+		return mappingIndex == INDEX_NONE ? nullptr : &MappedClasses[mappingIndex];
+	}
+	const TSoftClassPtr<AActor>* Resolve(const FEntityType& EntityType)
+	{
+		bool bWasCached;
+		return Resolve(EntityType, bWasCached);
+	}
+
+	/**
+	 * Returns the proxy mesh mapped to the given Entity Type, or null if no mapping matches it or the matching mapping has no proxy mesh.
+	 * @param EntityType - The Entity Type to resolve. Should not contain wildcards.
+	 */
+	const TSoftObjectPtr<UStaticMesh>* ResolveProxyMesh(const FEntityType& EntityType)
+	{
+		bool bWasCached;
+		const int32 mappingIndex = ResolveMappingIndex(EntityType, bWasCached);
+		return mappingIndex == INDEX_NONE || MappedProxyMeshes[mappingIndex].IsNull() ? nullptr : &MappedProxyMeshes[mappingIndex];
+	}
+
+	/** Returns the actor classes of all mappings, in the order they were added. */
+	const TArray<TSoftClassPtr<AActor>>& GetMappedClasses() const
+	{
+		return MappedClasses;
+	}
+
+	/** Returns the proxy meshes of all mappings, in the order they were added. Null for mappings without a proxy mesh. */
+	const TArray<TSoftObjectPtr<UStaticMesh>>& GetMappedProxyMeshes() const
+	{
+		return MappedProxyMeshes;
+	}
+
+	int32 GetNumMappings() const
+	{
+		return MappedClasses.Num();
+	}
+	int64 GetCacheHits() const
+	{
+		return CacheHits;
+	}
+	int64 GetCacheMisses() const
+	{
+		return CacheMisses;
+	}
+
+private:
+	/** Number of fields in an Entity Type, and the depth of the trie. */
+	static constexpr int32 NUMBER_OF_FIELDS = 7;
+
+	struct FNode
+	{
+		/** Children keyed by an exact field value. */
+		TMap<int32, int32> ExactChildren;
+		/** Child for a wildcard field value. */
+		int32 WildcardChild = INDEX_NONE;
+		/** Index into MappedClasses for leaf nodes. */
+		int32 MappingIndex = INDEX_NONE;
+	};
+
+	/** Returns the index into MappedClasses of the mapping that matches the given Entity Type, or INDEX_NONE if none does. */
+	int32 ResolveMappingIndex(const FEntityType& EntityType, bool& bOutWasCached);
+	static void GetFields(const FEntityType& EntityType, int32 OutFields[NUMBER_OF_FIELDS]);
+	int32 FindMapping(int32 NodeIndex, const int32 Fields[NUMBER_OF_FIELDS], int32 Depth) const;
+
+	TArray<FNode> Nodes;
+	TArray<TSoftClassPtr<AActor>> MappedClasses;
+	/** Proxy meshes of the mappings, indexed like MappedClasses. */
+	TArray<TSoftObjectPtr<UStaticMesh>> MappedProxyMeshes;
+	/** Resolved mapping index keyed by packed Entity Type. INDEX_NONE caches a failed resolution. */
+	TMap<uint64, int32> ResolutionCache;
+
+	int64 CacheHits = 0;
+	int64 CacheMisses = 0;
+};
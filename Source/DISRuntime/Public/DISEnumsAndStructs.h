@@ -584,15 +584,10 @@ struct FEntityID
 
 	friend uint32 GetTypeHash(const FEntityID& other)
 	{
-		const FString EntityID = FString::Printf(TEXT("%d:%d:%d"),
-			other.Site,
-			other.Application,
-			other.Entity
-		);
-		return GetTypeHash(EntityID);
+		return GetTypeHash(other.ToUInt64());
 	}
 
-	FString ToString()
+	FString ToString() const
 	{
 		return FString::FromInt(Site) + ":" + FString::FromInt(Application) + ':' + FString::FromInt(Entity);
 	}
@@ -798,16 +793,7 @@ struct FEntityType
 
 	friend uint32 GetTypeHash(const FEntityType& Other)
 	{
-		const FString EntityTypeString = FString::Printf(TEXT("%d.%d.%d.%d.%d.%d.%d"),
-			Other.EntityKind,
-			Other.Domain,
-			Other.Country,
-			Other.Category,
-			Other.Subcategory,
-			Other.Specific,
-			Other.Extra
-		);
-		return GetTypeHash(EntityTypeString);
+		return GetTypeHash(Other.ToUInt64());
 	}
 
 	FString ToString() const
@@ -819,7 +805,7 @@ struct FEntityType
 	uint64 ToUInt64() const
 	{
 		const uint64 BitString = ((static_cast<uint64>(Extra) & 0xFF) << 0) | ((static_cast<uint64>(Specific) & 0xFF) << 8) | ((static_cast<uint64>(Subcategory) & 0xFF) << 16) |
-			((static_cast<uint64>(Category) & 0xFF) << 24) | ((static_cast<uint64>(Country) & 0xFF) << 32) | ((static_cast<uint64>(Domain) & 0xFF) << 48) | ((static_cast<uint64>(EntityKind) & 0xFF) << 56);
+			((static_cast<uint64>(Category) & 0xFF) << 24) | ((static_cast<uint64>(Country) & 0xFFFF) << 32) | ((static_cast<uint64>(Domain) & 0xFF) << 48) | ((static_cast<uint64>(EntityKind) & 0xFF) << 56);
 		
 		return BitString;
 	}
@@ -909,6 +895,23 @@ struct FArticulationParameters
 		ParameterValue = 0.f;
 	}
 
+	void SetupFromOpenDIS(const DIS::ArticulationParameter& ArticulationParameterIn)
+	{
+		ParameterTypeDesignator = ArticulationParameterIn.getParameterTypeDesignator();
+		ChangeIndicator = ArticulationParameterIn.getChangeIndicator();
+		PartAttachedTo = ArticulationParameterIn.getPartAttachedTo();
+		ParameterType = ArticulationParameterIn.getParameterType();
+
+		if (ParameterTypeDesignator == 0)
+		{
+			ParameterValue = ArticulationParameterIn.getParameterValue();
+		}
+		else
+		{
+			AttachedPartType = ArticulationParameterIn.getParameterValue();
+		}
+	}
+
 	DIS::ArticulationParameter ToOpenDIS() const
 	{
 		DIS::ArticulationParameter OutParam;
@@ -2,23 +2,47 @@
 
 #pragma once
 
-#include <map>
-
 #include "CoreMinimal.h"
 #include "DISEnumsAndStructs.h"
 #include "PDUMasterInclude.h"
 #include "DISClassEnumMappings.h"
+#include "DISEntityRegistry.h"
+#include "DISEntityTypeResolver.h"
+#include "DISTimingWheel.h"
+#include "DISSpatialIndex.h"
+#include "DISAreaOfInterest.h"
+#include "DISTimestampClock.h"
+#include "DISEntityState.h"
+#include "Engine/StreamableManager.h"
 #include "UDPSubsystem.h"
 #include "GameFramework/Info.h"
 #include "DISGameManager.generated.h"
 
 //Forward declarations
+class ADISGameManager;
 class UDISReceiveComponent;
+class UHierarchicalInstancedStaticMeshComponent;
+class UDISTerrainHeightField;
 
 DECLARE_LOG_CATEGORY_EXTERN(LogDISGameManager, Log, All);
 
 DECLARE_STATS_GROUP(TEXT("DISGameManager_Game"), STATGROUP_DISGameManager, STATCAT_Advanced);
 DECLARE_CYCLE_STAT(TEXT("GetAssociatedDISComponent"), STAT_GetAssociatedDISComponent, STATGROUP_DISGameManager);
+DECLARE_CYCLE_STAT(TEXT("ResolveEntityType"), STAT_ResolveEntityType, STATGROUP_DISGameManager);
+DECLARE_CYCLE_STAT(TEXT("ProcessPendingEntitySpawns"), STAT_ProcessPendingEntitySpawns, STATGROUP_DISGameManager);
+DECLARE_CYCLE_STAT(TEXT("UpdateDeadReckoning"), STAT_UpdateDeadReckoning, STATGROUP_DISGameManager);
+DECLARE_CYCLE_STAT(TEXT("ApplyDeadReckoning"), STAT_ApplyDeadReckoning, STATGROUP_DISGameManager);
+DECLARE_CYCLE_STAT(TEXT("ExpireEntityTimeouts"), STAT_ExpireEntityTimeouts, STATGROUP_DISGameManager);
+DECLARE_CYCLE_STAT(TEXT("UpdateProxyEntities"), STAT_UpdateProxyEntities, STATGROUP_DISGameManager);
+DECLARE_CYCLE_STAT(TEXT("ApplyEntityTransforms"), STAT_ApplyEntityTransforms, STATGROUP_DISGameManager);
+
+/**
+ * Returns the spawn importance of a pending entity. Entities with higher importance are spawned first.
+ * Called on the game thread.
+ * @param EntityState - The latest state of the pending entity.
+ * @param DistanceToViewpointMeters - The distance in meters from the entity to the closest local player viewpoint, or 0 if there are no viewpoints.
+ */
+DECLARE_DELEGATE_RetVal_TwoParams(float, FDISSpawnImportanceDelegate, const FDISEntityState& /*EntityState*/, double /*DistanceToViewpointMeters*/);
 
 USTRUCT(Blueprintable)
 struct FSendSocketInfo
@@ -77,6 +101,72 @@ struct FInitialDISConditions
 	}
 };
 
+USTRUCT()
+struct FDISActorPool
+{
+	GENERATED_BODY()
+
+	/** Hidden, disabled actors waiting to be reused for a new entity. */
+	UPROPERTY()
+		TArray<AActor*> InactiveActors;
+};
+
+USTRUCT()
+struct FDISProxyMeshBatch
+{
+	GENERATED_BODY()
+
+	/** Draws every proxy entity whose type maps to the batch's proxy mesh. */
+	UPROPERTY()
+		UHierarchicalInstancedStaticMeshComponent* InstancedMesh = nullptr;
+
+	/** Instances hidden at zero scale, waiting to be reused. Instances are never removed so that instance indices stay stable. */
+	TArray<int32> FreeInstances;
+	/** Whether or not any instance transform changed since the render state was last marked dirty. */
+	bool bRenderStateDirty = false;
+};
+
+USTRUCT(BlueprintType)
+struct FDISDeadReckoningLODTier
+{
+	GENERATED_BODY()
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Structs",
+		Meta = (Tooltip = "The maximum distance in Unreal units from the closest local player viewpoint for entities in this tier. Entities further than every tier use the last tier.", ClampMin = 0, UIMin = 0))
+		float MaxDistance = 0;
+
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Structs",
+		Meta = (Tooltip = "The number of times per second entities in this tier are dead reckoned, ground clamped, and moved. Set to 0 to update every frame.", ClampMin = 0, UIMin = 0))
+		float UpdateRate = 0;
+
+	FDISDeadReckoningLODTier() {}
+	FDISDeadReckoningLODTier(float MaxDistanceIn, float UpdateRateIn) : MaxDistance(MaxDistanceIn), UpdateRate(UpdateRateIn) {}
+};
+
+/**
+ * Applies the entity transforms queued by a DIS Game Manager in a single batch. Runs in its own tick group, after the DIS Game Manager has ticked.
+ */
+USTRUCT()
+struct FDISEntityTransformTickFunction : public FTickFunction
+{
+	GENERATED_BODY()
+
+	/** The DIS Game Manager whose queued transforms are applied. */
+	ADISGameManager* Target = nullptr;
+
+	virtual void ExecuteTick(float DeltaTime, ELevelTick TickType, ENamedThreads::Type CurrentThread, const FGraphEventRef& MyCompletionGraphEvent) override;
+	virtual FString DiagnosticMessage() override;
+};
+
+template<>
+struct TStructOpsTypeTraits<FDISEntityTransformTickFunction> : public TStructOpsTypeTraitsBase2<FDISEntityTransformTickFunction>
+{
+	enum
+	{
+		WithCopy = false
+	};
+};
+
 UCLASS(Blueprintable)
 class DISRUNTIME_API ADISGameManager : public AInfo
 {
@@ -101,49 +191,49 @@ public:
 	 * @param EntityStatePDUIn - The Entity State PDU to pass to the appropriate entity.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "GRILL DIS|Game Manager")
-		void HandleEntityStatePDU(FEntityStatePDU EntityStatePDUIn);
+		void HandleEntityStatePDU(const FEntityStatePDU& EntityStatePDUIn);
 	/**
 	 * Delegates the given Entity State Update PDU to the appropriate DIS Entity actor.
 	 * @param EntityStateUpdatePDUIn - The Entity State Update PDU to pass to the appropriate entity.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "GRILL DIS|Game Manager")
-		void HandleEntityStateUpdatePDU(FEntityStateUpdatePDU EntityStateUpdatePDUIn);
+		void HandleEntityStateUpdatePDU(const FEntityStateUpdatePDU& EntityStateUpdatePDUIn);
 	/**
 	 * Delegates the given Fire PDU to the appropriate DIS Entity actor.
 	 * @param FirePDUIn - The Fire PDU to pass to the appropriate entity.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "GRILL DIS|Game Manager")
-		void HandleFirePDU(FFirePDU FirePDUIn);
+		void HandleFirePDU(const FFirePDU& FirePDUIn);
 	/**
 	 * Delegates the given Detonation PDU to the appropriate DIS Entity actor.
 	 * @param DetonationPDUIn - The Detonation PDU to pass to the appropriate entity.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "GRILL DIS|Game Manager")
-		void HandleDetonationPDU(FDetonationPDU DetonationPDUIn);
+		void HandleDetonationPDU(const FDetonationPDU& DetonationPDUIn);
 	/**
 	 * Delegates the given Remove Entity PDU to the appropriate DIS Entity actor.
 	 * @param RemoveEntityPDUIn - The Remove Entity PDU to pass to the appropriate entity.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "GRILL DIS|Game Manager")
-		void HandleRemoveEntityPDU(FRemoveEntityPDU RemoveEntityPDUIn);
+		void HandleRemoveEntityPDU(const FRemoveEntityPDU& RemoveEntityPDUIn);
 	/**
 	 * Delegates the given Stop/Freeze PDU to the appropriate DIS Entity actor.
 	 * @param StopFreezePDUIn - The Stop/Freeze PDU to pass to the appropriate entity.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "GRILL DIS|Game Manager")
-		void HandleStopFreezePDU(FStopFreezePDU StopFreezePDUIn);
+		void HandleStopFreezePDU(const FStopFreezePDU& StopFreezePDUIn);
 	/**
 	 * Delegates the given Start/Resume PDU to the appropriate DIS Entity actor.
 	 * @param StartResumePDUIn - The Start/Resume PDU to pass to the appropriate entity.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "GRILL DIS|Game Manager")
-		void HandleStartResumePDU(FStartResumePDU StartResumePDUIn);
+		void HandleStartResumePDU(const FStartResumePDU& StartResumePDUIn);
 	/**
 	 * Delegates the given ElectromagneticEmissions PDU to the appropriate DIS Entity actor.
 	 * @param ElectromagneticEmissionsPDUIn - The ElectromagneticEmissions PDU to pass to the appropriate entity.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "GRILL DIS|Game Manager")
-		void HandleElectromagneticEmissionsPDU(FElectromagneticEmissionsPDU ElectromagneticEmissionsPDUIn);
+		void HandleElectromagneticEmissionsPDU(const FElectromagneticEmissionsPDU& ElectromagneticEmissionsPDUIn);
 
 	/**
 	 * Adds a new entry to the DIS Entity map.
@@ -161,6 +251,232 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "GRILL DIS|Game Manager")
 		bool RemoveDISEntityFromMap(FEntityID EntityIDToRemove);
 
+	/**
+	 * Removes the given entity actor from the sim. If actor pooling is enabled and the actor came from an actor pool, it is removed from the DIS Entity map,
+	 * hidden, disabled, and returned to its class's pool. Otherwise the actor is destroyed.
+	 * Returns whether or not the actor was returned to a pool.
+	 * @param EntityActor - The entity actor to remove.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GRILL DIS|Game Manager|Pooling")
+		bool ReleaseEntityActor(AActor* EntityActor);
+	/**
+	 * Spawns inactive actors of the given class into its actor pool, up to the maximum number of pooled actors per class.
+	 * Returns the number of actors that were added to the pool.
+	 * @param EntityClass - The entity class to spawn pooled actors of.
+	 * @param Count - The number of actors to add to the pool.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GRILL DIS|Game Manager|Pooling")
+		int32 PrewarmActorPool(TSubclassOf<AActor> EntityClass, int32 Count);
+	/**
+	 * Gets the number of inactive actors waiting in the actor pool of the given class.
+	 * @param EntityClass - The entity class of the pool.
+	 */
+	UFUNCTION(BlueprintPure, Category = "GRILL DIS|Game Manager|Pooling")
+		int32 GetNumPooledActors(TSubclassOf<AActor> EntityClass) const;
+
+	/**
+	 * Gets the number of entities waiting to be spawned, including entities waiting on their class to load.
+	 */
+	UFUNCTION(BlueprintPure, Category = "GRILL DIS|Game Manager|Spawning")
+		int32 GetNumPendingEntitySpawns() const
+	{
+		return PendingEntitySpawns.Num();
+	}
+
+	/**
+	 * Optional override for the order that pending entities are spawned in. When unbound, entities closest to a local player viewpoint are spawned first.
+	 */
+	FDISSpawnImportanceDelegate SpawnImportanceDelegate;
+
+	/**
+	 * Gets the mapping between DIS Entity IDs and corresponding entity actors.
+	 * The map is built from the entity registry on demand and cached until an entity is added or removed.
+	 * Not pure so that Blueprint graphs copy the map once per call site instead of once per connected node.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GRILL DIS|Game Manager")
+		const TMap<FEntityID, AActor*>& GetDISActorMappings() const;
+
+	/**
+	 * Gets the registry of DIS entities managed by this DIS Game Manager.
+	 */
+	const FDISEntityRegistry& GetEntityRegistry() const
+	{
+		return EntityRegistry;
+	}
+
+	/**
+	 * Copies the dead reckoning inputs of the given component into the entity registry. Called by registered DIS Receive Components whenever they receive a new entity state.
+	 * @param DISComponent - The DIS Receive Component of a registered entity.
+	 */
+	void UpdateEntityDeadReckoningState(const UDISReceiveComponent* DISComponent);
+	/**
+	 * Pushes back the timeout of the given component's entity, starting it if the entity does not have one yet. Called by registered DIS Receive Components whenever they receive a new entity state.
+	 * Returns whether or not the entity is registered and timed out by this DIS Game Manager.
+	 * @param DISComponent - The DIS Receive Component of a registered entity.
+	 */
+	bool RefreshEntityTimeout(const UDISReceiveComponent* DISComponent);
+
+	/**
+	 * Gets the spatial index of the dead reckoned locations of the registered entities, in ECEF meters.
+	 * Entities are indexed by their entity registry handle. Entities skipped by dead reckoning culling or level of detail keep their last updated location.
+	 */
+	const FDISSpatialIndex& GetEntitySpatialIndex() const
+	{
+		return EntitySpatialIndex;
+	}
+	/**
+	 * Gets every registered entity whose dead reckoned location is within the given distance of a location.
+	 * @param Location - The center of the query in Unreal world coordinates.
+	 * @param Radius - The maximum distance in Unreal units.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GRILL DIS|Game Manager|Spatial Queries")
+		TArray<AActor*> GetEntitiesInRadius(FVector Location, float Radius) const;
+	/**
+	 * Gets every registered entity inside the given box.
+	 * @param Box - The box in Unreal world coordinates.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GRILL DIS|Game Manager|Spatial Queries")
+		TArray<AActor*> GetEntitiesInBox(FBox Box) const;
+	/**
+	 * Gets the registered entities whose dead reckoned locations are closest to a location, closest first. Only entities with an actor are counted.
+	 * @param Location - The center of the query in Unreal world coordinates.
+	 * @param Count - The maximum number of entities to get.
+	 * @param MaxDistance - The maximum distance in Unreal units of the entities to get. Set to 0 for no limit.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GRILL DIS|Game Manager|Spatial Queries")
+		TArray<AActor*> GetNearestEntities(FVector Location, int32 Count, float MaxDistance = 0) const;
+
+	/**
+	 * Gets the DIS Entity IDs of every registered entity whose dead reckoned location is within the given distance of a location, including headless entities.
+	 * @param Location - The center of the query in Unreal world coordinates.
+	 * @param Radius - The maximum distance in Unreal units.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GRILL DIS|Game Manager|Spatial Queries")
+		TArray<FEntityID> GetEntityIDsInRadius(FVector Location, float Radius) const;
+
+	/**
+	 * Gets the most recent dead reckoned state of the given registered entity, including headless entities.
+	 * Returns whether or not the entity is registered.
+	 * @param EntityID - The DIS Entity ID of the entity.
+	 * @param EntityStatePDUOut - Set to the dead reckoned state of the entity.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GRILL DIS|Game Manager|Entity Table")
+		bool GetEntityState(FEntityID EntityID, FEntityStatePDU& EntityStatePDUOut) const;
+	/**
+	 * Gets the DIS Entity IDs of every registered entity, including headless entities.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GRILL DIS|Game Manager|Entity Table")
+		TArray<FEntityID> GetEntityIDs() const;
+	/**
+	 * Gets the number of registered entities, including headless entities.
+	 */
+	UFUNCTION(BlueprintPure, Category = "GRILL DIS|Game Manager|Entity Table")
+		int32 GetNumEntities() const
+	{
+		return EntityRegistry.Num();
+	}
+	/**
+	 * Gets whether or not the given entity is registered without an actor.
+	 * @param EntityID - The DIS Entity ID of the entity.
+	 */
+	UFUNCTION(BlueprintPure, Category = "GRILL DIS|Game Manager|Entity Table")
+		bool IsEntityHeadless(FEntityID EntityID) const;
+	/**
+	 * Spawns an actor for the given headless entity through the spawn queue, from its current dead reckoned state.
+	 * The actor takes over the entity's registry entry once it spawns, and the entity is then updated and timed out through its DIS Receive Component.
+	 * Returns whether or not the entity has an actor or is waiting to be spawned.
+	 * @param EntityID - The DIS Entity ID of the headless entity.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GRILL DIS|Game Manager|Entity Table")
+		bool MaterializeEntity(FEntityID EntityID);
+
+	/**
+	 * Gets whether or not the given entity is dormant. Dormant entities cannot move until their next PDU, so they are skipped by dead reckoning, ground clamping, and transform updates.
+	 * @param EntityID - The DIS Entity ID of the entity.
+	 */
+	UFUNCTION(BlueprintPure, Category = "GRILL DIS|Game Manager|Dead Reckoning")
+		bool IsEntityDormant(FEntityID EntityID) const;
+	/**
+	 * Wakes the given dormant entity so that its next update dead reckons, ground clamps, and applies its state again, e.g. after the terrain beneath it has changed.
+	 * The entity goes back to sleep after that update if its state still cannot move it. Returns whether or not the entity is registered.
+	 * @param EntityID - The DIS Entity ID of the entity.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GRILL DIS|Game Manager|Dead Reckoning")
+		bool WakeEntity(FEntityID EntityID);
+	/**
+	 * Gets the seconds between the valid time of the given DIS timestamp and now, which dead reckoning of the PDU starts from. Returns 0 if timestamp compensation is disabled.
+	 * @param SenderID - The DIS Entity ID of the entity the timestamp was received for.
+	 * @param Timestamp - The DIS timestamp of the PDU.
+	 */
+	float GetTimestampAge(const FEntityID& SenderID, uint32 Timestamp);
+
+	/**
+	 * Queues the owner of the given DIS Receive Component to be moved to the given pose when queued transforms are next applied. A later pose queued for the same entity replaces the earlier one.
+	 * @param DISComponent - The DIS Receive Component of the entity to move.
+	 * @param Location - The new Unreal location of the entity.
+	 * @param Rotation - The new Unreal rotation of the entity.
+	 */
+	void QueueEntityTransform(UDISReceiveComponent* DISComponent, const FVector& Location, const FRotator& Rotation);
+	/**
+	 * Moves every entity with a queued transform, skipping entities already within the transform tolerances of their queued pose.
+	 */
+	void ApplyQueuedEntityTransforms();
+
+	/**
+	 * Gets whether or not the given entity is currently drawn as an instanced mesh proxy instead of an actor.
+	 * @param EntityID - The DIS Entity ID of the entity.
+	 */
+	UFUNCTION(BlueprintPure, Category = "GRILL DIS|Game Manager|Proxies")
+		bool IsEntityProxy(FEntityID EntityID) const;
+	/**
+	 * Gets the number of entities currently drawn as instanced mesh proxies.
+	 */
+	UFUNCTION(BlueprintPure, Category = "GRILL DIS|Game Manager|Proxies")
+		int32 GetNumProxyEntities() const
+	{
+		return NumProxyEntities;
+	}
+
+	/**
+	 * Gets the most recently received state of the given registered entity, or null if it is not registered.
+	 * @param EntityID - The DIS Entity ID of the entity.
+	 */
+	const FDISEntityState* FindReceivedEntityState(const FEntityID& EntityID) const;
+	/**
+	 * Gets the most recent dead reckoned state of the given registered entity, or null if it is not registered.
+	 * @param EntityID - The DIS Entity ID of the entity.
+	 */
+	const FDISEntityState* FindDeadReckonedEntityState(const FEntityID& EntityID) const;
+
+	/**
+	 * Sets the largest PDU age in seconds that timestamp compensation dead reckons over.
+	 * @param MaxSeconds - The maximum age in seconds.
+	 */
+	UFUNCTION(BlueprintSetter)
+		void SetMaxTimestampCompensationSeconds(float MaxSeconds);
+	/**
+	 * Applies changes to DeadReckoningLODTiers. Called automatically at BeginPlay and when the tiers are edited in the editor.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GRILL DIS|Game Manager|Dead Reckoning")
+		void UpdateDeadReckoningLODSettings();
+	/**
+	 * Applies changes to the area of interest settings. Called automatically at BeginPlay.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GRILL DIS|Game Manager|Area of Interest")
+		void UpdateAreaOfInterest();
+	/**
+	 * Gets the lightweight records of the entities outside the area of interest.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GRILL DIS|Game Manager|Area of Interest")
+		TArray<FDISOutOfAreaEntity> GetOutOfAreaEntities() const;
+	/**
+	 * Gets the number of entities outside the area of interest that are kept as lightweight records.
+	 */
+	UFUNCTION(BlueprintPure, Category = "GRILL DIS|Game Manager|Area of Interest")
+		int32 GetNumOutOfAreaEntities() const;
+
+	static void AddReferencedObjects(UObject* InThis, FReferenceCollector& Collector);
+
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager",
 		Meta = (DisplayName = "DIS Enumeration Mapping", Tooltip = "The DIS Enumeration Mapping to use for this manager. This dictates the entity enumerations that will be recognized and managed by this DIS Game Manager."))
 		UDISClassEnumMappings* DISClassEnum;
@@ -177,23 +493,236 @@ public:
 
 protected:
 	virtual void BeginPlay() override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 	virtual void Tick(float DeltaTime) override;
+	virtual void RegisterActorTickFunctions(bool bRegister) override;
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
 
 	UFUNCTION()
 		void HandleOnDISEntityDestroyed(AActor* DestroyedActor);
 	
 	/**
-	 * The mapping between DIS Enumerations and corresponding entity classes.
+	 * Resolves received DIS Enumerations to entity classes, including wildcard mappings. Compiled from DISClassEnum at BeginPlay.
 	 */
-	UPROPERTY(BlueprintReadOnly, Category = "GRILL DIS|Game Manager")
-		TMap<FEntityType, TSoftClassPtr<AActor>> DISClassMappings;
-	std::map<FEntityType, TSoftClassPtr<AActor>> RawDISClassMappings;
+	FDISEntityTypeResolver EntityTypeResolver;
 	/**
-	 * The mapping between DIS Entity IDs and corresponding entity actors.
+	 * The DIS entities managed by this DIS Game Manager, keyed by DIS Entity ID.
 	 */
-	UPROPERTY(BlueprintReadOnly, Category = "GRILL DIS|Game Manager")
-		TMap<FEntityID, AActor*> DISActorMappings;
-	std::map<FEntityID, AActor*> RawDISActorMappings;
+	FDISEntityRegistry EntityRegistry;
+
+	/**
+	 * Whether or not entities whose dead reckoning cannot move them, such as static, frozen, and motionless entities, sleep after their state has been applied once.
+	 * Dormant entities cost nothing per frame until a new PDU is received for them or they are woken with WakeEntity.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Dead Reckoning")
+		bool EnableEntityDormancy = true;
+	/**
+	 * Whether or not dead reckoning starts from the valid time of each PDU given by its DIS timestamp, rather than from when it was received, to compensate network and processing latency.
+	 * Absolute timestamps are compared against the local UTC clock. Relative timestamps only compensate the latency above the lowest latency seen from their sender.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Dead Reckoning")
+		bool EnableTimestampCompensation = true;
+	/**
+	 * The largest PDU age in seconds that timestamp compensation dead reckons over. Older timestamps are assumed to come from an unsynchronized clock.
+	 */
+	UPROPERTY(BlueprintReadWrite, BlueprintSetter = SetMaxTimestampCompensationSeconds, EditAnywhere, Category = "GRILL DIS|Game Manager|Dead Reckoning", meta = (ClampMin = 0, UIMin = 0))
+		float MaxTimestampCompensationSeconds = 1.0f;
+	/**
+	 * Whether or not registered entities are drawn by interpolating between their recently received states a fixed delay behind the present, instead of dead reckoning ahead of them and smoothing.
+	 * Gives jitter free motion at a known latency. Entities fall back to dead reckoning from their newest state when no state newer than the delay has been received.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Dead Reckoning")
+		bool UseInterpolationBuffer = false;
+	/**
+	 * Seconds behind the present that entities are interpolated at when using the interpolation buffer. Should cover the longest expected gap between PDUs of an entity.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Dead Reckoning", meta = (EditCondition = "UseInterpolationBuffer", ClampMin = 0, UIMin = 0))
+		float InterpolationDelaySeconds = 0.1f;
+	/**
+	 * Whether or not to lower the dead reckoning, ground clamping, and transform update rate of entities far from every local player viewpoint.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Dead Reckoning")
+		bool EnableDeadReckoningLOD = false;
+	/**
+	 * The level of detail tiers entities are updated at, by distance from the closest local player viewpoint. Sorted by maximum distance when used.
+	 * Changes made at runtime take effect after calling UpdateDeadReckoningLODSettings.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Dead Reckoning", meta = (EditCondition = "EnableDeadReckoningLOD"))
+		TArray<FDISDeadReckoningLODTier> DeadReckoningLODTiers;
+	/**
+	 * Whether or not entity tiers are taken from the Significance Manager instead of from their distance to the local player viewpoints.
+	 * Entity actors are registered with the Significance Manager under the DISEntity tag. The project is responsible for updating the Significance Manager with its viewpoints each frame.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Dead Reckoning", meta = (EditCondition = "EnableDeadReckoningLOD"))
+		bool UseSignificanceManager = false;
+
+	/**
+	 * Whether or not only entities inside the area of interest should be spawned and updated.
+	 * Entity State and Entity State Update PDUs of other entities are dropped on the thread they are received on, before they are decoded, so they are not seen by any other PDU Processor listener either.
+	 * Network spawned entities that leave the area of interest are removed, and are spawned again when they return.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Area of Interest")
+		bool EnableAreaOfInterest = false;
+	/**
+	 * Whether or not entities outside the area of interest are kept as lightweight records of their ID, type, and location instead of being ignored outright.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Area of Interest", meta = (EditCondition = "EnableAreaOfInterest"))
+		bool TrackOutOfAreaEntities = true;
+	/**
+	 * The time in seconds without a PDU after which the record of an entity outside the area of interest is removed.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Area of Interest", meta = (EditCondition = "EnableAreaOfInterest && TrackOutOfAreaEntities", ClampMin = 0, UIMin = 0))
+		float OutOfAreaEntityTimeoutSeconds = 30.0f;
+	/**
+	 * Latitude/longitude polygons that are part of the area of interest.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Area of Interest", meta = (EditCondition = "EnableAreaOfInterest"))
+		TArray<FDISAreaOfInterestPolygon> AreaOfInterestPolygons;
+	/**
+	 * Altitude bands covering the whole globe that are part of the area of interest.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Area of Interest", meta = (EditCondition = "EnableAreaOfInterest"))
+		TArray<FDISAreaOfInterestAltitudeBand> AreaOfInterestAltitudeBands;
+	/**
+	 * The radius in meters of the sphere around each local player viewpoint that is part of the area of interest. Set to 0 for none.
+	 * If there are no polygons or altitude bands, entities are not filtered while there are no local player viewpoints, such as before the local players have spawned.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Area of Interest", meta = (EditCondition = "EnableAreaOfInterest", ClampMin = 0, UIMin = 0))
+		float AreaOfInterestViewpointRadius = 0;
+
+	/**
+	 * Whether or not entities are kept only as data in the entity registry instead of being spawned as actors.
+	 * Headless entities are updated directly from Entity State and Entity State Update PDUs, dead reckoned, spatially indexed, and timed out by this DIS Game Manager,
+	 * without an actor, DIS Receive Component, or per entity tick. Use Materialize Entity to spawn an actor for a headless entity on request.
+	 * Intended for data logging and gateway processes, such as dedicated servers, that only need to track world state.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Headless")
+		bool EnableHeadlessMode = false;
+	/**
+	 * Whether or not headless entities are dead reckoned between PDUs. When disabled, the dead reckoned state of headless entities is their most recently received state.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Headless", meta = (EditCondition = "EnableHeadlessMode"))
+		bool HeadlessDeadReckoning = true;
+	/**
+	 * The time in seconds without an Entity State PDU after which headless and proxy entities are removed. Overridden per Entity Type by Entity Type Timeout Seconds.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Headless", meta = (EditCondition = "EnableHeadlessMode", ClampMin = 0, UIMin = 0))
+		float HeadlessEntityTimeoutSeconds = 30.0f;
+
+	/**
+	 * Whether or not network entities far from every local player viewpoint are drawn as instances of the Proxy Mesh of their DIS Enumeration Mapping instead of as actors.
+	 * Proxy entities are kept in the entity registry without an actor, and are dead reckoned and timed out like headless entities. Their instance transforms are updated in batches from the dead reckoning pass.
+	 * Proxies are promoted to full actors of their mapped class when they come within the proxy distance, and actors are demoted back to proxies once they are beyond it by more than the hysteresis distance.
+	 * Entity types without a Proxy Mesh are always spawned as actors. Ignored in headless mode.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Proxies")
+		bool EnableProxyEntities = false;
+	/**
+	 * The distance in Unreal units from the closest local player viewpoint beyond which entities are drawn as proxies.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Proxies", meta = (EditCondition = "EnableProxyEntities", ClampMin = 0, UIMin = 0))
+		float ProxyDistance = 500000.0f;
+	/**
+	 * The additional distance in Unreal units beyond the proxy distance an actor must reach before it is demoted to a proxy. Keeps entities near the proxy distance from switching back and forth.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Proxies", meta = (EditCondition = "EnableProxyEntities", ClampMin = 0, UIMin = 0))
+		float ProxyHysteresisDistance = 50000.0f;
+	/**
+	 * Whether or not proxy entities are promoted to actors when a Fire or Detonation PDU names them as the firing or target entity.
+	 * The PDU that caused the promotion is not delivered to the new actor.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Proxies", meta = (EditCondition = "EnableProxyEntities"))
+		bool PromoteProxiesOnFireAndDetonation = true;
+
+	/**
+	 * Whether or not the transforms DIS Receive Components apply to their owners are queued and applied together in the Entity Transform Tick Group, instead of one actor at a time as each entity is updated.
+	 * Queued transforms teleport the owner and defer its child transform and overlap updates until the whole move is done.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Transforms")
+		bool BatchEntityTransforms = true;
+	/**
+	 * The tick group queued entity transforms are applied in. They are always applied after the DIS Game Manager has ticked. Only read when the DIS Game Manager's tick functions are registered.
+	 */
+	UPROPERTY(BlueprintReadOnly, EditAnywhere, Category = "GRILL DIS|Game Manager|Transforms", meta = (EditCondition = "BatchEntityTransforms"))
+		TEnumAsByte<ETickingGroup> EntityTransformTickGroup = TG_PrePhysics;
+	/**
+	 * The distance in Unreal units an entity must move before its queued transform is applied.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Transforms", meta = (EditCondition = "BatchEntityTransforms", ClampMin = 0, UIMin = 0))
+		float EntityTransformLocationTolerance = 0.1f;
+	/**
+	 * The angle in degrees an entity must rotate before its queued transform is applied.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Transforms", meta = (EditCondition = "BatchEntityTransforms", ClampMin = 0, UIMin = 0))
+		float EntityTransformRotationTolerance = 0.01f;
+	/**
+	 * Whether or not the primitive components of network spawned entity actors stop generating overlap events when the entity is added to the DIS Entity map, so that moving them skips overlap updates.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Transforms")
+		bool DisableEntityOverlapUpdates = true;
+
+	/**
+	 * Optional baked ground of the level. Entities are ground clamped by looking up their ground in it, and only trace where it has no data or the ground is flagged as dynamic.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Ground Clamping")
+		UDISTerrainHeightField* TerrainHeightField = nullptr;
+
+	/**
+	 * The edge length in meters of a cell of the entity spatial index. Should be on the order of the typical query radius.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Spatial Index", meta = (ClampMin = 1, UIMin = 1))
+		float SpatialIndexCellSizeMeters = 1000.0f;
+
+	/**
+	 * The time in seconds without an Entity State PDU after which entities of the given DIS Entity Types are removed. Fields set to -1 match any value.
+	 * An exact match is used first, then the Entity Type with its fields replaced by -1 one at a time from extra up to domain.
+	 * Entities whose type is not listed use the DIS Timeout Seconds of their DIS Receive Component, or the Headless Entity Timeout Seconds if they are headless.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Timeouts")
+		TMap<FEntityType, float> EntityTypeTimeoutSeconds;
+
+	/**
+	 * Whether or not the entity classes referenced by the DIS Enumeration Mapping should be loaded asynchronously.
+	 * When enabled, entities whose class is not loaded yet are queued and spawned once the class finishes loading. Entity State and Entity State Update PDUs received in the meantime are merged into the queued entity.
+	 * When disabled, entity classes are loaded synchronously when the first entity of that class is received.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Spawning")
+		bool LoadEntityClassesAsynchronously = true;
+	/**
+	 * The maximum number of entities to spawn each frame. New entities beyond this limit wait in the spawn queue for a later frame. Set to 0 for no limit.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Spawning", meta = (ClampMin = 0, UIMin = 0))
+		int32 MaxSpawnsPerFrame = 10;
+	/**
+	 * The time in milliseconds each frame may spend spawning entities. At least one entity is spawned each frame while any are waiting. Set to 0 for no limit.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Spawning", meta = (ClampMin = 0, UIMin = 0))
+		float SpawnBudgetMilliseconds = 5.0f;
+	/**
+	 * Whether or not to start asynchronously loading every entity class referenced by the DIS Enumeration Mapping at BeginPlay.
+	 * When disabled, entity classes are loaded the first time an entity of that class is received.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Spawning", meta = (EditCondition = "LoadEntityClassesAsynchronously"))
+		bool PreloadEntityClasses = true;
+
+	/**
+	 * Whether or not network spawned entity actors should be pooled. When enabled, actors of removed or timed out entities are hidden and disabled instead of destroyed,
+	 * and reused when a new entity of the same class appears. Actors can implement the DIS Poolable Interface to reset their own state on reuse.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Pooling")
+		bool EnableActorPooling = false;
+	/**
+	 * The maximum number of inactive actors kept in the pool of each entity class. Actors released while their pool is full are destroyed.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Pooling", meta = (EditCondition = "EnableActorPooling", ClampMin = 0, UIMin = 0))
+		int32 MaxPooledActorsPerClass = 64;
+	/**
+	 * The number of inactive actors to spawn into the pool of each entity class at BeginPlay.
+	 */
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Pooling", meta = (EditCondition = "EnableActorPooling"))
+		TMap<TSoftClassPtr<AActor>, int32> ActorPoolPrewarmCounts;
 
 	//Whether or not to auto connect receive sockets
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GRILL DIS|Game Manager|Networking")
@@ -212,7 +741,184 @@ protected:
 
 
 private:
-	void SpawnNewEntityFromEntityState(FEntityStatePDU EntityStatePDUIn);
+	/** An entity waiting in the spawn queue for its class to finish loading or for spawn budget. */
+	struct FPendingEntitySpawn
+	{
+		/** The class the entity will be spawned as. */
+		TSoftClassPtr<AActor> EntityClass;
+		/** The most recent state of the entity, merged from every Entity State and Entity State Update PDU received while waiting. */
+		FDISEntityState EntityState;
+		/** The spawn importance of the entity this frame. Higher values are spawned first. */
+		float SpawnImportance = 0;
+	};
+
+	/** A pose waiting to be applied to the owner of a DIS Receive Component by ApplyQueuedEntityTransforms. */
+	struct FQueuedEntityTransform
+	{
+		/** Null if the entity was removed after its transform was queued. */
+		TWeakObjectPtr<UDISReceiveComponent> DISComponent;
+		FVector Location;
+		FRotator Rotation;
+	};
+
+	/** Minimum number of spawn candidates before their importance is calculated across worker threads. */
+	static constexpr int32 MIN_PARALLEL_SPAWN_CANDIDATES = 64;
+
+	void SpawnNewEntityFromEntityState(const FEntityStatePDU& EntityStatePDUIn);
+	void SpawnEntityActor(UClass* EntityClass, const FEntityStatePDU& EntityStatePDUIn);
+	/**
+	 * Queues the given entity to be spawned, starting an asynchronous load of its class if needed and one is not already in progress.
+	 */
+	void QueuePendingEntitySpawn(const TSoftClassPtr<AActor>& EntityClass, const FEntityStatePDU& EntityStatePDUIn);
+	void HandleEntityClassLoaded(FSoftObjectPath EntityClassPath);
+	/**
+	 * Spawns the most important pending entities whose class is loaded, within the per frame spawn budget.
+	 */
+	void ProcessPendingEntitySpawns();
+	/**
+	 * Gets the Unreal locations of every local player viewpoint.
+	 */
+	void GetViewpointLocations(TArray<FVector, TInlineAllocator<4>>& ViewpointLocations) const;
+	/**
+	 * Gets the ECEF locations of every local player viewpoint.
+	 */
+	void GetViewpointECEFLocations(TArray<FVector, TInlineAllocator<4>>& ViewpointECEFLocations) const;
+	/**
+	 * Dead reckons every registered entity across worker threads, then applies the results to their DIS Receive Components on the game thread.
+	 */
+	void UpdateDeadReckoning(float DeltaTime);
+	void RegisterWithSignificanceManager(AActor* EntityActor, FDISEntityHandle EntityHandle);
+	void UnregisterFromSignificanceManager(AActor* EntityActor);
+	void PreloadMappedEntityClasses();
+	/**
+	 * Removes every registered entity whose timeout has expired.
+	 */
+	void ExpireEntityTimeouts();
+	/**
+	 * Gets the timeout in seconds for entities of the given type from EntityTypeTimeoutSeconds, or the given default if the type is not listed.
+	 */
+	float GetEntityTimeoutSeconds(const FEntityType& EntityType, float DefaultTimeoutSeconds) const;
+	/**
+	 * Removes the given network spawned entity if its new location is outside the area of interest, recording it if out of area entities are tracked.
+	 * Returns whether or not the entity was removed.
+	 */
+	bool RemoveIfOutsideAreaOfInterest(UDISReceiveComponent* DISComponent, const TArray<double>& ECEFLocation);
+	void SetAreaOfInterestPacketFilters(bool bEnabled);
+	/**
+	 * Registers the given entity without an actor and starts its timeout.
+	 * Returns the handle of the entity, which no longer resolves if the entity was removed right away for being deactivated or outside the area of interest.
+	 */
+	FDISEntityHandle AddHeadlessEntity(const FEntityStatePDU& EntityStatePDUIn, bool bPerformDeadReckoning);
+	/**
+	 * Restarts dead reckoning, the spatial index, and the timeout of the headless entity at the given dense index from its newly received state.
+	 * Removes the entity instead if it was deactivated or left the area of interest. Returns whether or not the entity is still registered.
+	 */
+	bool UpdateHeadlessEntity(int32 EntityIndex);
+	/** Removes the given headless entity along with any spawn requested for it. */
+	void RemoveHeadlessEntity(const FEntityID& EntityID);
+	/** Drops the transform queued for the owner of the given DIS Receive Component, if any. */
+	void CancelQueuedEntityTransform(UDISReceiveComponent* DISComponent);
+
+	/**
+	 * Registers the given new entity as a proxy if it is beyond the proxy distance and its type has a loaded proxy mesh.
+	 * Returns whether or not the entity was registered.
+	 */
+	bool AddProxyEntity(const FEntityStatePDU& EntityStatePDUIn);
+	/**
+	 * Promotes proxies that came within the proxy distance, demotes actors beyond it, and updates the instance transforms of proxies that were dead reckoned this frame.
+	 */
+	void UpdateProxyEntities();
+	/**
+	 * Gets the index of the proxy mesh batch for the given Entity Type, creating the batch once its mesh is loaded.
+	 * Returns INDEX_NONE if the type has no proxy mesh or its mesh is still loading, in which case bOutPending is set.
+	 */
+	int32 ResolveProxyMeshBatch(const FEntityType& EntityType, bool& bOutPending);
+	/** Gets the proxy mesh batch of the entity at the given dense index, resolving it the first time. Returns INDEX_NONE if the entity cannot be a proxy. */
+	int32 GetProxyMeshBatch(int32 EntityIndex);
+	/** Draws the headless entity at the given dense index as an instance of the given proxy mesh batch. */
+	void AcquireProxyInstance(int32 EntityIndex, int32 BatchIndex);
+	/** Stops drawing the entity at the given dense index as a proxy, if it is one. */
+	void ReleaseProxyInstance(int32 EntityIndex);
+	/** Gets the world transform of the proxy instance of the entity at the given dense index from its dead reckoned state. */
+	FTransform GetProxyInstanceTransform(int32 EntityIndex);
+	/** Releases the actor of the entity at the given dense index and draws the entity as a proxy instead, keeping its registry entry. */
+	void DemoteEntityToProxy(int32 EntityIndex, int32 BatchIndex);
+	/** Spawns an actor for the given entity if it is drawn as a proxy. */
+	void PromoteProxyEntity(const FEntityID& EntityID);
+	/** Returns the squared distance in meters from the given ECEF location to the closest local player viewpoint. */
+	double GetClosestProxyViewpointDistanceSquared(const double ECEFLocation[3]) const;
+	/** Converts the given Unreal world location to ECEF meters. Returns false if there is no GeoReferencing System. */
+	bool GetECEFLocation(const FVector& UnrealLocation, glm::dvec3& OutECEFLocation) const;
+	/** Appends the actors of the given registered entities to the given array. */
+	void GetEntityActors(TArrayView<const FDISEntityHandle> EntityHandles, TArray<AActor*>& OutActors) const;
+
+	/** Takes a valid inactive actor of the given class out of its pool. Returns null if the pool is empty. */
+	AActor* AcquirePooledActor(UClass* EntityClass);
+	void ReuseEntityActor(AActor* PooledActor, const FTransform& SpawnTransform, const FEntityStatePDU& EntityStatePDUIn);
+	static void DeactivatePooledActor(AActor* PooledActor);
+	void HandlePrewarmClassLoaded(FSoftObjectPath EntityClassPath, int32 Count);
+	void PrewarmConfiguredActorPools();
+
+	/** Inactive pooled actors, keyed by class. */
+	UPROPERTY(Transient)
+		TMap<UClass*, FDISActorPool> ActorPools;
+	/** Handles keeping the classes of prewarmed actor pools loaded. */
+	TArray<TSharedPtr<FStreamableHandle>> ActorPoolPrewarmLoadHandles;
+
 	UDISReceiveComponent* GetAssociatedDISComponent(FEntityID EntityIDIn);
 	AGeoReferencingSystem* GeoReferencingSystem;
+
+	/** Significance Manager tag entity actors are registered under. */
+	static const FName SIGNIFICANCE_TAG;
+	FDISDeadReckoningLODSettings DeadReckoningLODSettings;
+
+	/** Timeouts of the registered entities. Refreshed with a single store per received entity state. */
+	FDISTimingWheel EntityTimeouts;
+	FDISTimestampClock TimestampClock;
+	//Scratch array reused by ExpireEntityTimeouts every frame
+	TArray<FDISEntityHandle> ExpiredEntityHandles;
+	//Scratch array reused by UpdateDeadReckoning every frame
+	TArray<FDISEntityHandle> DeadReckonedEntityHandles;
+	/** Dead reckoned locations of the registered entities. */
+	FDISSpatialIndex EntitySpatialIndex;
+	/** Instanced mesh proxies, one batch per proxy mesh. Indexed by FDISProxyInstance::BatchIndex. */
+	UPROPERTY(Transient)
+		TArray<FDISProxyMeshBatch> ProxyMeshBatches;
+	/** Actor owning the proxy mesh components. The DIS Game Manager is hidden, so it cannot own them itself. */
+	UPROPERTY(Transient)
+		AActor* ProxyMeshActor = nullptr;
+	/** Proxy mesh batch index keyed by proxy mesh path. INDEX_NONE marks a mesh that failed to load. */
+	TMap<FSoftObjectPath, int32> ProxyMeshBatchIndices;
+	/** Handles keeping the proxy meshes loaded, keyed by proxy mesh path. */
+	TMap<FSoftObjectPath, TSharedPtr<FStreamableHandle>> ProxyMeshLoadHandles;
+	/** ECEF locations of the local player viewpoints, refreshed every frame while proxies are enabled. */
+	TArray<FVector, TInlineAllocator<4>> ProxyViewpointECEFLocations;
+	int32 NumProxyEntities = 0;
+	//Scratch data reused by UpdateProxyEntities every frame
+	TArray<FEntityID> ProxyEntitiesToPromote;
+	TArray<FEntityID> ProxyEntitiesToDemote;
+	FEntityStatePDU ProxyEntityStatePDU;
+
+	/** Transforms waiting to be applied by EntityTransformTickFunction. Indexed by UDISReceiveComponent::QueuedTransformIndex. */
+	TArray<FQueuedEntityTransform> QueuedEntityTransforms;
+	FDISEntityTransformTickFunction EntityTransformTickFunction;
+
+	/** Shared with the PDU Processor's packet filters, which run on the receive threads. Null while the area of interest is disabled. */
+	TSharedPtr<FDISAreaOfInterest, ESPMode::ThreadSafe> AreaOfInterest;
+	float TimeSinceOutOfAreaEntitiesPruned = 0;
+
+	FStreamableManager StreamableManager;
+	/** Handles keeping the requested entity classes loaded, keyed by class path. */
+	TMap<FSoftObjectPath, TSharedPtr<FStreamableHandle>> EntityClassLoadHandles;
+	/** Entity classes that failed to load. Entities of these classes are not queued again. */
+	TSet<FSoftObjectPath> FailedEntityClassLoads;
+	/** Entities waiting to be spawned, keyed by DIS Entity ID. */
+	TMap<FEntityID, FPendingEntitySpawn> PendingEntitySpawns;
+	//Scratch arrays reused by ProcessPendingEntitySpawns every frame
+	TArray<FPendingEntitySpawn*> SpawnCandidates;
+	TArray<FEntityID> SpawnOrder;
+
+	//Blueprint view of the entity registry, rebuilt lazily when dirty
+	mutable TMap<FEntityID, AActor*> CachedDISActorMappings;
+	mutable bool bDISActorMappingsDirty = true;
 };
\ No newline at end of file
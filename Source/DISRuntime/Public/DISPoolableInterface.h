@@ -0,0 +1,38 @@
+// Copyright 2022 Gaming Research Integration for Learning Lab. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Interface.h"
+#include "DISPoolableInterface.generated.h"
+
+/**
+ * Optional interface for DIS entity actors that are pooled by the DIS Game Manager.
+ * Pooled actors are hidden and disabled instead of destroyed when their entity is removed, and reused when a new entity of the same class appears.
+ * Implement this interface to reset any state that should not carry over between entities.
+ */
+UINTERFACE(BlueprintType)
+class DISRUNTIME_API UDISPoolableInterface : public UInterface
+{
+	GENERATED_BODY()
+};
+
+class DISRUNTIME_API IDISPoolableInterface
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * Called when the actor is taken out of the pool to represent a new entity.
+	 * The DIS Receive Component has already been reset and set up with the entity's first Entity State PDU.
+	 */
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "GRILL DIS|DIS Poolable Interface")
+		void OnAcquiredFromPool();
+
+	/**
+	 * Called when the actor's entity is removed and the actor is returned to the pool.
+	 * The actor has already been hidden and had its collision and ticking disabled.
+	 */
+	UFUNCTION(BlueprintNativeEvent, BlueprintCallable, Category = "GRILL DIS|DIS Poolable Interface")
+		void OnReleasedToPool();
+};
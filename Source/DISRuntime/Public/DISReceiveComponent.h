@@ -6,9 +6,15 @@
 #include "Components/ActorComponent.h"
 #include "DISEnumsAndStructs.h"
 #include "PDUMasterInclude.h"
+#include "DISEntityState.h"
+#include "DISEntityRegistry.h"
 #include "GeoReferencingSystem.h"
+#include "WorldCollision.h"
 #include "DISReceiveComponent.generated.h"
 
+//Forward declarations
+class ADISGameManager;
+
 DECLARE_LOG_CATEGORY_EXTERN(LogDISReceiveComponent, Log, All);
 
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FReceivedEntityStatePDU, FEntityStatePDU, EntityStatePDU);
@@ -21,6 +27,23 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FReceivedStopFreezePDU, FStopFreezeP
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FReceivedStartResumePDU, FStartResumePDU, StartResumePDU);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FReceivedElectromagneticEmissionsPDU, FElectromagneticEmissionsPDU, ElectromagneticEmissionsPDU);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FGroundClampingUpdate, TArray<FTransform>, ClampTransforms);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FEntityAppearanceChanged, FEntityAppearance, EntityAppearance);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FArticulationParametersChanged, TArray<FArticulationParameters>, ArticulationParameters);
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FEntityTypeChanged, FEntityType, EntityType);
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FReceivedEntityStatePDUNative, const FEntityStatePDU&);
+DECLARE_MULTICAST_DELEGATE_OneParam(FDeadReckoningUpdateNative, const FEntityStatePDU&);
+DECLARE_MULTICAST_DELEGATE_OneParam(FReceivedEntityStateUpdatePDUNative, const FEntityStateUpdatePDU&);
+DECLARE_MULTICAST_DELEGATE_OneParam(FReceivedDetonationPDUNative, const FDetonationPDU&);
+DECLARE_MULTICAST_DELEGATE_OneParam(FReceivedFirePDUNative, const FFirePDU&);
+DECLARE_MULTICAST_DELEGATE_OneParam(FReceivedRemoveEntityPDUNative, const FRemoveEntityPDU&);
+DECLARE_MULTICAST_DELEGATE_OneParam(FReceivedStopFreezePDUNative, const FStopFreezePDU&);
+DECLARE_MULTICAST_DELEGATE_OneParam(FReceivedStartResumePDUNative, const FStartResumePDU&);
+DECLARE_MULTICAST_DELEGATE_OneParam(FReceivedElectromagneticEmissionsPDUNative, const FElectromagneticEmissionsPDU&);
+DECLARE_MULTICAST_DELEGATE_OneParam(FGroundClampingUpdateNative, const TArray<FTransform>&);
+DECLARE_MULTICAST_DELEGATE_OneParam(FEntityAppearanceChangedNative, const FEntityAppearance&);
+DECLARE_MULTICAST_DELEGATE_OneParam(FArticulationParametersChangedNative, const TArray<FArticulationParameters>&);
+DECLARE_MULTICAST_DELEGATE_OneParam(FEntityTypeChangedNative, const FEntityType&);
 
 DECLARE_STATS_GROUP(TEXT("GRILLDIS_Game"), STATGROUP_DISComponent, STATCAT_Advanced);
 DECLARE_CYCLE_STAT(TEXT("DoDeadReckoning"), STAT_DoDeadReckoning, STATGROUP_DISComponent);
@@ -54,19 +77,63 @@ public:
 	virtual void TickComponent(float DeltaTime, ELevelTick TickType, FActorComponentTickFunction* ThisTickFunction) override;
 	virtual void InitializeComponent() override;
 
-	void HandleEntityStatePDU(FEntityStatePDU NewEntityStatePDU);
-	void HandleEntityStateUpdatePDU(FEntityStateUpdatePDU NewEntityStateUpdatePDU);
-	void HandleFirePDU(FFirePDU FirePDUIn);
-	void HandleDetonationPDU(FDetonationPDU DetonationPDUIn);
-	void HandleRemoveEntityPDU(FRemoveEntityPDU RemoveEntityPDUIn);
-	void HandleStopFreezePDU(FStopFreezePDU StopFreezePDUIn);
-	void HandleStartResumePDU(FStartResumePDU StartResumePDUIn);
-	void HandleElectromagneticEmissionsPDU(FElectromagneticEmissionsPDU ElectromagneticEmissionsPDUIn);
+	void HandleEntityStatePDU(const FEntityStatePDU& NewEntityStatePDU);
+	void HandleEntityStateUpdatePDU(const FEntityStateUpdatePDU& NewEntityStateUpdatePDU);
+	void HandleFirePDU(const FFirePDU& FirePDUIn);
+	void HandleDetonationPDU(const FDetonationPDU& DetonationPDUIn);
+	void HandleRemoveEntityPDU(const FRemoveEntityPDU& RemoveEntityPDUIn);
+	void HandleStopFreezePDU(const FStopFreezePDU& StopFreezePDUIn);
+	void HandleStartResumePDU(const FStartResumePDU& StartResumePDUIn);
+	void HandleElectromagneticEmissionsPDU(const FElectromagneticEmissionsPDU& ElectromagneticEmissionsPDUIn);
 	void DoDeadReckoning(float DeltaTime);
+	/**
+	 * Writes the inputs the DIS Game Manager needs to dead reckon this entity outside of the component.
+	 * @param OutReceivedEntityState - Set to the most recently received entity state.
+	 * @param OutDeadReckonedEntityState - Set to the most recent dead reckoned entity state.
+	 * @param OutParameters - Set to the dead reckoning settings and smoothing state of this component.
+	 */
+	void WriteDeadReckoningState(FDISEntityState& OutReceivedEntityState, FDISEntityState& OutDeadReckonedEntityState, FDISDeadReckoningParameters& OutParameters) const;
+	/**
+	 * Applies a dead reckoning update calculated by the DIS Game Manager. Must be called on the game thread.
+	 * Dead reckoning events are only broadcast if something is bound to them.
+	 * @param DeadReckonedEntityState - The newly dead reckoned entity state.
+	 * @param Parameters - The dead reckoning parameters the update was calculated with.
+	 */
+	void ApplyDeadReckoningUpdate(const FDISEntityState& DeadReckonedEntityState, const FDISDeadReckoningParameters& Parameters);
+	/** Returns whether or not an asynchronous ground clamping trace was requested and its result has not been picked up yet. */
+	bool IsGroundClampPending() const
+	{
+		return GroundClampTraceHandle.IsValid();
+	}
+	/** Returns whether or not anything is bound to the native or Blueprint dead reckoning update events. */
+	bool HasDeadReckoningUpdateListeners() const
+	{
+		return OnDeadReckoningUpdateNative.IsBound() || OnDeadReckoningUpdate.IsBound();
+	}
+
+	/**
+	 * Removes the associated entity from the sim. The owner is returned to the DIS Game Manager's actor pool if it was spawned from one, otherwise it is destroyed.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GRILL DIS|DIS Receive Component")
+		void RemoveEntity();
+	/**
+	 * Resets the component so that a pooled owner can represent a new entity, then sets it up from the entity's first Entity State PDU.
+	 * Called by the DIS Game Manager when an actor is taken out of its actor pool.
+	 * @param InitialEntityStatePDU - The first Entity State PDU received for the new entity.
+	 */
+	void ResetForReuse(const FEntityStatePDU& InitialEntityStatePDU);
+	/**
+	 * Stops the component from updating or timing out the entity. Called by the DIS Game Manager when the owner is returned to its actor pool.
+	 */
+	void PrepareForPool();
+	/**
+	 * Removes the entity after it has not received an Entity State PDU within its timeout. Called by the DIS Game Manager when the entity's timeout expires.
+	 */
+	void HandleEntityTimedOut();
 
 	/**
 	 * Clamps an entity to the ground. Should call OnGroundClampingUpdate event when finished.
-	 * Returns whether or not ground clamping was attempted.
+	 * Returns whether or not ground clamping applies to this entity. When it does, the entity is placed by ground clamping, or where it would be without ground clamping if no ground has been found.
 	 */
 	UFUNCTION(BlueprintNativeEvent, Category = "GRILL DIS|DIS Receive Component")
 		bool GroundClamping();
@@ -133,6 +200,42 @@ public:
 	 */
 	UPROPERTY(BlueprintAssignable, Category = "GRILL DIS|DIS Receive Component|Event")
 		FGroundClampingUpdate OnGroundClampingUpdate;
+	/**
+	 * Called when an Entity State or Entity State Update PDU changes the raw bits of the entity's appearance. Not called for the first state of the entity.
+	 * Called before the event for the received PDU. Passes the new appearance as a parameter.
+	 */
+	UPROPERTY(BlueprintAssignable, Category = "GRILL DIS|DIS Receive Component|Event")
+		FEntityAppearanceChanged OnEntityAppearanceChanged;
+	/**
+	 * Called when an Entity State or Entity State Update PDU changes the entity's articulation parameters. Not called for the first state of the entity.
+	 * Called before the event for the received PDU. Passes the new articulation parameters as a parameter.
+	 */
+	UPROPERTY(BlueprintAssignable, Category = "GRILL DIS|DIS Receive Component|Event")
+		FArticulationParametersChanged OnArticulationParametersChanged;
+	/**
+	 * Called when an Entity State PDU changes the entity's type or alternative type. Not called for the first state of the entity.
+	 * Called before the event for the received PDU. Passes the new entity type as a parameter.
+	 */
+	UPROPERTY(BlueprintAssignable, Category = "GRILL DIS|DIS Receive Component|Event")
+		FEntityTypeChanged OnEntityTypeChanged;
+
+	/*
+	 * Native versions of the above events. Handlers receive their parameters by const reference and are called before any Blueprint handlers.
+	 * Blueprint events are only broadcast if they are bound. C++ code should prefer binding to these events.
+	 */
+	FDeadReckoningUpdateNative OnDeadReckoningUpdateNative;
+	FReceivedEntityStatePDUNative OnReceivedEntityStatePDUNative;
+	FReceivedEntityStateUpdatePDUNative OnReceivedEntityStateUpdatePDUNative;
+	FReceivedDetonationPDUNative OnReceivedDetonationPDUNative;
+	FReceivedFirePDUNative OnReceivedFirePDUNative;
+	FReceivedRemoveEntityPDUNative OnReceivedRemoveEntityPDUNative;
+	FReceivedStopFreezePDUNative OnReceivedStopFreezePDUNative;
+	FReceivedStartResumePDUNative OnReceivedStartResumePDUNative;
+	FReceivedElectromagneticEmissionsPDUNative OnReceivedElectromagneticEmissionsPDUNative;
+	FGroundClampingUpdateNative OnGroundClampingUpdateNative;
+	FEntityAppearanceChangedNative OnEntityAppearanceChangedNative;
+	FArticulationParametersChangedNative OnArticulationParametersChangedNative;
+	FEntityTypeChangedNative OnEntityTypeChangedNative;
 
 	/**
 	 * The most recent Entity State PDU that has been received.
@@ -167,6 +270,22 @@ public:
 	 */
 	UPROPERTY(BlueprintReadOnly, Category = "GRILL DIS|DIS Receive Component|DIS Info")
 		FEntityID EntityID;
+	/**
+	 * Handle of this entity in the DIS Game Manager's entity registry. Set by the DIS Game Manager when the entity is added to its entity map.
+	 */
+	FDISEntityHandle EntityHandle;
+	/**
+	 * The DIS Game Manager this entity is registered with. Set by the DIS Game Manager when the entity is added to its entity map.
+	 */
+	TWeakObjectPtr<ADISGameManager> OwningDISGameManager;
+	/**
+	 * Index of this entity's transform in the DIS Game Manager's queue of transforms to apply, or INDEX_NONE if none is queued.
+	 */
+	int32 QueuedTransformIndex = INDEX_NONE;
+	/**
+	 * Whether or not the owner was spawned into the DIS Game Manager's actor pool. Pooled owners are returned to the pool instead of being destroyed when the entity is removed.
+	 */
+	bool bPooledActor = false;
 	/**
 	 * The Force ID of the associated entity. Specifies the team or side the DIS entity is on.
 	 */
@@ -181,6 +300,7 @@ public:
 
 	/**
 	 * The time to live for the entity. Gets reset every time a new Entity State PDU is received by the sim.
+	 * Overridden by the DIS Game Manager's Entity Type Timeout Seconds when the entity's type is listed there.
 	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GRILL DIS|DIS Receive Component|DIS Settings")
 		float DISTimeoutSeconds = 30.0f;
@@ -220,6 +340,22 @@ public:
 	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GRILL DIS|DIS Receive Component|DIS Settings")
 		TEnumAsByte<ETraceTypeQuery> GoundClampingCollisionChannel = UEngineTypes::ConvertToTraceType(ECollisionChannel::ECC_Visibility);
+	/**
+	 * The distance in Unreal units above and below the entity that ground clamping searches for the ground.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GRILL DIS|DIS Receive Component|DIS Settings", meta = (ClampMin = 0, UIMin = 0))
+		float GroundClampingTraceDistance = 100000.0f;
+	/**
+	 * Whether or not ground clamping traces run asynchronously with the rest of the frame's traces, with their result picked up on the next frame.
+	 * Until the first result arrives the entity is placed at its dead reckoned location. Only used while the entity is dead reckoned.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GRILL DIS|DIS Receive Component|DIS Settings")
+		bool AsyncGroundClamping = true;
+	/**
+	 * The distance in Unreal units the entity can move from where the ground was last traced before it is traced again. In between, the entity follows the plane of the ground found by the last trace.
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "GRILL DIS|DIS Receive Component|DIS Settings", meta = (EditCondition = "AsyncGroundClamping", ClampMin = 0, UIMin = 0))
+		float GroundClampingReuseDistance = 100.0f;
 	/**
 	 * To automatically apply entity states to the owner actor.
 	 */
@@ -231,14 +367,75 @@ protected:
 	virtual void BeginPlay() override;
 
 private:
-	TArray<double> EntityECEFLocationDifference;
+	//Compact copies of the most recent and dead reckoned entity states used for per frame dead reckoning
+	FDISEntityState MostRecentEntityState;
+	FDISEntityState MostRecentDeadReckonedEntityState;
+	/** Dead reckoning of the most recent entity state, precomputed whenever a new state is received. */
+	FDISDeadReckoningKernel DeadReckoningKernel;
+
+	double EntityECEFLocationDifference[3] = { 0, 0, 0 };
 	FRotator EntityRotationDifference;
 	AGeoReferencingSystem* GeoReferencingSystem;
 
 	float DeltaTimeSinceLastPDU = 0;
 	int NumberEntityStatePDUsReceived = 0;
 
-	void UpdateCommonEntityStateInfo(FEntityStatePDU NewEntityStatePDU);
-	FEntityStatePDU SmoothDeadReckoning(FEntityStatePDU DeadReckonPDUToSmooth);
+	//Asynchronous ground clamping state
+	FTraceHandle GroundClampTraceHandle;
+	/** Where the most recent ground clamping trace was requested from, and the up vector it was traced along. */
+	FVector GroundClampTraceLocation = FVector::ZeroVector;
+	FVector GroundClampUpVector = FVector::UpVector;
+	/** The ground found by the most recent completed trace. Only meaningful if bHasGroundClamp is set. */
+	FVector GroundClampHitLocation = FVector::ZeroVector;
+	FVector GroundClampNormal = FVector::UpVector;
+	bool bGroundClampTraced = false;
+	bool bHasGroundClamp = false;
+
+	void ApplyInitialEntityState(const FEntityStatePDU& InitialEntityStatePDU, bool bSpawnedFromNetwork);
+	/** Returns the FDISEntityState CHANGED_ flags of the sections of the entity's state changed by the given PDU. */
+	uint8 UpdateCommonEntityStateInfo(const FEntityStatePDU& NewEntityStatePDU);
+	/** Returns the FDISEntityState CHANGED_ flags of the sections of the entity's state changed by the given PDU. */
+	uint8 UpdateCommonEntityStateInfo(const FEntityStateUpdatePDU& NewEntityStateUpdatePDU);
+	/**
+	 * Restarts dead reckoning, smoothing, and the timeout from MostRecentEntityState once a newly received PDU has been applied to it.
+	 * Returns the given changes, or none for the entity's first state.
+	 * @param StateChanges - The FDISEntityState CHANGED_ flags of the sections changed by the PDU.
+	 */
+	uint8 ApplyReceivedEntityState(uint8 StateChanges);
+	/**
+	 * Broadcasts the change events of the given sections of the entity's state.
+	 * @param StateChanges - The FDISEntityState CHANGED_ flags of the sections that changed.
+	 */
+	void BroadcastEntityStateChanges(uint8 StateChanges);
+	void ResetTimeout();
+	void SmoothDeadReckoning(FDISEntityState& DeadReckonedStateToSmooth);
+	/** Gets the local up vector at the most recent dead reckoned location. */
+	FVector GetGroundClampingUpVector() const;
+	/**
+	 * Clamps the owner to the ground through an asynchronous trace, picking up the result of the previous frame's trace and requesting a new one once the entity has moved far enough.
+	 * Returns whether or not the owner was clamped.
+	 */
+	bool UpdateAsyncGroundClamp(const FVector& ActorLocation);
+	/** Moves the owner to the given ground location, aligned with the given ground normal, and broadcasts the clamp transform. */
+	void ApplyGroundClamp(const FVector& ClampLocation, const FVector& GroundNormal);
+	/** Forgets the ground found by earlier traces and any trace still in flight. */
+	void ResetGroundClamp();
 	void ApplyToOwnerIfActivated(FEntityStatePDU const& StatePDU);
+	/**
+	 * Moves the owner to the given pose, through the DIS Game Manager's transform batch if it has one enabled.
+	 */
+	void SetOwnerLocationAndRotation(const FVector& NewLocation, const FRotator& NewRotation);
+
+	/**
+	 * Broadcasts the given parameter on the native event, then on the Blueprint event if anything is bound to it.
+	 */
+	template<typename NativeEventType, typename EventType, typename ParamType>
+	static void BroadcastEvent(NativeEventType& NativeEvent, EventType& Event, const ParamType& Param)
+	{
+		NativeEvent.Broadcast(Param);
+		if (Event.IsBound())
+		{
+			Event.Broadcast(Param);
+		}
+	}
 };
\ No newline at end of file
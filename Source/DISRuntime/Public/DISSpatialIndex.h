@@ -0,0 +1,127 @@
+// Copyright 2022 Gaming Research Integration for Learning Lab. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DISEntityRegistry.h"
+#include "glm/vec3.hpp"
+
+/**
+ * Uniform hash grid of entity locations in ECEF meters, keyed by entity handle.
+ * Moving an entity within its cell only stores the new location. Moving it across cells swaps it out of the old cell and appends it to the new one.
+ * Queries visit the cells overlapping the query region and test the exact location of every entity in them, so results are exact regardless of the cell size.
+ * The cell size should be on the order of the typical query radius.
+ */
+class DISRUNTIME_API FDISSpatialIndex
+{
+public:
+	/**
+	 * @param CellSizeMetersIn - The edge length of a grid cell in meters.
+	 */
+	explicit FDISSpatialIndex(double CellSizeMetersIn = 1000.0);
+
+	/**
+	 * Sets the edge length of a grid cell and rebuilds the grid from the indexed locations.
+	 * @param CellSizeMetersIn - The edge length of a grid cell in meters.
+	 */
+	void SetCellSize(double CellSizeMetersIn);
+	double GetCellSize() const
+	{
+		return CellSizeMeters;
+	}
+
+	/**
+	 * Adds the given entity to the index, or moves it if it is already indexed.
+	 * @param Handle - The handle of the entity.
+	 * @param ECEFLocation - The location of the entity in ECEF meters.
+	 */
+	void Update(FDISEntityHandle Handle, const glm::dvec3& ECEFLocation);
+	/**
+	 * Removes the given entity from the index.
+	 * @param Handle - The handle of the entity.
+	 */
+	void Remove(FDISEntityHandle Handle);
+	/** Removes every entity from the index. */
+	void Reset();
+
+	/**
+	 * Gets every entity within the given distance of a location.
+	 * @param ECEFCenter - The center of the query in ECEF meters.
+	 * @param RadiusMeters - The maximum distance in meters.
+	 * @param OutHandles - Appended with the handles of the entities found, in no particular order.
+	 */
+	void QueryRadius(const glm::dvec3& ECEFCenter, double RadiusMeters, TArray<FDISEntityHandle>& OutHandles) const;
+	/**
+	 * Gets every entity inside the given axis aligned box.
+	 * @param ECEFMin - The minimum corner of the box in ECEF meters.
+	 * @param ECEFMax - The maximum corner of the box in ECEF meters.
+	 * @param OutHandles - Appended with the handles of the entities found, in no particular order.
+	 */
+	void QueryBox(const glm::dvec3& ECEFMin, const glm::dvec3& ECEFMax, TArray<FDISEntityHandle>& OutHandles) const;
+	/**
+	 * Gets the entities closest to a location.
+	 * @param ECEFCenter - The center of the query in ECEF meters.
+	 * @param Count - The maximum number of entities to get.
+	 * @param MaxDistanceMeters - The maximum distance in meters of the entities to get. Set to 0 for no limit.
+	 * @param OutHandles - Appended with the handles of the entities found, closest first.
+	 */
+	void QueryNearest(const glm::dvec3& ECEFCenter, int32 Count, double MaxDistanceMeters, TArray<FDISEntityHandle>& OutHandles) const;
+	/**
+	 * Gets the entities closest to a location that pass the given filter. Entities rejected by the filter do not count towards the number of entities to get.
+	 * @param ECEFCenter - The center of the query in ECEF meters.
+	 * @param Count - The maximum number of entities to get.
+	 * @param MaxDistanceMeters - The maximum distance in meters of the entities to get. Set to 0 for no limit.
+	 * @param Filter - Returns whether or not the entity with the given handle can be part of the result. Only called for entities within the search distance.
+	 * @param OutHandles - Appended with the handles of the entities found, closest first.
+	 */
+	void QueryNearest(const glm::dvec3& ECEFCenter, int32 Count, double MaxDistanceMeters, TFunctionRef<bool(FDISEntityHandle)> Filter, TArray<FDISEntityHandle>& OutHandles) const;
+
+	/**
+	 * Gets the indexed location of the given entity. Returns whether or not the entity is indexed.
+	 * @param Handle - The handle of the entity.
+	 * @param OutECEFLocation - Set to the location of the entity in ECEF meters.
+	 */
+	bool GetLocation(FDISEntityHandle Handle, glm::dvec3& OutECEFLocation) const;
+
+	/** Returns the number of indexed entities. */
+	int32 Num() const
+	{
+		return NumIndexed;
+	}
+
+private:
+	/** Number of bits of each packed cell coordinate. Cells further out than this wrap around, which only costs extra distance tests. */
+	static constexpr int32 CELL_COORDINATE_BITS = 21;
+
+	/** Indexed location of a single entity, indexed by FDISEntityHandle::Index. */
+	struct FEntry
+	{
+		glm::dvec3 Location = glm::dvec3(0);
+		FIntVector Cell = FIntVector::ZeroValue;
+		int32 IndexInCell = INDEX_NONE;
+		uint32 Generation = 0;
+		bool bIndexed = false;
+	};
+
+	FIntVector GetCell(const glm::dvec3& Location) const;
+	static uint64 GetCellKey(const FIntVector& Cell);
+	FDISEntityHandle GetHandle(int32 EntryIndex) const
+	{
+		return FDISEntityHandle(EntryIndex, Entries[EntryIndex].Generation);
+	}
+	void AddToCell(int32 EntryIndex);
+	void RemoveFromCell(int32 EntryIndex);
+
+	/**
+	 * Calls the given function with the index of every entry in the cells overlapping the given cell range.
+	 * Walks the occupied cells instead of the range when the range holds more cells than are occupied.
+	 */
+	template<typename FunctionType>
+	void ForEachEntryInCells(const FIntVector& MinCell, const FIntVector& MaxCell, FunctionType Function) const;
+
+	double CellSizeMeters;
+	int32 NumIndexed;
+	TArray<FEntry> Entries;
+	/** Indices into Entries of the entities in each occupied cell, keyed by packed cell coordinates. */
+	TMap<uint64, TArray<int32>> Cells;
+};
@@ -0,0 +1,110 @@
+// Copyright 2022 Gaming Research Integration for Learning Lab. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DataAsset.h"
+#include "Engine/EngineTypes.h"
+#include "DISTerrainHeightField.generated.h"
+
+/**
+ * A square block of height field samples. Neighboring tiles share their edge samples so that every bilinear lookup reads a single tile.
+ */
+USTRUCT()
+struct DISRUNTIME_API FDISTerrainHeightFieldTile
+{
+	GENERATED_BODY()
+
+	/** Ground height in Unreal units of each sample, row by row. Empty if no sample of the tile hit static terrain. */
+	UPROPERTY()
+		TArray<float> Heights;
+	/** Ground normal of each sample, with its X and Y components quantized into the high and low bytes. */
+	UPROPERTY()
+		TArray<uint16> PackedNormals;
+	/** Combination of the UDISTerrainHeightField SAMPLE_ flags of each sample. */
+	UPROPERTY()
+		TArray<uint8> SampleFlags;
+};
+
+/**
+ * Height and normal of the ground of a level, baked from its collision onto a regular grid in Unreal world space.
+ * Lets ground clamping replace a trace with a bilinear lookup wherever the terrain is static. Samples where nothing was hit, or where the ground hit
+ * was not static terrain such as bridges and buildings, are flagged so that ground clamping traces there instead.
+ * Heights are measured along the Unreal Z axis, so the level's terrain should be modeled with Z up. Baked in the editor from the asset's context menu.
+ */
+UCLASS(BlueprintType)
+class DISRUNTIME_API UDISTerrainHeightField : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/** Nothing was hit at the sample. */
+	static constexpr uint8 SAMPLE_MISSING = 1 << 0;
+	/** The ground hit at the sample can move or is not terrain, so it must be traced at runtime. */
+	static constexpr uint8 SAMPLE_DYNAMIC = 1 << 1;
+
+	/**
+	 * Gets the height and normal of the ground below the given location by bilinear interpolation of the surrounding samples.
+	 * Returns false if the location is outside the height field, or if any surrounding sample is missing or dynamic.
+	 * @param Location - The Unreal world location to look up. Only X and Y are used.
+	 * @param OutHeight - Set to the Unreal Z coordinate of the ground.
+	 * @param OutNormal - Set to the normal of the ground.
+	 */
+	bool SampleGround(const FVector& Location, float& OutHeight, FVector& OutNormal) const;
+
+	/** Returns whether or not the height field has been baked. */
+	bool HasData() const
+	{
+		return Tiles.Num() > 0 && Tiles.Num() == NumTiles.X * NumTiles.Y;
+	}
+
+	static uint16 PackNormal(const FVector& Normal);
+	static FVector UnpackNormal(uint16 PackedNormal);
+
+	/**
+	 * The region of the level to bake, in Unreal world space. Ground is searched for from the top of the box down to its bottom.
+	 */
+	UPROPERTY(EditAnywhere, Category = "GRILL DIS|Terrain Height Field|Bake")
+		FBox BakeBounds = FBox(FVector(-100000.0f), FVector(100000.0f));
+	/**
+	 * The distance in Unreal units between neighboring samples.
+	 */
+	UPROPERTY(EditAnywhere, Category = "GRILL DIS|Terrain Height Field|Bake", meta = (ClampMin = 1, UIMin = 1))
+		float BakeSampleSpacing = 100.0f;
+	/**
+	 * The number of sample intervals along each edge of a tile.
+	 */
+	UPROPERTY(EditAnywhere, Category = "GRILL DIS|Terrain Height Field|Bake", meta = (ClampMin = 1, UIMin = 1))
+		int32 BakeTileSamples = 64;
+	/**
+	 * The collision channel the ground is traced on while baking. Should match the ground clamping collision channel of the entities.
+	 */
+	UPROPERTY(EditAnywhere, Category = "GRILL DIS|Terrain Height Field|Bake")
+		TEnumAsByte<ETraceTypeQuery> BakeTraceChannel = UEngineTypes::ConvertToTraceType(ECollisionChannel::ECC_Visibility);
+	/**
+	 * Whether or not only landscapes count as static terrain. Other static geometry, such as bridges and buildings, is flagged as dynamic.
+	 */
+	UPROPERTY(EditAnywhere, Category = "GRILL DIS|Terrain Height Field|Bake")
+		bool OnlyLandscapeIsTerrain = true;
+	/**
+	 * Ground whose actor or component has this tag is flagged as dynamic.
+	 */
+	UPROPERTY(EditAnywhere, Category = "GRILL DIS|Terrain Height Field|Bake")
+		FName DynamicGroundTag = TEXT("DISDynamicGround");
+
+	/** Unreal world X and Y of the first sample. */
+	UPROPERTY(VisibleAnywhere, Category = "GRILL DIS|Terrain Height Field|Baked")
+		FVector2D Origin = FVector2D::ZeroVector;
+	/** The distance in Unreal units between neighboring samples. */
+	UPROPERTY(VisibleAnywhere, Category = "GRILL DIS|Terrain Height Field|Baked")
+		float SampleSpacing = 100.0f;
+	/** The number of sample intervals along each edge of a tile. Each tile holds one more sample than this along each edge. */
+	UPROPERTY(VisibleAnywhere, Category = "GRILL DIS|Terrain Height Field|Baked")
+		int32 TileSamples = 64;
+	/** The number of tiles along X and Y. */
+	UPROPERTY(VisibleAnywhere, Category = "GRILL DIS|Terrain Height Field|Baked")
+		FIntPoint NumTiles = FIntPoint::ZeroValue;
+	/** The tiles, row by row. */
+	UPROPERTY()
+		TArray<FDISTerrainHeightFieldTile> Tiles;
+};
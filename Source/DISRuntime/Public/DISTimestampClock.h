@@ -0,0 +1,81 @@
+// Copyright 2022 Gaming Research Integration for Learning Lab. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DISEnumsAndStructs.h"
+
+/**
+ * Converts DIS timestamps into the age of the state they carry on the local monotonic clock, so that dead reckoning can start from a PDU's own valid time instead of its receipt.
+ * Absolute timestamps are compared against the local UTC time. Relative timestamps, and absolute timestamps from clocks that disagree with the local one, are compared
+ * through a per sender clock offset. The offset tracks the smallest delay seen from the sender, so relative timestamps compensate the delay and queueing above it.
+ * Timestamps of zero are treated as unset.
+ */
+class DISRUNTIME_API FDISTimestampClock
+{
+public:
+	FDISTimestampClock();
+
+	/**
+	 * Returns the seconds between the valid time of the given timestamp and now, clamped to the maximum age. Updates the clock offset of the timestamp's sender.
+	 * @param SenderID - The ID of an entity of the sender. Senders are told apart by site and application.
+	 * @param Timestamp - The DIS timestamp of the PDU.
+	 */
+	float GetTimestampAge(const FEntityID& SenderID, uint32 Timestamp);
+
+	/**
+	 * Sets the largest age that is compensated. Larger ages are treated as clock jumps and resynchronize the sender.
+	 * @param MaxAgeSecondsIn - The maximum age in seconds.
+	 */
+	void SetMaxAge(float MaxAgeSecondsIn)
+	{
+		MaxAgeSeconds = FMath::Max(MaxAgeSecondsIn, 0.0f);
+	}
+
+	/** Forgets the clock offsets of every sender. */
+	void Reset()
+	{
+		SenderClocks.Reset();
+	}
+
+	static bool IsAbsolute(uint32 Timestamp)
+	{
+		return (Timestamp & 1) != 0;
+	}
+	/** Returns the time past the hour in seconds held by the given timestamp. */
+	static double GetSecondsPastHour(uint32 Timestamp)
+	{
+		return (Timestamp >> 1) * SECONDS_PER_TIMESTAMP_UNIT;
+	}
+	/**
+	 * Makes an absolute timestamp from the given UTC time.
+	 * @param UTCTime - The UTC time the timestamp is valid at.
+	 */
+	static uint32 MakeAbsoluteTimestamp(const FDateTime& UTCTime);
+
+private:
+	/** Seconds per unit of the 31 bit time past the hour. */
+	static constexpr double SECONDS_PER_TIMESTAMP_UNIT = 3600.0 / 2147483648.0;
+	/** Seconds per second the smallest delay of a sender is allowed to grow by, following clock drift and route changes. */
+	static constexpr double CLOCK_DRIFT_RATE = 0.001;
+
+	struct FSenderClock
+	{
+		/** Local monotonic time minus the sender's time past the hour, at the smallest delay seen. */
+		double Offset = 0;
+		/** Local monotonic time of the sender's most recent timestamp. */
+		double LastUpdateTime = 0;
+	};
+
+	/** Wraps a difference of times past the hour into half an hour either side of zero. */
+	static double WrapSeconds(double Seconds);
+	double GetUTCSecondsPastHour(double MonotonicTime) const;
+	float GetRelativeTimestampAge(const FEntityID& SenderID, double SecondsPastHour, double MonotonicTime);
+
+	/** The local UTC time past the hour and the monotonic time it was taken at, relating the two clocks. */
+	double UTCSecondsPastHourAtStart;
+	double MonotonicTimeAtStart;
+	float MaxAgeSeconds = 1.0f;
+	/** Clock offsets keyed by site and application. */
+	TMap<uint32, FSenderClock> SenderClocks;
+};
@@ -0,0 +1,98 @@
+// Copyright 2022 Gaming Research Integration for Learning Lab. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "DISEntityRegistry.h"
+
+/**
+ * Hierarchical timing wheel of entity timeouts, keyed by entity handle.
+ * Refreshing a timeout only stores the new deadline. Entries stay in the slot of their original deadline and are moved to the slot
+ * of their current deadline when that slot comes around, so frequent refreshes never touch the wheel. Advancing the wheel costs
+ * the number of ticks elapsed plus the number of entries expired or moved.
+ */
+class DISRUNTIME_API FDISTimingWheel
+{
+public:
+	/**
+	 * @param TickSecondsIn - The resolution of the wheel in seconds. Timeouts expire up to one tick late.
+	 */
+	explicit FDISTimingWheel(double TickSecondsIn = 0.1);
+
+	/**
+	 * Starts or restarts the timeout of the given entity.
+	 * @param Handle - The handle of the entity.
+	 * @param CurrentTime - The current time in seconds.
+	 * @param TimeoutSeconds - The time in seconds without a refresh after which the entity times out.
+	 */
+	void Schedule(FDISEntityHandle Handle, double CurrentTime, float TimeoutSeconds);
+	/**
+	 * Pushes the timeout of the given entity back by its timeout. Does nothing if the entity has no timeout scheduled.
+	 * Returns whether or not the entity has a timeout scheduled.
+	 * @param Handle - The handle of the entity.
+	 * @param CurrentTime - The current time in seconds.
+	 */
+	bool Refresh(FDISEntityHandle Handle, double CurrentTime);
+	/**
+	 * Cancels the timeout of the given entity.
+	 * @param Handle - The handle of the entity.
+	 */
+	void Cancel(FDISEntityHandle Handle);
+	/** Cancels every timeout. */
+	void Reset();
+
+	/**
+	 * Advances the wheel to the given time and collects the entities that timed out.
+	 * @param CurrentTime - The current time in seconds.
+	 * @param OutExpiredHandles - Appended with the handles of the entities that timed out.
+	 */
+	void Advance(double CurrentTime, TArray<FDISEntityHandle>& OutExpiredHandles);
+
+	/** Returns the number of entities with a timeout scheduled. */
+	int32 Num() const
+	{
+		return NumScheduled;
+	}
+
+private:
+	/** Number of bits of the tick used to index the slots of each level. */
+	static constexpr int32 SLOT_BITS = 6;
+	static constexpr int32 SLOTS_PER_LEVEL = 1 << SLOT_BITS;
+	static constexpr uint64 SLOT_MASK = SLOTS_PER_LEVEL - 1;
+	/** Number of levels. With 0.1 second ticks the wheel spans over 19 days. */
+	static constexpr int32 NUMBER_OF_LEVELS = 4;
+
+	/** Timeout of a single entity, indexed by FDISEntityHandle::Index. */
+	struct FTimer
+	{
+		double Deadline = 0;
+		float TimeoutSeconds = 0;
+		uint32 Generation = 0;
+		/** Incremented whenever the timer is placed into the wheel, so that entries left behind by a cancel or reschedule are ignored. */
+		uint32 ScheduleID = 0;
+		bool bScheduled = false;
+	};
+
+	/** Entry in a wheel slot. */
+	struct FSlotEntry
+	{
+		int32 TimerIndex;
+		uint32 ScheduleID;
+	};
+
+	void Insert(int32 TimerIndex);
+	/** Moves every entry in the given slot to the slot of its current deadline, or expires it if its deadline has passed. */
+	void ProcessSlot(TArray<FSlotEntry>& Slot, double CurrentTime, TArray<FDISEntityHandle>& OutExpiredHandles);
+	uint64 ToTick(double Time) const
+	{
+		return Time <= 0 ? 0 : static_cast<uint64>(Time / TickSeconds);
+	}
+
+	double TickSeconds;
+	uint64 CurrentTick;
+	int32 NumScheduled;
+	TArray<FTimer> Timers;
+	TArray<FSlotEntry> Slots[NUMBER_OF_LEVELS][SLOTS_PER_LEVEL];
+	//Scratch slot swapped in while a slot is processed, since processing can insert back into the same slot
+	TArray<FSlotEntry> ProcessingSlot;
+};
@@ -344,7 +344,7 @@ public:
 	 * @param UnrealRotation The rotation of the entity in Unreal
 	 */
 	UFUNCTION(BlueprintPure, Category = "GRILL DIS|Unit Conversions")
-		static void GetUnrealRotationFromEntityStatePdu(const FEntityStatePDU EntityStatePdu, AGeoReferencingSystem* GeoReferencingSystem, FRotator& UnrealRotation);
+		static void GetUnrealRotationFromEntityStatePdu(const FEntityStatePDU& EntityStatePdu, AGeoReferencingSystem* GeoReferencingSystem, FRotator& UnrealRotation);
 
 	/**
 	 * Gets the Unreal X, Y, Z coordinates of the entity from the given ECEF values in the DIS entity state pdu. Values returned change depending on if GeoReferencing Subsystem is set to Flat Earth or Round Earth.
@@ -353,7 +353,7 @@ public:
 	 * @param UnrealLocation The resulting Unreal XYZ location of the entity in Unreal units
 	 */
 	UFUNCTION(BlueprintPure, Category = "GRILL DIS|Unit Conversions")
-		static void GetUnrealLocationFromEntityStatePdu(const FEntityStatePDU EntityStatePdu, AGeoReferencingSystem* GeoReferencingSystem, FVector& UnrealLocation);
+		static void GetUnrealLocationFromEntityStatePdu(const FEntityStatePDU& EntityStatePdu, AGeoReferencingSystem* GeoReferencingSystem, FVector& UnrealLocation);
 
 	/**
 	 * Gets the Unreal X, Y, Z coordinates and rotation from a DIS entity state PDU. Location values returned change depending on if GeoReferencing Subsystem is set to Flat Earth or Round Earth.
@@ -363,7 +363,7 @@ public:
 	 * @param UnrealRotation The rotation of the entity in Unreal
 	 */
 	UFUNCTION(BlueprintPure, Category = "GRILL DIS|Unit Conversions")
-		static void GetUnrealLocationAndOrientationFromEntityStatePdu(const FEntityStatePDU EntityStatePdu, AGeoReferencingSystem* GeoReferencingSystem, FVector& UnrealLocation, FRotator& UnrealRotation);
+		static void GetUnrealLocationAndOrientationFromEntityStatePdu(const FEntityStatePDU& EntityStatePdu, AGeoReferencingSystem* GeoReferencingSystem, FVector& UnrealLocation, FRotator& UnrealRotation);
 
 	/**
 	 * Gets the North, East, and Down vector representation of the given Unreal location
@@ -7,6 +7,7 @@
 #include "DISEnumsAndStructs.h"
 #include "PDUMasterInclude.h"
 #include "DIS_BPFL.h"
+#include "DISEntityState.h"
 #include "glm/gtx/quaternion.hpp"
 #include "DeadReckoning_BPFL.generated.h"
 
@@ -28,7 +29,15 @@ public:
 	 * @param DeadReckonedEntityPDU The resulting dead reckoned EntityStatePDU that contains all of the dead reckoning information.
 	*/
 	UFUNCTION(BlueprintPure, Category = "GRILL DIS|Dead Reckoning")
-		static bool DeadReckoning(FEntityStatePDU EntityPDUToDeadReckon, float DeltaTime, FEntityStatePDU& DeadReckonedEntityPDU);
+		static bool DeadReckoning(const FEntityStatePDU& EntityPDUToDeadReckon, float DeltaTime, FEntityStatePDU& DeadReckonedEntityPDU);
+
+	/**
+	 * Performs dead reckoning on the given entity state. Native counterpart of DeadReckoning that does not allocate.
+	 * @param EntityStateToDeadReckon The entity state to perform dead reckoning on.
+	 * @param DeltaTime The time elapsed in seconds that dead reckoning should be calculated for.
+	 * @param DeadReckonedEntityState The resulting dead reckoned entity state. Must not be the same object as EntityStateToDeadReckon.
+	*/
+	static bool DeadReckonEntityState(const FDISEntityState& EntityStateToDeadReckon, float DeltaTime, FDISEntityState& DeadReckonedEntityState);
 
 	/**
 	 * Forms the Other Parameters section utilized in Dead Reckoning Parameters.
@@ -70,6 +79,7 @@ public:
 	static FQuat GetEntityOrientationQuaternion(double PsiRadians, double ThetaRadians, double PhiRadians);
 
 private:
+	friend struct FDISDeadReckoningKernel;
 
 	static const double MIN_ROTATION_RATE;
 
@@ -79,65 +89,36 @@ private:
 	static bool IsMachineLittleEndian();
 
 	/**
-	 * Calculates the Psi, Theta, Phi orientation for the entity from the given orientation quaternion. Utilized as a final step in converting quaternion OtherParameters to an orientation.
-	 * @param AngularVelocityVector The angular velocity of the entity
+	 * Calculates the Psi, Theta, Phi orientation in radians from the given orientation quaternion. Utilized as a final step in converting quaternion OtherParameters to an orientation.
 	 * @param EntityRotationQuaternion The orientation quaternion to use to calculate the Psi, Theta, Phi orientation
-	 * @param DeltaTime The time increment for dead reckoning calculation
 	*/
-	static FRotator CalculateDeadReckonedEulerAnglesFromQuaternion(glm::dvec3 AngularVelocityVector, FQuat EntityRotationQuaternion, float DeltaTime);
+	static FRotator ConvertQuaternionToPsiThetaPhiRadians(const FQuat& EntityRotationQuaternion);
+
+	/**
+	 * Calculates the Psi, Theta, Phi orientation in radians from the given orientation matrix.
+	 * @param OrientationMatrix The orientation matrix of the entity
+	 */
+	static FRotator ConvertOrientationMatrixToPsiThetaPhiRadians(const glm::dmat3& OrientationMatrix);
 
 	/**
 	 * Gets the local yaw, pitch, and roll from the other parameters structure. The yaw, pitch, and roll act on the entity's local North, East, Down vectors.
 	 * @param OtherDeadReckoningParameters The 120 bits sent as part of the dead reckoning parameters marked as other parameters sent as an array of bytes
 	 * @param LocalRotator The local yaw, pitch, and roll of the entity in radians. Yaw is the heading from true north, positive to the right. Pitch is the elevation angle above or below the local horizon, positive up. Roll is the bank angle from the local horizontal, positive tile to the right.
 	 */
-	static bool GetLocalEulerAngles(TArray<uint8> OtherDeadReckoningParameters, FRotator& LocalRotator);
+	static bool GetLocalEulerAngles(TArrayView<const uint8> OtherDeadReckoningParameters, FRotator& LocalRotator);
 
 	/**
 	 * Gets the local entity orientation as a quaternion from the dead reckoning other parameters
 	 * @param OtherDeadReckoningParameters The 120 bits sent as part of the dead reckoning parameters marked as other parameters sent as an array of bytes
 	 * @param EntityOrientation The four-valued unit quaternion that represents the entity's orientation
 	 */
-	static bool GetLocalQuaternionAngles(TArray<uint8> OtherDeadReckoningParameters, FQuat& EntityOrientation);
-
-	/**
-	 * Calculates the new position vector using the given velocity, acceleration, and time increment
-	 * @param PositionVector The initial position of the entity in world coordinates
-	 * @param VelocityVector The initial velocity in world coordinates
-	 * @param AccelerationVector The initial acceleration in world coordinates
-	 * @param DeltaTime The time increment for dead reckoning calculation
-	 */
-	static glm::dvec3 CalculateDeadReckonedPosition(glm::dvec3 PositionVector, glm::dvec3 VelocityVector, glm::dvec3 AccelerationVector, double DeltaTime);
-
-	/**
-	 * Calculates the new position vector using the given velocity, acceleration, and time increment given in body coordinates
-	 * @param InitialPositionVector The initial position of the entity in body coordinates
-	 * @param BodyVelocityVector The initial velocity in body coordinates
-	 * @param BodyLinearAccelerationVector The initial linear acceleration in body coordinates
-	 * @param BodyAngularVelocityVector The initial angular acceleration in body coordinates
-	 * @param EntityOrientation The orientation of the entity (Psi[Yaw]/Theta[Pitch]/Phi[Roll]) in radians
-	 * @param DeltaTime The time increment for dead reckoning calculation
-	 */
-	static glm::dvec3 GetEntityBodyDeadReckonedPosition(glm::dvec3 InitialPositionVector, glm::dvec3 BodyVelocityVector, glm::dvec3 BodyLinearAccelerationVector, glm::dvec3 BodyAngularVelocityVector, glm::dvec3 EntityOrientation, double DeltaTime);
-
-	/**
-	 * Calculates the new orientation vector using the given velocity, acceleration, and time increment
-	 * @param PsiRadians The rotation about the Z axis in radians
-	 * @param ThetaRadians The rotation about the Y axis in radians
-	 * @param PhiRadians The rotation about the X axis in radians
-	 * @param AngularVelocityVector The angular velocity vector in body coordinates
-	 * @param DeltaTime The time increment for dead reckoning calculation
-	 * @param OutPsiRadians The rotation about the Z axis in radians after time step DeltaTime
-	 * @param OutThetaRadians The rotation about the Y axis in radians after time step DeltaTime
-	 * @param OutPhiRadians The rotation about the X axis in radians after time step DeltaTime
-	 */
-	static void CalculateDeadReckonedOrientation(double PsiRadians, double ThetaRadians, double PhiRadians, glm::dvec3 AngularVelocityVector, float DeltaTime, double& OutPsiRadians, double& OutThetaRadians, double& OutPhiRadians);
+	static bool GetLocalQuaternionAngles(TArrayView<const uint8> OtherDeadReckoningParameters, FQuat& EntityOrientation);
 
 	/**
 	 * Converts the given local heading, pitch, roll rotator in radians into world space psi, theta, phi rotator in radians.
-	 * @param EntityPDUToDeadReckon The entity PDU being dead reckoned.
+	 * @param EntityECEFLocation The ECEF location of the entity being dead reckoned.
 	 * @param LocalRotatorRadians The local heading, pitch, roll rotator in radians
 	 * @param PsiThetaPhiRadians The world space psi, theta, phi rotator in radians
 	*/
-	static void ConvertLocalRotatorToPsiThetaPhiRadians(FEntityStatePDU EntityPDUToDeadReckon, FRotator LocalRotatorRadians, FPsiThetaPhi& PsiThetaPhiRadians);
+	static void ConvertLocalRotatorToPsiThetaPhiRadians(const double EntityECEFLocation[3], FRotator LocalRotatorRadians, FPsiThetaPhi& PsiThetaPhiRadians);
 };
@@ -20,9 +20,75 @@ DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FStartResumePDUProcessed, FStartResu
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FStopFreezePDUProcessed, FStopFreezePDU, StopFreezePDU);
 DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FElectromagneticEmissionsPDUProcessed, FElectromagneticEmissionsPDU, ElectromagneticEmissionsPDU);
 
+DECLARE_MULTICAST_DELEGATE_OneParam(FEntityStatePDUProcessedNative, const FEntityStatePDU&);
+DECLARE_MULTICAST_DELEGATE_OneParam(FEntityStateUpdatePDUProcessedNative, const FEntityStateUpdatePDU&);
+DECLARE_MULTICAST_DELEGATE_OneParam(FDetonationPDUProcessedNative, const FDetonationPDU&);
+DECLARE_MULTICAST_DELEGATE_OneParam(FFirePDUProcessedNative, const FFirePDU&);
+DECLARE_MULTICAST_DELEGATE_OneParam(FRemoveEntityPDUProcessedNative, const FRemoveEntityPDU&);
+DECLARE_MULTICAST_DELEGATE_OneParam(FStartResumePDUProcessedNative, const FStartResumePDU&);
+DECLARE_MULTICAST_DELEGATE_OneParam(FStopFreezePDUProcessedNative, const FStopFreezePDU&);
+DECLARE_MULTICAST_DELEGATE_OneParam(FElectromagneticEmissionsPDUProcessedNative, const FElectromagneticEmissionsPDU&);
+
 DECLARE_STATS_GROUP(TEXT("PDUProcessor_Game"), STATGROUP_PDUProcessor, STATCAT_Advanced);
 DECLARE_CYCLE_STAT(TEXT("ProcessDISPacket"), STAT_ProcessDISPacket, STATGROUP_PDUProcessor);
 
+/**
+ * Describes how a single PDU type gets validated, decoded, and dispatched by the PDU Processor.
+ * Built in PDU types are registered automatically. Projects can register decoders for additional PDU types through UPDUProcessor::RegisterPDUDecoder.
+ */
+struct FPDUDecoder
+{
+	/** Friendly name of the PDU type. Used for logging. */
+	FString Name;
+	/** Returns whether or not the given packet is a valid length for this PDU type. Packets that fail validation are counted and ignored. */
+	TFunction<bool(const TArray<uint8>& InData)> Validate;
+	/** Unmarshals the given packet and dispatches the resulting PDU to any listeners. The stream is reused between packets and should not be read after the PDU has been dispatched. */
+	TFunction<void(const TArray<uint8>& InData, DIS::DataStream& InStream)> Decode;
+	/** Returns whether or not anything is listening for this PDU type. Packets without listeners are counted and dropped without being decoded. */
+	TFunction<bool()> HasListeners;
+	/** Whether or not packets of this PDU type should be decoded. */
+	bool bEnabled = true;
+};
+
+/**
+ * Returns whether or not the given packet should be decoded. Called on the thread the packet was received on, after the packet passes length validation and before it is decoded,
+ * so it must be thread safe. Packets that are filtered out are counted and dropped for every listener of the PDU Processor.
+ */
+using FPDUPacketFilter = TFunction<bool(const TArray<uint8>& InData)>;
+
+USTRUCT(BlueprintType)
+struct FPDUTypeStatistics
+{
+	GENERATED_BODY()
+
+	/** Number of packets received of this PDU type. */
+	UPROPERTY(BlueprintReadOnly, Category = "GRILL DIS|PDU Processor|Structs")
+		int64 ReceivedCount = 0;
+	/** Number of packets of this PDU type that were decoded and dispatched. */
+	UPROPERTY(BlueprintReadOnly, Category = "GRILL DIS|PDU Processor|Structs")
+		int64 DecodedCount = 0;
+	/** Number of packets dropped after the header peek because nothing was listening for this PDU type. */
+	UPROPERTY(BlueprintReadOnly, Category = "GRILL DIS|PDU Processor|Structs")
+		int64 DroppedNoListenersCount = 0;
+	/** Number of packets dropped because decoding of this PDU type is disabled. */
+	UPROPERTY(BlueprintReadOnly, Category = "GRILL DIS|PDU Processor|Structs")
+		int64 DroppedDisabledCount = 0;
+	/** Number of packets dropped because no decoder is registered for this PDU type. */
+	UPROPERTY(BlueprintReadOnly, Category = "GRILL DIS|PDU Processor|Structs")
+		int64 DroppedUnsupportedCount = 0;
+	/** Number of packets dropped because they failed length validation. */
+	UPROPERTY(BlueprintReadOnly, Category = "GRILL DIS|PDU Processor|Structs")
+		int64 InvalidCount = 0;
+	/** Number of packets dropped by the packet filter set for this PDU type. */
+	UPROPERTY(BlueprintReadOnly, Category = "GRILL DIS|PDU Processor|Structs")
+		int64 DroppedFilteredCount = 0;
+	/** Total time in seconds spent decoding and dispatching packets of this PDU type. */
+	double TotalDecodeSeconds = 0;
+	/** Average time in microseconds spent decoding and dispatching a single packet of this PDU type. */
+	UPROPERTY(BlueprintReadOnly, Category = "GRILL DIS|PDU Processor|Structs")
+		float AverageDecodeMicroseconds = 0.f;
+};
+
 UCLASS()
 class DISRUNTIME_API UPDUProcessor : public UGameInstanceSubsystem
 {
@@ -34,12 +100,74 @@ public:
 	virtual void Deinitialize() override;
 	// End USubsystem
 
+	/**
+	 * Sets up the decoder and statistics tables and registers the built in PDU decoders. Called by Initialize.
+	 * Lets packets be processed without a game instance or UDP Subsystem, such as in automation tests.
+	 */
+	void InitializePDUDecoders();
+
 	/**
 	 * Processes a given DIS packet to determine the type of packet. Delegates handling of the packet to whatever is bound to the associated PDU type's OnPDUProcessed event.
 	 * @param InData - The DIS packet in bytes to process.
 	 */
 	UFUNCTION(BlueprintCallable, Category = "GRILL DIS|PDU Processor")
 		void ProcessDISPacket(const TArray<uint8>& InData);
+
+	/**
+	 * Registers a decoder for the given PDU type. Replaces any decoder that was previously registered for the type.
+	 * Allows projects to add support for additional PDU types (such as Transmitter or Designator PDUs) without modifying the PDU Processor.
+	 * @param PDUType - The PDU type the decoder handles.
+	 * @param Decoder - The decoder to use for the PDU type.
+	 */
+	void RegisterPDUDecoder(EPDUType PDUType, FPDUDecoder Decoder);
+	/**
+	 * Removes the decoder registered for the given PDU type.
+	 * Returns whether or not a decoder was removed.
+	 * @param PDUType - The PDU type to remove the decoder of.
+	 */
+	bool UnregisterPDUDecoder(EPDUType PDUType);
+	/**
+	 * Sets the filter that decides which packets of the given PDU type are decoded. Replaces any filter that was previously set for the type.
+	 * @param PDUType - The PDU type to filter.
+	 * @param Filter - The filter to use for the PDU type. Pass an unset function to remove the filter.
+	 */
+	void SetPDUPacketFilter(EPDUType PDUType, FPDUPacketFilter Filter);
+
+	/**
+	 * Sets whether or not packets of the given PDU type should be decoded. Disabled PDU types are counted and dropped after the header is read.
+	 * @param PDUType - The PDU type to enable or disable.
+	 * @param bEnabled - Whether or not the PDU type should be decoded.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GRILL DIS|PDU Processor")
+		void SetPDUTypeEnabled(EPDUType PDUType, bool bEnabled);
+	/**
+	 * Returns whether or not packets of the given PDU type are decoded.
+	 * @param PDUType - The PDU type to check.
+	 */
+	UFUNCTION(BlueprintPure, Category = "GRILL DIS|PDU Processor")
+		bool IsPDUTypeEnabled(EPDUType PDUType) const;
+	/**
+	 * Returns whether or not a decoder is registered for the given PDU type.
+	 * @param PDUType - The PDU type to check.
+	 */
+	UFUNCTION(BlueprintPure, Category = "GRILL DIS|PDU Processor")
+		bool HasPDUDecoder(EPDUType PDUType) const;
+	/**
+	 * Gets the receive, drop, and decode cost statistics gathered for the given PDU type.
+	 * @param PDUType - The PDU type to get statistics for.
+	 */
+	UFUNCTION(BlueprintPure, Category = "GRILL DIS|PDU Processor")
+		FPDUTypeStatistics GetPDUTypeStatistics(EPDUType PDUType) const;
+	/**
+	 * Resets the statistics gathered for all PDU types.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GRILL DIS|PDU Processor")
+		void ResetPDUTypeStatistics();
+	/**
+	 * Logs the statistics gathered for every PDU type that has been received.
+	 */
+	UFUNCTION(BlueprintCallable, Category = "GRILL DIS|PDU Processor")
+		void LogPDUTypeStatistics() const;
 	
 	/**
 	 * Called after an Entity State PDU is processed.
@@ -90,6 +218,19 @@ public:
 	UPROPERTY(BlueprintAssignable, Category = "GRILL DIS|PDU Processor|Events")
 		FElectromagneticEmissionsPDUProcessed OnElectromagneticEmissionsPDUProcessed;
 
+	/*
+	 * Native versions of the above events. Handlers receive the processed PDU by const reference and are called before any Blueprint handlers.
+	 * The PDU is only copied into the Blueprint events if they are bound. C++ code should prefer binding to these events.
+	 */
+	FEntityStatePDUProcessedNative OnEntityStatePDUProcessedNative;
+	FEntityStateUpdatePDUProcessedNative OnEntityStateUpdatePDUProcessedNative;
+	FDetonationPDUProcessedNative OnDetonationPDUProcessedNative;
+	FFirePDUProcessedNative OnFirePDUProcessedNative;
+	FRemoveEntityPDUProcessedNative OnRemoveEntityPDUProcessedNative;
+	FStartResumePDUProcessedNative OnStartResumePDUProcessedNative;
+	FStopFreezePDUProcessedNative OnStopFreezePDUProcessedNative;
+	FElectromagneticEmissionsPDUProcessedNative OnElectromagneticEmissionsPDUProcessedNative;
+
 protected:
 	UFUNCTION()
 		void HandleOnReceivedUDPBytes(const TArray<uint8>& Bytes, const FString& IPAddress);
@@ -105,6 +246,7 @@ protected:
 
 		/**
 		* Checks that the Electromagnetic Emission PDU with the given info is a valid byte length according to the DIS standard.
+		* Never reads past the end of the given data, so it is safe to call with truncated or malformed packets.
 		* Returns whether or not the given Electromagnetic Emission PDU is a valid byte length.
 		* @param InData - The Electromagnetic Emission PDU data
 		*/
@@ -112,8 +254,64 @@ protected:
 		bool CheckElectromagneticEmissionPDUProperLength(const TArray<uint8>& InData);
 
 private:
+	/**
+	 * Registers a decoder for one of the built in PDU types that unmarshals the packet through OpenDIS and broadcasts the resulting PDU on the given event.
+	 */
+	template<typename OpenDISPDUType, typename PDUStructType, typename EventType, typename NativeEventType>
+	void RegisterDefaultPDUDecoder(EPDUType PDUType, const FString& Name, EventType& OnPDUProcessed, NativeEventType& OnPDUProcessedNative, TFunction<bool(const TArray<uint8>&)> Validate)
+	{
+		FPDUDecoder Decoder;
+		Decoder.Name = Name;
+		Decoder.Validate = MoveTemp(Validate);
+		Decoder.HasListeners = [&OnPDUProcessed, &OnPDUProcessedNative]() { return OnPDUProcessedNative.IsBound() || OnPDUProcessed.IsBound(); };
+		Decoder.Decode = [&OnPDUProcessed, &OnPDUProcessedNative](const TArray<uint8>& InData, DIS::DataStream& InStream)
+		{
+			//Reuse the OpenDIS PDU between packets so its vectors keep their capacity. It is not touched after SetupFromOpenDIS, so listeners that process packets of their own are safe.
+			static thread_local OpenDISPDUType ReceivedPDU;
+			ReceivedPDU.unmarshal(InStream);
+
+			PDUStructType PDU;
+			PDU.SetupFromOpenDIS(ReceivedPDU);
+
+			OnPDUProcessedNative.Broadcast(PDU);
+			if (OnPDUProcessed.IsBound())
+			{
+				OnPDUProcessed.Broadcast(PDU);
+			}
+		};
+
+		RegisterPDUDecoder(PDUType, MoveTemp(Decoder));
+	}
+
+	void RegisterDefaultPDUDecoders();
+
+	/** What happened to a packet, which decides the statistic it is counted in. */
+	enum class EPacketOutcome : uint8
+	{
+		Decoded,
+		DroppedUnsupported,
+		DroppedDisabled,
+		DroppedNoListeners,
+		Invalid,
+		DroppedFiltered
+	};
+	/** Counts a received packet of the given PDU type and its outcome with a single acquisition of the lock. */
+	void RecordPacketStatistics(uint8 PDUType, EPacketOutcome Outcome, double DecodeSeconds = 0);
+	/** Returns the decoder registered for the given PDU type, or null if there is none. */
+	TSharedPtr<const FPDUDecoder, ESPMode::ThreadSafe> GetPDUDecoder(EPDUType PDUType) const;
+
+	//Decoders and statistics indexed by the PDU type byte of the PDU header. Decoders are shared and never modified once registered, so a decoder can be replaced while another thread is still running it.
+	TArray<TSharedPtr<const FPDUDecoder, ESPMode::ThreadSafe>> PDUDecoders;
+	TArray<FPDUTypeStatistics> PDUTypeStatistics;
+	//Packet filters indexed by the PDU type byte of the PDU header. Shared so a filter can be replaced while another thread is still running it.
+	TArray<TSharedPtr<FPDUPacketFilter, ESPMode::ThreadSafe>> PDUPacketFilters;
+	//Packets may be processed off of the game thread if the UDP Subsystem is not receiving data on the game thread. Also guards the decoders and packet filters.
+	mutable FCriticalSection PDUTypeStatisticsCriticalSection;
+
 	DIS::Endian BigEndian = DIS::BIG;
 	const unsigned int PDU_TYPE_POSITION = 2;
+	const int PDU_HEADER_BYTES = 12;
+	const int NUMBER_OF_PDU_TYPES = 256;
 
 	const int ARTICULATION_PARAMETER_BYTES = 16;
 
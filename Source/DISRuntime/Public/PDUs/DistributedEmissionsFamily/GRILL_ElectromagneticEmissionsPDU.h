@@ -92,11 +92,9 @@ struct FElectromagneticEmissionSystemData
 
 	void SetupFromOpenDIS(const DIS::ElectromagneticEmissionSystemData& Data)
 	{
-		Beams.Empty();
+		Beams.Reset(Data.getBeamDataRecords().size());
 		for (const auto& BeamIn : Data.getBeamDataRecords()) {
-			FElectromagneticEmissionBeamData Beam;
-			Beam.SetupFromOpenDIS(BeamIn);
-			Beams.Add(Beam);
+			Beams.AddDefaulted_GetRef().SetupFromOpenDIS(BeamIn);
 		}
 	}
 
@@ -135,11 +133,10 @@ struct FElectromagneticEmissionsPDU : public FDistributedEmissionsFamilyPDU
 		EmittingEntityID = FEntityID(ElectromagneticEmissionsPDUIn.getEmittingEntityID());
 		EventID = FEventID(ElectromagneticEmissionsPDUIn.getEventID());
 
-		Systems.Empty();
+		//Construct nested records in place to avoid deep copying each system's beams
+		Systems.Reset(ElectromagneticEmissionsPDUIn.getSystems().size());
 		for (const auto& SystemIn : ElectromagneticEmissionsPDUIn.getSystems()) {
-			FElectromagneticEmissionSystemData System;
-			System.SetupFromOpenDIS(SystemIn);
-			Systems.Add(System);
+			Systems.AddDefaulted_GetRef().SetupFromOpenDIS(SystemIn);
 		}
 
 	}
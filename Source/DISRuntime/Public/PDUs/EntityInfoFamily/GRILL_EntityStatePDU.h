@@ -101,7 +101,8 @@ struct FEntityStatePDU : public FEntityInformationFamilyPDU
 
 		//Dead reckoning
 		DeadReckoningParameters.DeadReckoningAlgorithm = static_cast<EDeadReckoningAlgorithm>(EntityStatePDUIn.getDeadReckoningParameters().getDeadReckoningAlgorithm());
-		DeadReckoningParameters.OtherParameters = TArray<uint8>(reinterpret_cast<const uint8*>(EntityStatePDUIn.getDeadReckoningParameters().getOtherParameters()), 15);
+		DeadReckoningParameters.OtherParameters.SetNumUninitialized(15);
+		FMemory::Memcpy(DeadReckoningParameters.OtherParameters.GetData(), EntityStatePDUIn.getDeadReckoningParameters().getOtherParameters(), 15);
 		DeadReckoningParameters.EntityLinearAcceleration[0] = EntityStatePDUIn.getDeadReckoningParameters().getEntityLinearAcceleration().getX();
 		DeadReckoningParameters.EntityLinearAcceleration[1] = EntityStatePDUIn.getDeadReckoningParameters().getEntityLinearAcceleration().getY();
 		DeadReckoningParameters.EntityLinearAcceleration[2] = EntityStatePDUIn.getDeadReckoningParameters().getEntityLinearAcceleration().getZ();
@@ -123,25 +124,11 @@ struct FEntityStatePDU : public FEntityInformationFamilyPDU
 		AlternativeEntityType = EntityStatePDUIn.getAlternativeEntityType();
 
 		//Articulation Parameters
-		for (int i = 0; i < EntityStatePDUIn.getNumberOfArticulationParameters(); i++)
+		const std::vector<DIS::ArticulationParameter>& articulationParametersIn = EntityStatePDUIn.getArticulationParameters();
+		ArticulationParameters.Reset(articulationParametersIn.size());
+		for (const DIS::ArticulationParameter& articulationParameterIn : articulationParametersIn)
 		{
-			DIS::ArticulationParameter tempArtParam = EntityStatePDUIn.getArticulationParameters()[i];
-			FArticulationParameters newArtParam;
-			newArtParam.ParameterTypeDesignator = tempArtParam.getParameterTypeDesignator();
-			newArtParam.ChangeIndicator = tempArtParam.getChangeIndicator();
-			newArtParam.PartAttachedTo = tempArtParam.getPartAttachedTo();
-			newArtParam.ParameterType = tempArtParam.getParameterType();
-
-			if (newArtParam.ParameterTypeDesignator == 0)
-			{
-				newArtParam.ParameterValue = tempArtParam.getParameterValue();
-			}
-			else
-			{
-				newArtParam.AttachedPartType = tempArtParam.getParameterValue();
-			}
-
-			ArticulationParameters.Add(newArtParam);
+			ArticulationParameters.AddDefaulted_GetRef().SetupFromOpenDIS(articulationParameterIn);
 		}
 	}
 
@@ -195,7 +182,8 @@ struct FEntityStatePDU : public FEntityInformationFamilyPDU
 		EntityStatePDUOut.setCapabilities(Capabilities);
 
 		std::vector<DIS::ArticulationParameter> OutArtParams;
-		for (FArticulationParameters Param : ArticulationParameters)
+		OutArtParams.reserve(ArticulationParameters.Num());
+		for (const FArticulationParameters& Param : ArticulationParameters)
 		{
 			OutArtParams.push_back(Param.ToOpenDIS());
 		}
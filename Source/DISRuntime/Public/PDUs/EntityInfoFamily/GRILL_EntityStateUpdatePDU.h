@@ -87,25 +87,11 @@ struct FEntityStateUpdatePDU : public FEntityInformationFamilyPDU
 		EntityAppearance = FEntityAppearance(EntityStateUpdatePDUIn.getEntityAppearance());
 
 		//Articulation Parameters
-		for (int i = 0; i < EntityStateUpdatePDUIn.getNumberOfArticulationParameters(); i++)
+		const std::vector<DIS::ArticulationParameter>& articulationParametersIn = EntityStateUpdatePDUIn.getArticulationParameters();
+		ArticulationParameters.Reset(articulationParametersIn.size());
+		for (const DIS::ArticulationParameter& articulationParameterIn : articulationParametersIn)
 		{
-			DIS::ArticulationParameter tempArtParam = EntityStateUpdatePDUIn.getArticulationParameters()[i];
-			FArticulationParameters newArtParam;
-			newArtParam.ParameterTypeDesignator = tempArtParam.getParameterTypeDesignator();
-			newArtParam.ChangeIndicator = tempArtParam.getChangeIndicator();
-			newArtParam.PartAttachedTo = tempArtParam.getPartAttachedTo();
-			newArtParam.ParameterType = tempArtParam.getParameterType();
-
-			if (newArtParam.ParameterTypeDesignator == 0)
-			{
-				newArtParam.ParameterValue = tempArtParam.getParameterValue();
-			}
-			else
-			{
-				newArtParam.AttachedPartType = tempArtParam.getParameterValue();
-			}
-
-			ArticulationParameters.Add(newArtParam);
+			ArticulationParameters.AddDefaulted_GetRef().SetupFromOpenDIS(articulationParameterIn);
 		}
 	}
 
@@ -149,7 +135,8 @@ struct FEntityStateUpdatePDU : public FEntityInformationFamilyPDU
 		EntityStateUpdatePDUOut.setEntityAppearance(EntityAppearance.UpdateValue());
 
 		std::vector<DIS::ArticulationParameter> OutArtParams;
-		for (FArticulationParameters ArticulationParameter : ArticulationParameters)
+		OutArtParams.reserve(ArticulationParameters.Num());
+		for (const FArticulationParameters& ArticulationParameter : ArticulationParameters)
 		{
 			OutArtParams.push_back(ArticulationParameter.ToOpenDIS());
 		}
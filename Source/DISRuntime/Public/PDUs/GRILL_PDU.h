@@ -27,8 +27,9 @@ struct FPDU
 	UPROPERTY()
 		uint8 ProtocolFamily;
 
+	/** Time past the hour in units of 3600 / 2^31 seconds in the upper 31 bits. The lowest bit is set if the time is absolute, synchronized to UTC, and clear if it is relative to the sender's own clock. */
 	UPROPERTY()
-		uint8 Timestamp;
+		uint32 Timestamp;
 
 	/** Length, in bytes, of the PDU */
 	UPROPERTY()
@@ -105,25 +105,11 @@ struct FDetonationPDU : public FWarfareFamilyPDU
 		Pad = DetonationPDUIn.getPad();
 
 		//Articulation Parameters
-		for (int i = 0; i < DetonationPDUIn.getNumberOfArticulationParameters(); i++)
+		const std::vector<DIS::ArticulationParameter>& articulationParametersIn = DetonationPDUIn.getArticulationParameters();
+		ArticulationParameters.Reset(articulationParametersIn.size());
+		for (const DIS::ArticulationParameter& articulationParameterIn : articulationParametersIn)
 		{
-			DIS::ArticulationParameter tempArtParam = DetonationPDUIn.getArticulationParameters()[i];
-			FArticulationParameters newArtParam;
-			newArtParam.ParameterTypeDesignator = tempArtParam.getParameterTypeDesignator();
-			newArtParam.ChangeIndicator = tempArtParam.getChangeIndicator();
-			newArtParam.PartAttachedTo = tempArtParam.getPartAttachedTo();
-			newArtParam.ParameterType = tempArtParam.getParameterType();
-
-			if (newArtParam.ParameterTypeDesignator == 0)
-			{
-				newArtParam.ParameterValue = tempArtParam.getParameterValue();
-			}
-			else
-			{
-				newArtParam.AttachedPartType = tempArtParam.getParameterValue();
-			}
-
-			ArticulationParameters.Add(newArtParam);
+			ArticulationParameters.AddDefaulted_GetRef().SetupFromOpenDIS(articulationParameterIn);
 		}
 	}
 
@@ -172,7 +158,8 @@ struct FDetonationPDU : public FWarfareFamilyPDU
 		DetonationPDUOut.setPad(Pad);
 
 		std::vector<DIS::ArticulationParameter> OutArtParams;
-		for (FArticulationParameters ArticulationParameter : ArticulationParameters)
+		OutArtParams.reserve(ArticulationParameters.Num());
+		for (const FArticulationParameters& ArticulationParameter : ArticulationParameters)
 		{
 			OutArtParams.push_back(ArticulationParameter.ToOpenDIS());
 		}